@@ -0,0 +1,160 @@
+/**
+ * @file Bench.hpp
+ * @brief Minimal benchmark harness: warm-up, calibrated repetitions, median/p99 and JSON output.
+ * @author Oussama Amara
+ * @date 2025-08-20
+ */
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Bench {
+
+/** @brief Shortest repetition accepted after calibration, in nanoseconds. */
+constexpr double MinRepNs = 2e6;
+
+/** @brief Keeps @p value alive so the compiler cannot remove the work producing it. */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/** @brief Timing summary of one case; all times are nanoseconds per iteration. */
+struct Result {
+    std::string name;
+    std::uint64_t iterations = 0; ///< Iterations per repetition
+    int reps = 0;
+    double median = 0, p99 = 0, min = 0, max = 0, mean = 0;
+};
+
+/**
+ * @brief Passed to a case: how many iterations to run and a timer it can pause.
+ */
+class State {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit State(std::uint64_t iterations) : iterations(iterations) {}
+
+    /** @brief Stops counting time, e.g. while waiting for a background thread. */
+    void pause() {
+        if (m_Running)
+            m_Elapsed += Clock::now() - m_Start;
+        m_Running = false;
+    }
+
+    /** @brief Counts time again after pause(). */
+    void resume() {
+        m_Start = Clock::now();
+        m_Running = true;
+    }
+
+    /** @brief Measured nanoseconds so far. */
+    double elapsedNs() const {
+        Clock::duration total = m_Elapsed + (m_Running ? Clock::now() - m_Start : Clock::duration{0});
+        return std::chrono::duration<double, std::nano>(total).count();
+    }
+
+    const std::uint64_t iterations;
+
+private:
+    Clock::time_point m_Start = Clock::now();
+    Clock::duration m_Elapsed{0};
+    bool m_Running = true;
+};
+
+/** @brief A case body: run the code under test state.iterations times, pausing around unmeasured setup. */
+using Case = std::function<void(State& state)>;
+
+/**
+ * @brief Times one case.
+ * The iteration count is doubled until one repetition takes at least MinRepNs, then every
+ * repetition is timed separately and reported per iteration.
+ * @param warmup Untimed repetitions run after calibration.
+ * @param reps Timed repetitions.
+ */
+inline Result run(const std::string& name, const Case& body, int warmup, int reps) {
+    auto timeRep = [&](std::uint64_t iterations) {
+        State state(iterations);
+        body(state);
+        return state.elapsedNs();
+    };
+
+    Result r;
+    r.name = name;
+    r.iterations = 1;
+    while (timeRep(r.iterations) < MinRepNs && r.iterations < (1ull << 40))
+        r.iterations *= 2;
+    for (int i = 0; i < warmup; ++i)
+        timeRep(r.iterations);
+
+    std::vector<double> samples(static_cast<std::size_t>(reps));
+    for (double& s : samples)
+        s = timeRep(r.iterations) / static_cast<double>(r.iterations);
+    std::sort(samples.begin(), samples.end());
+
+    r.reps = reps;
+    r.min = samples.front();
+    r.max = samples.back();
+    r.median = samples[samples.size() / 2];
+    r.p99 = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+    for (double s : samples)
+        r.mean += s / static_cast<double>(samples.size());
+    return r;
+}
+
+/** @brief Writes the results as a JSON array, one case per line so runs diff line by line. */
+inline bool writeJson(const std::string& path, const std::vector<Result>& results) {
+    std::ofstream out(path);
+    if (!out)
+        return false;
+    out << "{\"unit\": \"ns/iter\", \"cases\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        char line[512];
+        std::snprintf(line, sizeof line,
+                      "  {\"name\": \"%s\", \"iterations\": %llu, \"reps\": %d, \"median\": %.3f, "
+                      "\"p99\": %.3f, \"min\": %.3f, \"max\": %.3f, \"mean\": %.3f}%s\n",
+                      r.name.c_str(), static_cast<unsigned long long>(r.iterations), r.reps, r.median,
+                      r.p99, r.min, r.max, r.mean, i + 1 < results.size() ? "," : "");
+        out << line;
+    }
+    out << "]}\n";
+    return static_cast<bool>(out);
+}
+
+/**
+ * @brief Reads the median of every case from a file written by writeJson().
+ * Only understands that layout (one case object per line), not general JSON.
+ */
+inline std::map<std::string, double> readMedians(const std::string& path) {
+    std::map<std::string, double> medians;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        auto name = line.find("\"name\": \"");
+        auto median = line.find("\"median\": ");
+        if (name == std::string::npos || median == std::string::npos)
+            continue;
+        name += 9;
+        auto nameEnd = line.find('"', name);
+        medians[line.substr(name, nameEnd - name)] = std::atof(line.c_str() + median + 10);
+    }
+    return medians;
+}
+
+} // namespace Bench
@@ -0,0 +1,413 @@
+/**
+ * @file pongbench.cpp
+ * @brief Benchmark cases for the simulation, collision, logger, HUD, renderers and a full headless match.
+ * @author Oussama Amara
+ * @date 2025-08-20
+ */
+
+#include "Bench.hpp"
+#include "ChaosSimulation.hpp"
+#include "GameSimulation.hpp"
+#include "Hud.hpp"
+#include "Logger.hpp"
+#include "SceneRecorder.hpp"
+#include "SoftwareRenderer.hpp"
+#include "VideoWriter.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+
+namespace {
+/** @brief Command-line options. */
+struct Options {
+    int reps = 30;
+    int warmup = 3;
+    std::string filter;
+    std::string json;
+    std::string baseline;
+    bool renderStats = false;
+};
+
+/**
+ * @brief `make bench` runs the cases and writes bench.json; --baseline prints the change of
+ * every median against an earlier file. --render-stats records each screen into the render
+ * queue and prints the draw calls, state changes and vertices it submits.
+ */
+void usage() {
+    std::fprintf(stderr,
+        "usage: pongbench [--reps N] [--warmup N] [--filter TEXT] [--json FILE] [--baseline FILE]\n"
+        "       pongbench --render-stats\n");
+}
+
+bool parse(int argc, char* argv[], Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--reps" && hasValue) opt.reps = std::atoi(argv[++i]);
+        else if (arg == "--warmup" && hasValue) opt.warmup = std::atoi(argv[++i]);
+        else if (arg == "--filter" && hasValue) opt.filter = argv[++i];
+        else if (arg == "--json" && hasValue) opt.json = argv[++i];
+        else if (arg == "--baseline" && hasValue) opt.baseline = argv[++i];
+        else if (arg == "--render-stats") opt.renderStats = true;
+        else return false;
+    }
+    return opt.reps > 0 && opt.warmup >= 0;
+}
+
+const Vec2 Resolution{1920.f, 1080.f};
+const float Dt = 1.f / 240.f;
+
+/** @brief Same arena and bats as a multiplayer tick of GameSimulation. */
+struct CollisionScene {
+    Arena arena{0.f, Resolution.x, 0.f, Resolution.y, false};
+    Aabb bats[2] = {{935.f, 1000.f, 50.f, 5.f}, {935.f, 20.f, 50.f, 5.f}};
+};
+
+/** @brief Follows the ball with a small aim error so matches end. */
+PlayerInput chase(const Bat& bat, const Ball& ball, float offset) {
+    Aabb b = bat.getGlobalBounds();
+    Aabb a = ball.getGlobalBounds();
+    float target = a.x + a.w / 2.f + offset;
+    float centre = b.x + b.w / 2.f;
+    return PlayerInput{target < centre - 5.f, target > centre + 5.f};
+}
+
+/** @brief Plays one multiplayer match to game over and returns the ticks it took. */
+std::uint32_t playMatch(std::uint32_t seed) {
+    GameSimulation sim(Resolution);
+    sim.start(GameMode::Multiplayer);
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> aim(0.f, 30.f);
+    float offset[2] = {aim(rng), aim(rng)};
+    std::uint32_t ticks = 0;
+    for (;;) {
+        const MatchState& s = sim.state();
+        TickInput input{{chase(s.bats[0], s.ball, offset[0]), chase(s.bats[1], s.ball, offset[1])}};
+        std::uint32_t events = sim.step(input, Dt);
+        ++ticks;
+        if (events & SimEvent::BatHit)
+            offset[0] = aim(rng), offset[1] = aim(rng);
+        if (events & SimEvent::GameOver)
+            return ticks;
+    }
+}
+
+/** @brief A benchmark case and its name in the report. */
+struct NamedCase {
+    std::string name;
+    Bench::Case body;
+};
+
+/**
+ * @brief Every benchmark case.
+ * @param log Logger the logger cases write to.
+ */
+std::vector<NamedCase> cases(Logger& log) {
+    std::vector<NamedCase> list;
+
+    list.push_back({"ball_update", [](Bench::State& state) {
+        const std::uint64_t n = state.iterations;
+        Ball ball(960.f, 540.f, Resolution);
+        for (std::uint64_t i = 0; i < n; ++i) {
+            ball.update(Dt);
+            if ((i & 1023) == 1023) ball.reboundBatOrTop();
+        }
+        Bench::doNotOptimize(ball);
+    }});
+
+    list.push_back({"ball_update_swept", [](Bench::State& state) {
+        const std::uint64_t n = state.iterations;
+        CollisionScene scene;
+        Ball ball(960.f, 540.f, Resolution);
+        Contact contacts[Collision::MaxContacts];
+        int total = 0;
+        for (std::uint64_t i = 0; i < n; ++i)
+            total += ball.update(Dt, scene.arena, scene.bats, 2, contacts);
+        Bench::doNotOptimize(total);
+    }});
+
+    list.push_back({"bat_update", [](Bench::State& state) {
+        const std::uint64_t n = state.iterations;
+        Bat bat(960.f, 1000.f);
+        for (std::uint64_t i = 0; i < n; ++i) {
+            if ((i & 255) == 0) {
+                bat.stopLeft();
+                bat.moveRight();
+            } else if ((i & 255) == 128) {
+                bat.stopRight();
+                bat.moveLeft();
+            }
+            bat.update(Dt);
+        }
+        Bench::doNotOptimize(bat);
+    }});
+
+    // The checks a multiplayer tick makes: both bats and all four walls
+    list.push_back({"collision_sweep_ball", [](Bench::State& state) {
+        const std::uint64_t n = state.iterations;
+        CollisionScene scene;
+        Contact contacts[Collision::MaxContacts];
+        int total = 0;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            Aabb ball{960.f + static_cast<float>(i & 511), 990.f, 10.f, 10.f};
+            Vec2 velocity{200.f, 200.f};
+            total += Collision::sweepBall(ball, velocity, Dt * 4.f, scene.arena, scene.bats, 2,
+                                          contacts, Collision::MaxContacts);
+        }
+        Bench::doNotOptimize(total);
+    }});
+
+    list.push_back({"collision_sweep_aabb", [](Bench::State& state) {
+        const std::uint64_t n = state.iterations;
+        Aabb bat{935.f, 1000.f, 50.f, 5.f};
+        float total = 0.f;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            Aabb ball{900.f + static_cast<float>(i & 127), 985.f, 10.f, 10.f};
+            total += Collision::sweepAabb(ball, Vec2{1.f, 8.f}, bat).time;
+        }
+        Bench::doNotOptimize(total);
+    }});
+
+    // What a call site pays; the writer thread drains the ring while the timer is paused.
+    // The logger cases write to their own file, never the player's game.log.
+    list.push_back({"logger_info", [&log](Bench::State& state) {
+        const std::uint64_t n = state.iterations;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            if (log.enabled(LogLevel::Info))
+                log.log(LogLevel::Info, "Player {} scored — Score: {}", static_cast<int>(i & 1), i);
+            if ((i & 4095) == 4095) {
+                state.pause();
+                log.flush();
+                state.resume();
+            }
+        }
+        state.pause();
+        log.flush();
+    }});
+
+    // End to end: a burst of 4096 entries until they are all in the file
+    list.push_back({"logger_burst_4096_flush", [&log](Bench::State& state) {
+        const std::uint64_t n = state.iterations;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            for (int k = 0; k < 4096; ++k)
+                if (log.enabled(LogLevel::Info))
+                    log.log(LogLevel::Info, "Player {} scored — Score: {}", k & 1, k);
+            log.flush();
+        }
+    }});
+
+    list.push_back({"hud_singleplayer", [](Bench::State& state) {
+        const std::uint64_t n = state.iterations;
+        std::size_t total = 0;
+        for (std::uint64_t i = 0; i < n; ++i)
+            total += Hud::singleplayer(static_cast<int>(i & 63), 3, 120).size();
+        Bench::doNotOptimize(total);
+    }});
+
+    list.push_back({"hud_multiplayer", [](Bench::State& state) {
+        const std::uint64_t n = state.iterations;
+        std::size_t total = 0;
+        for (std::uint64_t i = 0; i < n; ++i)
+            total += Hud::player(static_cast<int>(i & 63), 3).size() + Hud::player(2, 1).size();
+        Bench::doNotOptimize(total);
+    }});
+
+    // What DisplayManager pays when a HUD value changes: format, then lay out the segments
+    list.push_back({"hud_segments_rebuild", [](Bench::State& state) {
+        const std::uint64_t n = state.iterations;
+        std::vector<Aabb> rects;
+        Hud::SegmentStyle style;
+        std::size_t total = 0;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            rects.clear();
+            total += Hud::appendSegments(rects, Hud::singleplayer(static_cast<int>(i & 63), 3, 120), 20.f, 540.f, style);
+        }
+        Bench::doNotOptimize(total);
+    }});
+
+    // A ball leaving and a new one being served, in a store of 4096 entities
+    list.push_back({"entity_despawn_spawn", [](Bench::State& state) {
+        const std::uint64_t n = state.iterations;
+        state.pause();
+        EntityStore store(4096);
+        std::vector<EntityHandle> handles;
+        for (std::size_t i = 0; i < store.capacity(); ++i)
+            handles.push_back(store.spawn(EntityKind::Ball, Vec2{float(i), 0.f}, Vec2{10.f, 10.f}, Motion{}));
+        state.resume();
+        for (std::uint64_t i = 0; i < n; ++i) {
+            EntityHandle& h = handles[(i * 2654435761u) & 4095];
+            store.despawn(h);
+            h = store.spawn(EntityKind::Ball, Vec2{960.f, 540.f}, Vec2{10.f, 10.f}, Motion{});
+        }
+        Bench::doNotOptimize(store.size());
+    }});
+
+    // One multi-ball tick against the ball count, with the grid and with every pair tested
+    for (std::size_t balls : {250, 1000, 4000}) {
+        for (auto broadphase : {ChaosSimulation::Broadphase::Grid, ChaosSimulation::Broadphase::BruteForce}) {
+            bool grid = broadphase == ChaosSimulation::Broadphase::Grid;
+            if (!grid && balls > 1000)
+                continue;
+            std::string name = "chaos_tick_" + std::to_string(balls) + (grid ? "_grid" : "_brute");
+            list.push_back({name, [balls, broadphase](Bench::State& state) {
+                const std::uint64_t n = state.iterations;
+                state.pause();
+                ChaosSimulation chaos(Resolution, balls, 1, broadphase);
+                TickInput input;
+                state.resume();
+                std::uint32_t events = 0;
+                for (std::uint64_t i = 0; i < n; ++i)
+                    events |= chaos.step(input, Dt);
+                Bench::doNotOptimize(events);
+            }});
+        }
+    }
+
+    // Recording a frame into the render queue, sorting, merging and submitting it
+    list.push_back({"render_queue_match", [](Bench::State& state) {
+        const std::uint64_t n = state.iterations;
+        GameSimulation sim(Resolution);
+        sim.start(GameMode::Multiplayer);
+        SceneRecorder scenes(Resolution);
+        RenderQueue queue;
+        NullRenderBackend backend;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            scenes.recordMatch(queue, sim.state(), 0.5f);
+            queue.submit(backend);
+        }
+        Bench::doNotOptimize(queue.lastMerged());
+    }});
+
+    list.push_back({"render_queue_chaos1000", [](Bench::State& state) {
+        const std::uint64_t n = state.iterations;
+        state.pause();
+        ChaosSimulation chaos(Resolution, 1000, 1, ChaosSimulation::Broadphase::Grid);
+        SceneRecorder scenes(Resolution);
+        RenderQueue queue;
+        NullRenderBackend backend;
+        state.resume();
+        for (std::uint64_t i = 0; i < n; ++i) {
+            scenes.recordChaos(queue, chaos, 0.5f);
+            queue.submit(backend);
+        }
+        Bench::doNotOptimize(queue.lastMerged());
+    }});
+
+    // One 1080p multiplayer frame in software: drawing alone, then drawing and Y4M conversion
+    for (bool convert : {false, true}) {
+        list.push_back({convert ? "raster_y4m_1080p" : "raster_frame_1080p", [convert](Bench::State& state) {
+            const std::uint64_t n = state.iterations;
+            state.pause();
+            GameSimulation sim(Resolution);
+            sim.start(GameMode::Multiplayer);
+            SoftwareRenderer renderer(1920, 1080);
+            VideoWriter writer;
+            if (convert)
+                writer.open("", VideoWriter::Format::Y4m, 1920, 1080, 60);
+            // The first frame clears and converts everything; time the steady state
+            renderer.renderMatch(sim.state());
+            if (convert)
+                writer.write(renderer);
+            TickInput input;
+            state.resume();
+            for (std::uint64_t i = 0; i < n; ++i) {
+                sim.step(input, Dt);
+                renderer.renderMatch(sim.state(), 0.5f);
+                if (convert)
+                    writer.write(renderer);
+            }
+            Bench::doNotOptimize(renderer.pixelsFilled());
+        }});
+    }
+
+    list.push_back({"headless_match", [](Bench::State& state) {
+        const std::uint64_t n = state.iterations;
+        std::uint64_t ticks = 0;
+        for (std::uint64_t i = 0; i < n; ++i)
+            ticks += playMatch(static_cast<std::uint32_t>(i));
+        Bench::doNotOptimize(ticks);
+    }});
+
+    return list;
+}
+
+/** @brief Per-frame draw calls, state changes and vertices of every screen, counted headless. */
+void printRenderStats() {
+    SceneRecorder scenes(Resolution);
+    RenderQueue queue;
+    CountingRenderBackend counter;
+    GameSimulation sim(Resolution);
+    ChaosSimulation chaos(Resolution, 1000, 1, ChaosSimulation::Broadphase::Grid);
+    std::printf("%-20s %9s %7s %11s %14s %9s\n", "screen", "commands", "merged", "draw calls", "state changes",
+                "vertices");
+    for (int screen = 0; screen < 4; ++screen) {
+        const char* name = "menu";
+        if (screen == 0) {
+            scenes.recordMenu(queue);
+        } else if (screen == 3) {
+            name = "chaos (1000 balls)";
+            scenes.recordChaos(queue, chaos);
+        } else {
+            name = screen == 1 ? "singleplayer" : "multiplayer";
+            sim.start(screen == 1 ? GameMode::Singleplayer : GameMode::Multiplayer);
+            scenes.recordMatch(queue, sim.state());
+        }
+        counter.reset();
+        queue.submit(counter);
+        const RenderStats& s = counter.stats();
+        std::printf("%-20s %9zu %7zu %11zu %14zu %9zu\n", name, queue.lastCommands(), queue.lastMerged(), s.drawCalls,
+                    s.stateChanges, s.vertices);
+    }
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parse(argc, argv, opt)) {
+        usage();
+        return 2;
+    }
+
+    // The game's own logging stays quiet; the logger cases use benchLog below
+    Logger::instance().setConsoleEcho(false);
+    Logger::instance().setLevel(LogLevel::Error);
+    if (opt.renderStats) {
+        printRenderStats();
+        return 0;
+    }
+
+    std::map<std::string, double> baseline;
+    if (!opt.baseline.empty())
+        baseline = Bench::readMedians(opt.baseline);
+
+    std::printf("%-22s %12s %12s %12s %12s %10s\n", "case", "iterations", "median ns", "p99 ns", "max ns",
+                baseline.empty() ? "" : "vs base");
+    std::vector<Bench::Result> results;
+    const std::string logPath = (std::filesystem::temp_directory_path() / "pongbench.log").string();
+    {
+        Logger benchLog(logPath);
+        benchLog.setConsoleEcho(false);
+        for (const NamedCase& c : cases(benchLog)) {
+            const std::string& name = c.name;
+            if (!opt.filter.empty() && name.find(opt.filter) == std::string::npos)
+                continue;
+            Bench::Result r = Bench::run(name, c.body, opt.warmup, opt.reps);
+            results.push_back(r);
+
+            char delta[32] = "";
+            auto base = baseline.find(name);
+            if (base != baseline.end() && base->second > 0)
+                std::snprintf(delta, sizeof delta, "%+.1f%%", 100.0 * (r.median / base->second - 1.0));
+            std::printf("%-22s %12llu %12.1f %12.1f %12.1f %10s\n", name.c_str(),
+                        static_cast<unsigned long long>(r.iterations), r.median, r.p99, r.max, delta);
+        }
+    }
+    std::remove(logPath.c_str());
+
+    if (!opt.json.empty() && !Bench::writeJson(opt.json, results)) {
+        std::fprintf(stderr, "pongbench: cannot write %s\n", opt.json.c_str());
+        return 1;
+    }
+    return 0;
+}
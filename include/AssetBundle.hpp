@@ -0,0 +1,109 @@
+/**
+ * @file AssetBundle.hpp
+ * @brief Read-only pack of the game's assets: one file, an index, memory-mapped at startup.
+ * @author Oussama Amara
+ * @date 2025-09-04
+ */
+
+#pragma once
+#include "MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Header at the start of an asset bundle. It is followed by the index, one entry per
+ * asset sorted by name, then every asset at a 16-byte aligned offset; integers are
+ * little-endian.
+ */
+struct AssetBundleHeader {
+    char magic[4];            ///< "PPAK"
+    std::uint32_t version;    ///< Format version, currently 1
+    std::uint32_t count;      ///< Entries in the index
+    std::uint32_t indexCrc;   ///< CRC-32 of the index
+};
+
+/**
+ * @brief Index entry of one asset.
+ */
+struct AssetBundleEntry {
+    char name[48];            ///< NUL-padded name, e.g. "fonts/DS-DIGI.TTF"
+    std::uint64_t offset;     ///< Start of the asset from the start of the file
+    std::uint32_t size;       ///< Size in bytes
+    std::uint32_t crc;        ///< CRC-32 of the asset
+};
+
+static_assert(sizeof(AssetBundleHeader) == 16, "AssetBundleHeader layout is part of the file format");
+static_assert(sizeof(AssetBundleEntry) == 64, "AssetBundleEntry layout is part of the file format");
+
+/**
+ * @class AssetBundle
+ * @brief Maps a bundle written by AssetBundle::write() and hands out its assets.
+ */
+class AssetBundle {
+public:
+    /** @brief Longest asset name, not counting the terminating NUL. */
+    static constexpr std::size_t MaxName = 47;
+
+    /** @brief An asset's bytes inside the mapping; empty when not found. */
+    struct Asset {
+        const std::uint8_t* data = nullptr;
+        std::size_t size = 0;
+        explicit operator bool() const { return data != nullptr; }
+    };
+
+    /** @brief An asset to pack: its name in the bundle and its contents. */
+    struct Source {
+        std::string name;
+        std::vector<std::uint8_t> bytes;
+    };
+
+    /**
+     * @brief Maps a bundle and validates its header and index. Assets are then used in place;
+     * their CRCs are only checked by verify() (pongpack --verify), not at startup.
+     * @return false if the file is missing, truncated or not a bundle of this version.
+     */
+    bool open(const std::string& path);
+
+    /** @brief Unmaps the bundle; assets handed out become invalid. */
+    void close();
+
+    bool isOpen() const { return m_File.isOpen(); }
+
+    /** @brief Looks an asset up by name with a binary search, e.g. "fonts/DS-DIGI.TTF". */
+    Asset find(std::string_view name) const;
+
+    /** @brief Number of assets. */
+    std::size_t count() const { return m_Count; }
+
+    /** @brief Name and contents of the i-th asset, in name order. */
+    std::string_view name(std::size_t index) const;
+    Asset at(std::size_t index) const;
+
+    /**
+     * @brief Checks every asset against its CRC-32.
+     * @return Index of the first damaged asset, or count() if all are intact.
+     */
+    std::size_t verify() const;
+
+    /**
+     * @brief Writes a bundle; names must be unique and at most MaxName characters.
+     * @return false on an invalid name or a write error.
+     */
+    static bool write(const std::string& path, std::vector<Source> assets);
+
+    /**
+     * @brief Directory of the running executable, with a trailing separator, or "" if unknown.
+     * The game looks for its bundle there, whatever directory it is started from.
+     * @param argv0 Used when the OS cannot tell (argv[0] up to its last separator).
+     */
+    static std::string executableDir(const char* argv0);
+
+private:
+    const AssetBundleEntry* entries() const;
+
+    MappedFile m_File;
+    std::size_t m_Count = 0;
+};
@@ -6,7 +6,9 @@
  - @date 2025-07-27
  */
 #pragma once
-#include <SFML/Graphics.hpp>
+#include "Collision.hpp"
+#include <cstddef>
+#include <cstdint>
 
 /**
  * @class Ball
@@ -15,13 +17,16 @@
 class Ball {
 private:
     /** @brief Current position of the ball in 2D space. */
-    sf::Vector2f m_Position;
+    Vec2 m_Position;
+
+    /** @brief Position at the start of the last simulation tick, used for render interpolation. */
+    Vec2 m_PrevPosition;
 
     /** @brief Resolution of the game window, used for positioning and movement calculations. */
-    sf::Vector2f m_Resolution; 
+    Vec2 m_Resolution;
 
-    /** @brief Graphical shape used to render the ball (a rectangle). */
-    sf::RectangleShape m_Shape;
+    /** @brief Width and height of the ball. */
+    Vec2 m_Size{10.f, 10.f};
 
     /** @brief Movement speed of the ball in pixels per second. */
     float m_Speed = 1000.0f;
@@ -40,25 +45,25 @@ public:
      * @param startY Initial y-coordinate.
      * @param resolution Resolution of the game window, used for positioning and movement calculations.
      */
-    Ball(float startX, float startY, sf::Vector2f resolution);
+    Ball(float startX, float startY, Vec2 resolution);
 
     /**
      * @brief Retrieves the current bounding rectangle of the ball.
-     * @return FloatRect representing the ball's position and size.
+     * @return Box representing the ball's position and size.
      */
-    sf::FloatRect getPosition() const;
+    Aabb getPosition() const;
 
     /**
-     * @brief Provides read-only access to the ball's graphical shape.
-     * @return Reference to the internal RectangleShape.
+     * @brief Returns the global bounds of the ball for collision detection.
+     * @return Box containing position and dimensions in global coordinates.
      */
-    const sf::RectangleShape& getShape() const;
+    Aabb getGlobalBounds() const;
 
     /**
-     * @brief Returns the global bounds of the ball for collision detection.
-     * @return FloatRect containing position and dimensions in global coordinates.
+     * @brief Returns the bounds to draw, blended between the previous and current tick.
+     * @param alpha Blend factor in [0, 1]; 0 gives the previous tick, 1 the current one.
      */
-    sf::FloatRect getGlobalBounds() const;
+    Aabb getRenderBounds(float alpha) const;
 
     /**
      * @brief Returns the current horizontal velocity of the ball.
@@ -66,6 +71,12 @@ public:
      */
     float getXVelocity() const;
 
+    /** @brief Vertical direction multiplier (-1.0 to 1.0). */
+    float getYVelocity() const { return m_DirectionY; }
+
+    /** @brief Movement speed in pixels per second. */
+    float getSpeed() const { return m_Speed; }
+
     /**
      * @brief Reverses the horizontal direction when hitting left or right walls.
      */
@@ -88,7 +99,33 @@ public:
 
     /**
      * @brief Updates the ball's position based on its velocity and elapsed time.
-     * @param dt Time delta since last update.
+     * @param dt Time delta since last update, in seconds.
+     */
+    void update(float dt);
+
+    /**
+     * @brief Advances the ball with continuous collision against the walls and bats.
+     * Bounces off side walls, bats and (if the arena allows) the top wall are applied here;
+     * leaving through the bottom or a non-reflecting top stops the ball at the contact so
+     * the caller can apply the scoring rules.
+     * @param dt Time delta of the step, in seconds.
+     * @param arena Field walls.
+     * @param bats Bat boxes at their end-of-step positions.
+     * @param batCount Number of bats.
+     * @param contacts Receives the contacts in time order (Collision::MaxContacts entries).
+     * @return Number of contacts written.
      */
-    void update(sf::Time dt);
+    int update(float dt, const Arena& arena, const Aabb* bats, int batCount, Contact* contacts);
+
+    /** @brief Bytes written by pack(). */
+    static constexpr std::size_t PackedSize = 44;
+
+    /**
+     * @brief Writes every field in declaration order, without padding, so snapshots can be
+     * compared byte for byte.
+     */
+    void pack(std::uint8_t* out) const;
+
+    /** @brief Restores the fields written by pack(). */
+    void unpack(const std::uint8_t* in);
 };
@@ -1,25 +1,30 @@
 /**
  * @file Bat.hpp
  * @brief Header file for the Bat class, representing the player's paddle in a Pong game.
- * This class handles movement, position tracking, and graphical representation of the paddle.
+ * This class handles movement and position tracking of the paddle.
  * @author Oussama Amara
  * @date 2025-07-27
  */
 
 #pragma once
-#include <SFML/Graphics.hpp>
+#include "Collision.hpp"
+#include <cstddef>
+#include <cstdint>
 
 /**
  * @class Bat
- * @brief Represents a paddle controlled by the player, with logic for motion and rendering.
+ * @brief Represents a paddle controlled by the player, with logic for motion.
  */
 class Bat {
 private:
     /** @brief Current position of the bat in 2D space. */
-    sf::Vector2f m_Position;
+    Vec2 m_Position;
 
-    /** @brief Graphical shape used to render the bat (a rectangle). */
-    sf::RectangleShape m_Shape;
+    /** @brief Position at the start of the last simulation tick, used for render interpolation. */
+    Vec2 m_PrevPosition;
+
+    /** @brief Width and height of the bat. */
+    Vec2 m_Size{50.f, 5.f};
 
     /** @brief Movement speed of the bat in pixels per second. */
     float m_Speed = 1000.0f;
@@ -40,21 +45,21 @@ public:
 
     /**
      * @brief Retrieves the current bounding rectangle of the bat.
-     * @return FloatRect representing the bat's position and size.
+     * @return Box representing the bat's position and size.
      */
-    sf::FloatRect getPosition() const;
+    Aabb getPosition() const;
 
     /**
-     * @brief Provides read-only access to the bat's graphical shape.
-     * @return Reference to the internal RectangleShape.
+     * @brief Returns the global bounds of the bat for collision detection.
+     * @return Box containing position and dimensions in global coordinates.
      */
-    const sf::RectangleShape& getShape() const;
+    Aabb getGlobalBounds() const;
 
     /**
-     * @brief Returns the global bounds of the bat for collision detection.
-     * @return FloatRect containing position and dimensions in global coordinates.
+     * @brief Returns the bounds to draw, blended between the previous and current tick.
+     * @param alpha Blend factor in [0, 1]; 0 gives the previous tick, 1 the current one.
      */
-    sf::FloatRect getGlobalBounds() const;
+    Aabb getRenderBounds(float alpha) const;
 
     /**
      * @brief Begins leftward movement.
@@ -78,7 +83,22 @@ public:
 
     /**
      * @brief Updates the bat's position based on movement flags and elapsed time.
-     * @param dt Time delta since the last update.
+     * @param dt Time delta since the last update, in seconds.
      */
-    void update(sf::Time dt);
+    void update(float dt);
+
+    /** @brief Movement speed in pixels per second. */
+    float getSpeed() const { return m_Speed; }
+
+    /** @brief Bytes written by pack(). */
+    static constexpr std::size_t PackedSize = 30;
+
+    /**
+     * @brief Writes every field in declaration order, without padding, so snapshots can be
+     * compared byte for byte.
+     */
+    void pack(std::uint8_t* out) const;
+
+    /** @brief Restores the fields written by pack(). */
+    void unpack(const std::uint8_t* in);
 };
@@ -0,0 +1,206 @@
+/**
+ * @file BatchKernel.hpp
+ * @brief Vector kernel shared by the SSE2 and AVX2 batch backends.
+ * @author Oussama Amara
+ * @date 2025-08-18
+ */
+
+#pragma once
+#include "BatchSimulation.hpp"
+
+// The kernel is written once against a small operations type V (float vector F, int
+// vector I, masks as all-ones float lanes) and instantiated in BatchSimulation.cpp for
+// SSE2 and in BatchSimulationAvx2.cpp, the only file compiled with -mavx2. Every
+// arithmetic step follows stepBatchScalar() in the same order so both produce identical
+// floats.
+
+/**
+ * @brief Values every lane shares, splatted once per kernel call.
+ */
+template <class V>
+struct BatchConstants {
+    using F = typename V::F;
+    using I = typename V::I;
+
+    explicit BatchConstants(const BatchParams& p)
+        : multiplayer(p.mode == GameMode::Multiplayer),
+          zero(V::set1(0.f)), dt(V::set1(p.dt)), speed(V::set1(p.ballSpeed)),
+          ballSize(V::set1(p.ballSize)), halfBall(V::set1(p.ballSize / 2.f)),
+          batWidth(V::set1(p.batWidth)), halfBat(V::set1(p.batWidth / 2.f)),
+          deadZone(V::set1(p.botDeadZone)), width(V::set1(p.width)), height(V::set1(p.height)),
+          rightMirror(V::set1(2.f * (p.width - p.ballSize))),
+          centreX(V::set1(p.width / 2.f)), centreY(V::set1(p.height / 2.f)),
+          face1(V::set1(p.height - 80.f)), face1Rest(V::set1(p.height - 80.f - p.ballSize)),
+          face2(V::set1(20.f + p.batHeight)), serveDelay(V::set1(p.serveDelay)),
+          zeroI(V::set1i(0)), oneI(V::set1i(1)) {}
+
+    bool multiplayer;
+    F zero, dt, speed, ballSize, halfBall, batWidth, halfBat, deadZone, width, height;
+    F rightMirror, centreX, centreY, face1, face1Rest, face2, serveDelay;
+    I zeroI, oneI;
+};
+
+/**
+ * @brief Advances the V::Width lanes starting at @p i by one tick.
+ * @return False if every lane of the block was already finished.
+ */
+template <class V>
+bool stepBatchBlock(BatchLanes& L, const BatchConstants<V>& c, std::size_t i) {
+    using F = typename V::F;
+    using I = typename V::I;
+
+    I done = V::loadi(&L.done[i]);
+    F active = V::eqi(done, c.zeroI);
+    if (!V::any(active))
+        return false;
+
+    F bx = V::load(&L.ballX[i]), by = V::load(&L.ballY[i]);
+    F dirX = V::load(&L.dirX[i]), dirY = V::load(&L.dirY[i]);
+    F bat1 = V::load(&L.bat1X[i]), bat2 = V::load(&L.bat2X[i]);
+    F time = V::load(&L.time[i]);
+    I tickCount = V::loadi(&L.ticks[i]);
+
+    time = V::select(active, V::add(time, c.dt), time);
+    tickCount = V::inc(tickCount, active);
+
+    // Bots chase the ball centre; the field edges stop them like applyInput() does.
+    F move1 = V::mul(V::load(&L.botSpeed1[i]), c.dt);
+    F target = V::add(bx, c.halfBall);
+    F centre = V::add(bat1, c.halfBat);
+    F left = V::andnot(V::lt(bat1, c.zero), V::lt(target, V::sub(centre, c.deadZone)));
+    F right = V::andnot(V::gt(V::add(bat1, c.batWidth), c.width), V::gt(target, V::add(centre, c.deadZone)));
+    F nb1 = V::select(left, V::sub(bat1, move1), bat1);
+    nb1 = V::select(right, V::add(nb1, move1), nb1);
+    F nb2 = bat2;
+    if (c.multiplayer) {
+        F move2 = V::mul(V::load(&L.botSpeed2[i]), c.dt);
+        centre = V::add(bat2, c.halfBat);
+        left = V::andnot(V::lt(bat2, c.zero), V::lt(target, V::sub(centre, c.deadZone)));
+        right = V::andnot(V::gt(V::add(bat2, c.batWidth), c.width), V::gt(target, V::add(centre, c.deadZone)));
+        nb2 = V::select(left, V::sub(bat2, move2), bat2);
+        nb2 = V::select(right, V::add(nb2, move2), nb2);
+    }
+
+    F nx = V::add(bx, V::mul(V::mul(dirX, c.speed), c.dt));
+    F ny = V::add(by, V::mul(V::mul(dirY, c.speed), c.dt));
+
+    // Nearly every tick nothing but movement happens: if no lane reaches a wall, a bat
+    // face or a goal line, the full rules below would leave everything else unchanged.
+    F event = V::bor(V::lt(nx, c.zero), V::gt(V::add(nx, c.ballSize), c.width));
+    event = V::bor(event, V::bor(V::lt(ny, c.zero), V::gt(ny, c.height)));
+    event = V::bor(event, V::band(V::le(V::add(by, c.ballSize), c.face1), V::gt(V::add(ny, c.ballSize), c.face1)));
+    if (c.multiplayer)
+        event = V::bor(event, V::band(V::ge(by, c.face2), V::lt(ny, c.face2)));
+    if (!V::any(V::band(active, event))) {
+        V::store(&L.ballX[i], V::select(active, nx, bx));
+        V::store(&L.ballY[i], V::select(active, ny, by));
+        V::store(&L.bat1X[i], V::select(active, nb1, bat1));
+        V::store(&L.bat2X[i], V::select(active, nb2, bat2));
+        V::store(&L.time[i], time);
+        V::storei(&L.ticks[i], tickCount);
+        return true;
+    }
+
+    I score1 = V::loadi(&L.score1[i]), score2 = V::loadi(&L.score2[i]);
+    I lives1 = V::loadi(&L.lives1[i]), lives2 = V::loadi(&L.lives2[i]);
+    I hits = V::loadi(&L.batHits[i]);
+
+    // Side walls
+    F hitLeft = V::lt(nx, c.zero);
+    F hitRight = V::gt(V::add(nx, c.ballSize), c.width);
+    nx = V::select(hitLeft, V::sub(c.zero, nx), nx);
+    nx = V::select(hitRight, V::sub(c.rightMirror, nx), nx);
+    F nDirX = V::select(V::bor(hitLeft, hitRight), V::sub(c.zero, dirX), dirX);
+
+    // Bottom bat: the ball's lower edge crosses the bat face while over the bat
+    F cross1 = V::band(V::band(V::gt(dirY, c.zero), V::le(V::add(by, c.ballSize), c.face1)),
+                       V::gt(V::add(ny, c.ballSize), c.face1));
+    cross1 = V::band(cross1, V::band(V::lt(nx, V::add(nb1, c.batWidth)), V::gt(V::add(nx, c.ballSize), nb1)));
+    ny = V::select(cross1, V::sub(c.face1Rest, V::sub(V::add(ny, c.ballSize), c.face1)), ny);
+    F nDirY = V::select(cross1, V::sub(c.zero, dirY), dirY);
+    F batHit = cross1;
+
+    // Top bat: the ball's upper edge crosses the bat's lower face
+    if (c.multiplayer) {
+        F cross2 = V::band(V::band(V::lt(nDirY, c.zero), V::ge(by, c.face2)), V::lt(ny, c.face2));
+        cross2 = V::band(cross2, V::band(V::lt(nx, V::add(nb2, c.batWidth)), V::gt(V::add(nx, c.ballSize), nb2)));
+        ny = V::select(cross2, V::add(c.face2, V::sub(c.face2, ny)), ny);
+        nDirY = V::select(cross2, V::sub(c.zero, nDirY), nDirY);
+        batHit = V::bor(batHit, cross2);
+    }
+
+    F top = V::lt(ny, c.zero);
+    F point1, life2 = V::set1(0.f);
+    if (c.multiplayer) {
+        // Player 1 scores, player 2 loses a life, the ball restarts from the centre
+        point1 = top;
+        life2 = top;
+        nx = V::select(top, c.centreX, nx);
+        ny = V::select(top, c.centreY, ny);
+    } else {
+        // Bounce; only scores once the serve delay has passed
+        point1 = V::band(top, V::gt(time, c.serveDelay));
+        ny = V::select(top, V::sub(c.zero, ny), ny);
+    }
+    nDirY = V::select(top, V::sub(c.zero, nDirY), nDirY);
+
+    F bottom = V::gt(ny, c.height);
+    nx = V::select(bottom, c.centreX, nx);
+    ny = V::select(bottom, c.centreY, ny);
+    nDirY = V::select(bottom, V::sub(c.zero, nDirY), nDirY);
+
+    bx = V::select(active, nx, bx);
+    by = V::select(active, ny, by);
+    dirX = V::select(active, nDirX, dirX);
+    dirY = V::select(active, nDirY, dirY);
+    bat1 = V::select(active, nb1, bat1);
+    bat2 = V::select(active, nb2, bat2);
+    hits = V::inc(hits, V::band(active, batHit));
+    score1 = V::inc(score1, V::band(active, point1));
+    lives2 = V::dec(lives2, V::band(active, life2));
+    lives1 = V::dec(lives1, V::band(active, bottom));
+    if (c.multiplayer)
+        score2 = V::inc(score2, V::band(active, bottom));
+
+    F over = V::bor(V::lti(lives1, c.oneI), V::lti(lives2, c.oneI));
+    done = V::inc(done, V::band(active, over));
+
+    V::store(&L.ballX[i], bx);
+    V::store(&L.ballY[i], by);
+    V::store(&L.dirX[i], dirX);
+    V::store(&L.dirY[i], dirY);
+    V::store(&L.bat1X[i], bat1);
+    V::store(&L.bat2X[i], bat2);
+    V::store(&L.time[i], time);
+    V::storei(&L.score1[i], score1);
+    V::storei(&L.score2[i], score2);
+    V::storei(&L.lives1[i], lives1);
+    V::storei(&L.lives2[i], lives2);
+    V::storei(&L.batHits[i], hits);
+    V::storei(&L.ticks[i], tickCount);
+    V::storei(&L.done[i], done);
+    return true;
+}
+
+/**
+ * @brief Advances lanes [begin, end) by @p ticks ticks, V::Width lanes at a time.
+ * Lanes are processed in tiles small enough to stay in L1; within a tile every block
+ * advances one tick before any advances the next, so the independent blocks overlap
+ * instead of each tick waiting for the previous one's ball position.
+ */
+template <class V>
+void stepBatchKernel(BatchLanes& L, const BatchParams& p, std::size_t begin, std::size_t end, int ticks) {
+    const BatchConstants<V> c(p);
+    const std::size_t tile = 32 * V::Width;
+
+    for (std::size_t first = begin; first < end; first += tile) {
+        std::size_t last = first + tile < end ? first + tile : end;
+        for (int t = 0; t < ticks; ++t) {
+            bool anyActive = false;
+            for (std::size_t i = first; i < last; i += V::Width)
+                anyActive |= stepBatchBlock<V>(L, c, i);
+            if (!anyActive)
+                break;
+        }
+    }
+}
@@ -0,0 +1,57 @@
+/**
+ * @file BatchRenderer.hpp
+ * @brief Draws any number of solid rectangles with a single draw call.
+ * @author Oussama Amara
+ * @date 2025-08-22
+ */
+
+#pragma once
+#include "Collision.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class BatchRenderer
+ * @brief Slot-based rectangle batch backed by one vertex array.
+ * Every rectangle owns a fixed slot of six vertices (two triangles), so static scenery
+ * costs nothing per frame once it has been written.
+ */
+class BatchRenderer : public sf::Drawable {
+public:
+    /** @brief Vertices per rectangle. */
+    static constexpr std::size_t VerticesPerRect = 6;
+
+    /**
+     * @brief Sets the number of slots; new slots are empty (zero-sized) until set.
+     */
+    void resize(std::size_t count);
+
+    /** @brief Number of slots. */
+    std::size_t size() const { return m_Rects.size(); }
+
+    /**
+     * @brief Places the rectangle of a slot. The vertices are only rewritten when the
+     * rectangle moved, resized or changed colour.
+     * @return True if the slot's vertices had to be rewritten.
+     */
+    bool set(std::size_t slot, const Aabb& rect, sf::Color color = sf::Color::White);
+
+    /** @brief Slots rewritten since the last call; resets the counter. */
+    std::size_t takeRewrites();
+
+private:
+    /** @brief What a slot currently holds. */
+    struct Slot {
+        Aabb rect;
+        sf::Color color;
+    };
+
+    void write(std::size_t slot);
+    /** @brief Submits every slot in one draw call. */
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    sf::VertexArray m_Vertices{sf::PrimitiveType::Triangles};
+    std::vector<Slot> m_Rects;
+    std::size_t m_Rewrites = 0;
+};
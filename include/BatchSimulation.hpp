@@ -0,0 +1,112 @@
+/**
+ * @file BatchSimulation.hpp
+ * @brief Structure-of-arrays engine stepping thousands of bot-vs-bot matches at once.
+ * @author Oussama Amara
+ * @date 2025-08-18
+ */
+
+#pragma once
+#include "GameSimulation.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Parameters shared by every match of a batch; these are the values being tuned.
+ */
+struct BatchParams {
+    GameMode mode = GameMode::Multiplayer; ///< Singleplayer or Multiplayer rules
+    float width = 1920.f;       ///< Field width in pixels
+    float height = 1080.f;      ///< Field height in pixels
+    float dt = 1.f / 240.f;     ///< Tick length in seconds
+    float ballSpeed = 1000.f;   ///< Ball::m_Speed
+    float ballSize = 10.f;      ///< Ball width and height
+    float batWidth = 50.f;      ///< Bat width
+    float batHeight = 5.f;      ///< Bat height
+    float serveDelay = GameSimulation::ServeDelay; ///< Seconds before the top wall scores in single player
+    int lives = GameSimulation::StartingLives;     ///< Lives per player
+    float botDeadZone = 5.f;    ///< Bots only move when the ball is further than this from the bat centre
+};
+
+/**
+ * @brief Per-match state, one array element per match (structure of arrays), so a block
+ * of 4 (SSE2) or 8 (AVX2) matches advances with one instruction per rule.
+ * Arrays are padded to a multiple of BatchSimulation::LaneAlign; padding lanes start finished.
+ */
+struct BatchLanes {
+    std::vector<float> ballX, ballY, dirX, dirY;
+    std::vector<float> bat1X, bat2X;          ///< Bottom (player 1) and top (player 2) bat x
+    std::vector<float> botSpeed1, botSpeed2;  ///< Bot bat speeds in pixels per second
+    std::vector<float> time;                  ///< Seconds since the match started
+    std::vector<std::int32_t> score1, score2, lives1, lives2;
+    std::vector<std::int32_t> batHits;        ///< Bounces off either bat
+    std::vector<std::int32_t> ticks;          ///< Ticks simulated while the match was running
+    std::vector<std::int32_t> done;           ///< Non-zero once the match is over
+};
+
+/**
+ * @class BatchSimulation
+ * @brief Owns a batch of matches and advances them with the fastest available kernel.
+ * The rules follow GameSimulation (side and bat rebounds, top and bottom scoring, lives,
+ * serve delay). Because the ball moves under a pixel per tick at the usual tick rates, a
+ * bat hit is detected as a crossing of the bat face within the tick rather than with the
+ * general multi-bounce sweep.
+ */
+class BatchSimulation {
+public:
+    /** @brief Kernel used by step(). */
+    enum class Backend { Auto, Scalar, Sse2, Avx2 };
+
+    /** @brief Lane arrays are padded to a multiple of this many matches. */
+    static constexpr std::size_t LaneAlign = 8;
+
+    /**
+     * @brief Sets up @p count matches with per-match serve angles and bot speeds drawn from @p seed.
+     */
+    BatchSimulation(std::size_t count, const BatchParams& params, std::uint32_t seed);
+
+    /**
+     * @brief Advances every unfinished match by @p ticks ticks.
+     * @param ticks Number of ticks.
+     * @param backend Kernel to use; Auto picks AVX2, then SSE2, then scalar.
+     */
+    void step(int ticks, Backend backend = Backend::Auto);
+
+    /** @brief Best kernel supported by this CPU and build. */
+    static Backend bestBackend();
+
+    /** @brief Whether a kernel can run on this CPU and build. */
+    static bool supported(Backend backend);
+
+    /** @brief Printable kernel name. */
+    static const char* backendName(Backend backend);
+
+    /** @brief Number of matches (without padding). */
+    std::size_t size() const { return m_Count; }
+
+    /** @brief Number of matches that are over. */
+    std::size_t finishedCount() const;
+
+    /** @brief Read access to the lane arrays. */
+    const BatchLanes& lanes() const { return m_Lanes; }
+
+    /** @brief Shared parameters. */
+    const BatchParams& params() const { return m_Params; }
+
+private:
+    std::size_t m_Count;
+    BatchParams m_Params;
+    BatchLanes m_Lanes;
+};
+
+/** @brief Scalar reference kernel over lanes [begin, end); the vector kernels must match it bit for bit. */
+void stepBatchScalar(BatchLanes& lanes, const BatchParams& params, std::size_t begin, std::size_t end, int ticks);
+
+/** @brief SSE2 kernel over lanes [begin, end); the range must be a multiple of 4 lanes. */
+void stepBatchSse2(BatchLanes& lanes, const BatchParams& params, std::size_t begin, std::size_t end, int ticks);
+
+/** @brief AVX2 kernel over lanes [begin, end); the range must be a multiple of 8 lanes. */
+void stepBatchAvx2(BatchLanes& lanes, const BatchParams& params, std::size_t begin, std::size_t end, int ticks);
+
+/** @brief Whether stepBatchAvx2 was built with AVX2 instructions (the CPU check is separate). */
+bool batchAvx2Compiled();
@@ -0,0 +1,83 @@
+/**
+ * @file ChaosSimulation.hpp
+ * @brief Headless multi-ball mode: hundreds to thousands of balls between two bats.
+ * @author Oussama Amara
+ * @date 2025-08-23
+ */
+
+#pragma once
+#include "EntityStore.hpp"
+#include "GameSimulation.hpp"
+#include "UniformGrid.hpp"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class ChaosSimulation
+ * @brief Balls, bats, broadphase and scores of the multi-ball mode.
+ * The balls live in an EntityStore, so the per-tick loops stream through dense arrays of
+ * floats. There are no lives; the mode runs until the player returns to the menu.
+ */
+class ChaosSimulation {
+public:
+    /** @brief How ball pairs are found; BruteForce tests every pair and exists for comparison. */
+    enum class Broadphase { Grid, BruteForce };
+
+    /** @brief Grid cell edge in pixels; must stay at least the ball size. */
+    static constexpr float CellSize = 32.f;
+
+    /** @brief Ball edge in pixels, as in Ball. */
+    static constexpr float BallSize = 10.f;
+
+    /** @brief Ball speed in pixels per second, as in Ball. */
+    static constexpr float BallSpeed = 1000.f;
+
+    /**
+     * @param resolution Width and height of the field in pixels.
+     * @param ballCount Number of balls.
+     * @param seed Seed for the serve positions and directions.
+     * @param broadphase Pair search used by step().
+     */
+    ChaosSimulation(Vec2 resolution, std::size_t ballCount, std::uint32_t seed = 1,
+                    Broadphase broadphase = Broadphase::Grid);
+
+    /** @brief Serves every ball again and clears the scores. */
+    void reset();
+
+    /**
+     * @brief Advances the mode by one tick.
+     * Every ball is swept against the walls and the nearby bats with Collision::sweepBall,
+     * then overlapping balls are pushed apart and bounced. A ball leaving through the bottom
+     * scores for player 2, through the top for player 1, and is served again from the centre
+     * in the opposite vertical direction.
+     * @return SimEvent flags (BatHit, WallHit, Point1, Point2).
+     */
+    std::uint32_t step(const TickInput& input, float dt);
+
+    /** @brief Every ball, for rendering. */
+    const EntityStore& entities() const { return m_Entities; }
+    const Bat& bat(int player) const { return m_Bats[player]; }
+    int score(int player) const { return m_Score[player]; }
+
+    /** @brief Ball pairs checked for overlap during the last tick. */
+    std::size_t pairTests() const { return m_PairTests; }
+
+private:
+    EntityHandle serve(Vec2 position, Vec2 direction);
+    void collideBalls(std::size_t a, std::size_t b);
+    void keepInField(std::size_t index);
+
+    Vec2 m_Resolution;
+    std::uint32_t m_Seed;
+    std::size_t m_BallCount;
+    Broadphase m_Broadphase;
+    EntityStore m_Entities;
+    Bat m_Bats[2];
+    UniformGrid m_Grid;
+    /** @brief Balls that left the field this tick, with the direction to serve them in. */
+    std::vector<std::pair<EntityHandle, Vec2>> m_Scored;
+    int m_Score[2] = {0, 0};
+    std::size_t m_PairTests = 0;
+    /** @brief Pairs pushed apart this tick; their balls are relinked in the grid afterwards. */
+    std::size_t m_Separated = 0;
+};
@@ -0,0 +1,100 @@
+/**
+ * @file Collision.hpp
+ * @brief Continuous (swept AABB) collision detection for the ball against bats and walls.
+ * @author Oussama Amara
+ * @date 2025-08-14
+ */
+
+#pragma once
+
+/**
+ * @brief Plain 2D vector.
+ */
+struct Vec2 {
+    float x = 0.f;
+    float y = 0.f;
+};
+
+/**
+ * @brief Axis-aligned box given by its top-left corner and size.
+ */
+struct Aabb {
+    float x = 0.f;
+    float y = 0.f;
+    float w = 0.f;
+    float h = 0.f;
+};
+
+/**
+ * @brief Result of sweeping one box against another.
+ */
+struct SweepHit {
+    bool hit = false;   ///< True when the boxes touch within the step
+    float time = 1.f;   ///< Fraction of the displacement travelled before contact, in [0, 1]
+    Vec2 normal;        ///< Contact normal pointing away from the surface that was hit
+};
+
+/**
+ * @brief Surfaces the ball can touch.
+ */
+enum class Surface { LeftWall, RightWall, TopWall, BottomWall, Bat };
+
+/**
+ * @brief One contact reported while resolving a step.
+ */
+struct Contact {
+    Surface surface;    ///< What was hit
+    int index;          ///< Bat index for Surface::Bat, -1 otherwise
+    float time;         ///< Fraction of the whole step at which the contact happened
+    Vec2 normal;        ///< Contact normal
+    Vec2 position;      ///< Ball top-left corner at the contact
+};
+
+/**
+ * @brief Playing field walls.
+ * Left, right and (optionally) top reflect the ball. Reaching the bottom, or the top when
+ * it does not reflect, ends the step: those are scoring events handled by the game rules.
+ */
+struct Arena {
+    float left = 0.f;       ///< x of the left wall
+    float right = 0.f;      ///< x of the right wall
+    float top = 0.f;        ///< y of the top wall
+    float bottom = 0.f;     ///< y the ball's top edge must pass to leave through the bottom
+    bool reflectTop = true; ///< Whether the top wall bounces the ball or ends the step
+};
+
+namespace Collision {
+
+/** @brief Maximum number of contacts resolved within a single step. */
+constexpr int MaxContacts = 8;
+
+/**
+ * @brief Sweeps a moving box against a static one.
+ * @param moving Box at the start of the step.
+ * @param displacement Movement of the box over the whole step.
+ * @param target Static box.
+ * @return Earliest contact, or hit == false when the boxes do not meet during the step.
+ */
+SweepHit sweepAabb(const Aabb& moving, Vec2 displacement, const Aabb& target);
+
+/**
+ * @brief Moves the ball through a whole step, bouncing off walls and bats.
+ * Instead of testing for overlap after the move, the displacement is swept against every
+ * surface to find the exact time of impact; the ball is advanced to the contact, reflected
+ * along its normal and the rest of the step is swept again, so several bounces can happen
+ * within one step and thin bats cannot be tunnelled.
+ * @param ball Ball box; updated to its final position.
+ * @param velocity Ball velocity in pixels per second; reflected on each bounce.
+ * @param dt Step length in seconds.
+ * @param arena Field walls.
+ * @param bats Static bat boxes (at their end-of-step positions).
+ * @param batCount Number of bats.
+ * @param contacts Receives the contacts in time order.
+ * @param maxContacts Capacity of @p contacts; resolution stops once it is full.
+ * @return Number of contacts written. When the last one is a non-reflecting wall the
+ *         ball is left at that contact.
+ */
+int sweepBall(Aabb& ball, Vec2& velocity, float dt, const Arena& arena,
+              const Aabb* bats, int batCount, Contact* contacts, int maxContacts);
+
+} // namespace Collision
@@ -0,0 +1,73 @@
+/**
+ * @file CpuPlayer.hpp
+ * @brief Computer opponent that steers a bat to where the ball will cross it.
+ * @author Oussama Amara
+ * @date 2025-08-29
+ */
+
+#pragma once
+#include "GameSimulation.hpp"
+#include <cstdint>
+#include <random>
+#include <string>
+
+/**
+ * @brief Difficulty knobs of a CpuPlayer.
+ */
+struct CpuDifficulty {
+    float reactionTime = 0.12f; ///< Seconds between looks at the ball
+    float aimError = 18.f;      ///< Standard deviation of the aim offset, redrawn per approach, in pixels
+
+    /**
+     * @brief Looks up a preset: "easy", "normal" or "hard".
+     * @return false if the name is unknown.
+     */
+    static bool fromName(const std::string& name, CpuDifficulty& out);
+};
+
+/**
+ * @class CpuPlayer
+ * @brief Produces the keys of one player from the match state.
+ * The random draws come from the seed only, so headless matches are reproducible.
+ */
+class CpuPlayer {
+public:
+    /**
+     * @param player 0 for the bottom bat, 1 for the top bat.
+     * @param difficulty Reaction time and aim error.
+     * @param seed Seed of the aim error.
+     */
+    CpuPlayer(int player, const CpuDifficulty& difficulty, std::uint32_t seed);
+
+    /**
+     * @brief Keys to hold for the next tick.
+     * @param state Current match state.
+     * @param fieldWidth Width of the field in pixels.
+     * @param dt Tick length in seconds.
+     */
+    PlayerInput input(const MatchState& state, float fieldWidth, float dt);
+
+    /**
+     * @brief Left edge of the ball when its top edge reaches @p planeY, in closed form: the
+     * ball covers d * |dirX / dirY| horizontally while crossing a vertical distance d, so
+     * each call is O(1) however many wall bounces lie ahead.
+     * @param ball Ball to follow.
+     * @param planeY Height at which the intercept is wanted.
+     * @param turnY Height at which a ball moving away from @p planeY comes back.
+     * @param fieldWidth Width of the field; the side walls reflect the ball.
+     */
+    static float interceptX(const Ball& ball, float planeY, float turnY, float fieldWidth);
+
+    /** @brief Where the player currently aims the centre of its bat. */
+    float target() const { return m_Target; }
+
+private:
+    int m_Player;
+    CpuDifficulty m_Difficulty;
+    std::mt19937 m_Rng;
+    std::normal_distribution<float> m_Error;
+    float m_SinceLook = 0.f; ///< Seconds since the ball was last looked at
+    float m_Offset = 0.f;    ///< Aim error for the current approach
+    float m_Target = -1.f;   ///< Aimed bat centre; negative until the first look
+    bool m_Approaching = false;
+};
@@ -12,20 +12,70 @@
 #include <SFML/Graphics.hpp>
 #include "Bat.hpp"
 #include "Ball.hpp"
+#include "BatchRenderer.hpp"
+#include "ChaosSimulation.hpp"
+#include "RenderQueue.hpp"
+#include "SceneRecorder.hpp"
+#include "SfmlRenderBackend.hpp"
+#include "StressScene.hpp"
 
 /**
  * @class DisplayManager
  * @brief Manages the rendering of game elements and HUD.   
  * Handles different game states like menu, single-player, and multiplayer.
  * Provides methods to render the game screen and update HUD elements.
+ * Screens are recorded into a RenderQueue by SceneRecorder and submitted to the window
+ * in one sorted, merged pass.
  */
 class DisplayManager {
 public:
     DisplayManager(sf::Font& font, const sf::Vector2f& resolution);
+    /** @brief Not copyable: the render backend points at this object's texts. */
+    DisplayManager(const DisplayManager&) = delete;
+    DisplayManager& operator=(const DisplayManager&) = delete;
     void renderMenu(sf::RenderWindow& window);
-    void renderSingleplayer(sf::RenderWindow& window, const Bat& bat, const Ball& ball, int score, int lives, int highScore1);
-    void renderMultiplayer(sf::RenderWindow& window, const Bat& bat1, const Bat& bat2, const Ball& ball, int score1, int lives1, int score2, int lives2);
+    void renderSingleplayer(sf::RenderWindow& window, const Bat& bat, const Ball& ball, int score, int lives, int highScore1, float alpha = 1.f);
+    void renderMultiplayer(sf::RenderWindow& window, const Bat& bat1, const Bat& bat2, const Ball& ball, int score1, int lives1, int score2, int lives2, float alpha = 1.f);
+    /** @brief Renders the multi-ball mode: both bats, every ball and both scores. */
+    void renderChaos(sf::RenderWindow& window, const ChaosSimulation& chaos, float alpha = 1.f);
+    /** @brief Renders the stress scene with its entity count, draw calls and frame time. */
+    void renderStress(sf::RenderWindow& window, const StressScene& scene);
+
+    /** @brief Draw calls issued for the last presented frame. */
+    std::size_t drawCalls() const { return lastDrawCalls; }
+
+    /** @brief Rectangles whose vertices the last presented frame had to rewrite. */
+    std::size_t quadRewrites() const { return lastQuadRewrites; }
+
+    /** @brief Shows or hides the frame-timing overlay (p50/p99/max per phase). */
+    void toggleProfilerOverlay() { showProfiler = !showProfiler; }
+
+    /** @brief Whether the frame-timing overlay is shown; it needs redrawing every frame. */
+    bool profilerOverlayVisible() const { return showProfiler; }
 
 private:
-    sf::Text hud_1, hud_2, GameMode;
+    void submit(sf::RenderWindow& window);
+    void present(sf::RenderWindow& window);
+
+    sf::Text GameMode;
+    sf::Vector2f resolution;
+    /** @brief Records the menu, HUD, bats and balls of each screen. */
+    SceneRecorder scenes;
+    /** @brief Commands of the frame being drawn. */
+    RenderQueue queue;
+    /** @brief Draws the queue into the window; knows the texts and the stress batch by handle. */
+    SfmlRenderBackend backend;
+    /** @brief Boxes of the stress scene. */
+    BatchRenderer stressBatch;
+    /** @brief Entity count, draw calls and frame time shown in stress mode. */
+    sf::Text statsText;
+    std::size_t statsVertices = 0;
+    sf::Clock statsRefresh;
+    std::size_t lastDrawCalls = 0;
+    std::size_t lastQuadRewrites = 0;
+    /** @brief Frame-timing table, refreshed a few times per second while visible. */
+    sf::Text profilerText;
+    std::size_t profilerVertices = 0;
+    sf::Clock profilerRefresh;
+    bool showProfiler = false;
 };
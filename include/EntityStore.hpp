@@ -0,0 +1,150 @@
+/**
+ * @file EntityStore.hpp
+ * @brief Data-oriented storage for many small game entities (balls, bats, power-ups).
+ * @author Oussama Amara
+ * @date 2025-08-24
+ */
+
+#pragma once
+#include "Collision.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief What an entity is; systems use it to pick the entities they handle.
+ */
+enum class EntityKind : std::uint8_t { Bat, Ball, PowerUp };
+
+/**
+ * @brief Stable reference to an entity: a slot plus the generation the slot had at spawn.
+ * It survives despawn moving other entities and turns stale once its own entity is
+ * despawned, even if the slot is reused.
+ */
+struct EntityHandle {
+    std::uint32_t slot = ~0u;
+    std::uint32_t generation = 0;
+};
+
+/** @brief Position now and at the start of the last tick (for render interpolation). */
+struct Transform {
+    Vec2 position;
+    Vec2 previous;
+};
+
+/** @brief Direction multipliers and speed in pixels per second, as in Ball. */
+struct Motion {
+    Vec2 direction;
+    float speed = 0.f;
+};
+
+/** @brief How an entity is drawn. */
+struct RenderInfo {
+    std::uint32_t color = 0xFFFFFFFFu; ///< RGBA, red in the top byte
+    EntityKind kind = EntityKind::Ball;
+};
+
+/**
+ * @class EntityStore
+ * @brief Fixed-capacity, chunked structure-of-arrays entity storage with generational handles.
+ * Each component is a separate dense array, so a system that only moves entities streams
+ * through transforms and motions without pulling sizes or colours into the cache. Live
+ * entities are always packed at dense indices [0, size()).
+ */
+class EntityStore {
+public:
+    /** @brief Entities per chunk; a power of two so dense indices split with a shift. */
+    static constexpr std::size_t ChunkSize = 256;
+
+    /**
+     * @param capacity Most entities alive at once; all chunks are allocated here.
+     */
+    explicit EntityStore(std::size_t capacity);
+
+    /**
+     * @brief Adds an entity at dense index size(); O(1) and never allocates.
+     * @return Its handle, or an invalid handle (alive() false) when the store is full.
+     */
+    EntityHandle spawn(EntityKind kind, Vec2 position, Vec2 size, const Motion& motion,
+                       std::uint32_t color = 0xFFFFFFFFu);
+
+    /**
+     * @brief Removes an entity; the last entity moves into its dense index.
+     * @return False if the handle was already stale.
+     */
+    bool despawn(EntityHandle handle);
+
+    /** @brief Removes every entity and invalidates every handle. */
+    void clear();
+
+    /** @brief Whether the handle still refers to a live entity. */
+    bool alive(EntityHandle handle) const {
+        return handle.slot < m_Generation.size() && m_Generation[handle.slot] == handle.generation &&
+               m_DenseOfSlot[handle.slot] != Dead;
+    }
+
+    /** @brief Live entities. */
+    std::size_t size() const { return m_Size; }
+
+    /** @brief Most entities alive at once. */
+    std::size_t capacity() const { return m_Chunks.size() * ChunkSize; }
+
+    /** @brief Dense index of a live entity. */
+    std::size_t indexOf(EntityHandle handle) const { return m_DenseOfSlot[handle.slot]; }
+
+    /** @brief Dense index of the entity in a slot, e.g. one stored by slot in a UniformGrid. */
+    std::size_t indexOfSlot(std::uint32_t slot) const { return m_DenseOfSlot[slot]; }
+
+    /** @brief Handle of the entity at a dense index. */
+    EntityHandle handleAt(std::size_t index) const {
+        std::uint32_t slot = chunk(index).slots[index & Mask];
+        return EntityHandle{slot, m_Generation[slot]};
+    }
+
+    Transform& transform(std::size_t index) { return chunk(index).transforms[index & Mask]; }
+    const Transform& transform(std::size_t index) const { return chunk(index).transforms[index & Mask]; }
+    Motion& motion(std::size_t index) { return chunk(index).motions[index & Mask]; }
+    const Motion& motion(std::size_t index) const { return chunk(index).motions[index & Mask]; }
+    Vec2& size(std::size_t index) { return chunk(index).sizes[index & Mask]; }
+    const Vec2& size(std::size_t index) const { return chunk(index).sizes[index & Mask]; }
+    RenderInfo& render(std::size_t index) { return chunk(index).renders[index & Mask]; }
+    const RenderInfo& render(std::size_t index) const { return chunk(index).renders[index & Mask]; }
+
+    /** @brief Current box of the entity at a dense index. */
+    Aabb bounds(std::size_t index) const {
+        const Vec2& p = transform(index).position;
+        const Vec2& s = size(index);
+        return Aabb{p.x, p.y, s.x, s.y};
+    }
+
+    /** @brief Box to draw, blended between the previous and current tick as in Ball. */
+    Aabb renderBounds(std::size_t index, float alpha) const {
+        const Transform& t = transform(index);
+        const Vec2& s = size(index);
+        return Aabb{t.previous.x + (t.position.x - t.previous.x) * alpha,
+                    t.previous.y + (t.position.y - t.previous.y) * alpha, s.x, s.y};
+    }
+
+private:
+    static constexpr std::size_t Mask = ChunkSize - 1;
+    static constexpr std::uint32_t Dead = ~0u;
+
+    /** @brief One block of every component array, plus the slot owning each dense index. */
+    struct Chunk {
+        std::array<Transform, ChunkSize> transforms;
+        std::array<Motion, ChunkSize> motions;
+        std::array<Vec2, ChunkSize> sizes;
+        std::array<RenderInfo, ChunkSize> renders;
+        std::array<std::uint32_t, ChunkSize> slots;
+    };
+
+    Chunk& chunk(std::size_t index) { return *m_Chunks[index / ChunkSize]; }
+    const Chunk& chunk(std::size_t index) const { return *m_Chunks[index / ChunkSize]; }
+
+    std::vector<std::unique_ptr<Chunk>> m_Chunks;
+    std::vector<std::uint32_t> m_DenseOfSlot;   ///< Dense index per slot, Dead when free
+    std::vector<std::uint32_t> m_Generation;    ///< Bumped on every despawn of the slot
+    std::vector<std::uint32_t> m_FreeSlots;     ///< Stack of free slots
+    std::size_t m_Size = 0;
+};
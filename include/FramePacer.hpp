@@ -0,0 +1,58 @@
+/**
+ * @file FramePacer.hpp
+ * @brief Caps the frame rate with a low-jitter hybrid wait: sleep most of the way, then spin.
+ * @author Oussama Amara
+ * @date 2025-08-28
+ */
+
+#pragma once
+#include <chrono>
+
+/**
+ * @class FramePacer
+ * @brief Fixed-rate frame scheduler with an adaptive sleep-then-spin wait.
+ */
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @param targetHz Frames per second, or 0 to run unpaced.
+     * @param profile Whether waits are recorded as Phase::Pacing and Phase::FrameJitter.
+     */
+    explicit FramePacer(double targetHz = 0.0, bool profile = true);
+
+    /** @brief Changes the target; 0 disables pacing. */
+    void setTarget(double targetHz);
+
+    /** @brief Target frames per second, 0 when unpaced. */
+    double target() const { return m_TargetHz; }
+
+    /**
+     * @brief Blocks until the next frame is due. Call once per frame, after display().
+     * Sleeps until spinMargin() before the deadline and yields in a loop for the rest. A frame
+     * that already overran the period does not wait, and a loop more than a period behind
+     * moves the grid to the present instead of rushing frames to catch up.
+     */
+    void wait();
+
+    /**
+     * @brief Starts a new grid at the next wait(), e.g. after the loop slept in waitEvent().
+     */
+    void resync() { m_Started = false; }
+
+    /**
+     * @brief Current spin margin: how long before a deadline sleeping stops. It grows at once
+     * when a sleep overshoots and shrinks slowly while sleeps are accurate.
+     */
+    Clock::duration spinMargin() const { return m_SpinMargin; }
+
+private:
+    double m_TargetHz = 0.0;
+    bool m_Profile = true;
+    Clock::duration m_Period{0};
+    Clock::time_point m_Deadline;
+    Clock::time_point m_LastFrame;
+    bool m_Started = false;
+    Clock::duration m_SpinMargin = std::chrono::milliseconds(1);
+};
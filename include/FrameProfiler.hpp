@@ -0,0 +1,152 @@
+/**
+ * @file FrameProfiler.hpp
+ * @brief Per-phase timing of the game loop with lock-free histograms.
+ * @author Oussama Amara
+ * @date 2025-08-21
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Parts of a frame that are timed separately.
+ */
+enum class Phase : std::uint8_t {
+    Frame,       ///< Whole loop iteration
+    Input,       ///< Event polling and keyboard sampling
+    Simulation,  ///< All simulation ticks of the frame
+    BatUpdate,   ///< Bat movement, per tick
+    BallUpdate,  ///< Ball movement including collision, per tick
+    Collision,   ///< Swept collision alone, per tick
+    Render,      ///< Clearing and drawing, up to window.display()
+    Display,     ///< window.display(), including any vsync wait
+    LogWrite,    ///< Logger writer thread: one batch of entries written and flushed
+    Pacing,      ///< FramePacer waiting for the next frame deadline
+    FrameJitter, ///< Distance of the achieved frame interval from the FramePacer target
+    SnapshotAge, ///< Age of the simulation thread's snapshot when it is drawn
+    Count
+};
+
+/** @brief Short name of a phase, used in the overlay and the CSV. */
+const char* phaseName(Phase phase);
+
+/**
+ * @brief Lock-free duration histogram with log-linear buckets (about 6% wide). Every counter
+ * is an atomic, so several threads can record while the overlay reads percentiles.
+ */
+class PhaseHistogram {
+public:
+    /** @brief Sub-buckets per power of two. */
+    static constexpr int SubBuckets = 16;
+    /** @brief Bucket count; covers 1 ns to 2^40 ns (about 18 minutes). */
+    static constexpr int Buckets = 37 * SubBuckets;
+
+    /** @brief Adds one sample. */
+    void record(std::uint64_t ns);
+
+    /** @brief Clears every counter. Samples recorded concurrently may be kept or lost. */
+    void reset();
+
+    /** @brief Number of samples. */
+    std::uint64_t count() const { return m_Count.load(std::memory_order_relaxed); }
+
+    /** @brief Mean duration in nanoseconds. */
+    double meanNs() const;
+
+    /** @brief Largest sample in nanoseconds. */
+    std::uint64_t maxNs() const { return m_Max.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Duration below which the given fraction of samples fall (upper edge of the bucket).
+     * @param q Quantile in [0, 1], e.g. 0.99.
+     */
+    std::uint64_t quantileNs(double q) const;
+
+    /** @brief Bucket of a duration. */
+    static int bucketOf(std::uint64_t ns);
+
+    /** @brief Largest duration that falls into a bucket. */
+    static std::uint64_t bucketUpperNs(int bucket);
+
+private:
+    std::array<std::atomic<std::uint32_t>, Buckets> m_Buckets{};
+    std::atomic<std::uint64_t> m_Count{0};
+    std::atomic<std::uint64_t> m_Sum{0};
+    std::atomic<std::uint64_t> m_Max{0};
+};
+
+/**
+ * @class FrameProfiler
+ * @brief Process-wide set of phase histograms.
+ */
+class FrameProfiler {
+public:
+    /** @brief Returns the process-wide profiler. */
+    static FrameProfiler& instance();
+
+    /** @brief Starts or stops recording; off by default so headless tools skip the clock reads. */
+    void enable(bool on) { m_Enabled.store(on, std::memory_order_relaxed); }
+
+    /** @brief Whether samples are being recorded. */
+    bool enabled() const { return m_Enabled.load(std::memory_order_relaxed); }
+
+    /** @brief Adds a sample to a phase if recording is on. */
+    void record(Phase phase, std::uint64_t ns) {
+        if (enabled())
+            m_Phases[static_cast<int>(phase)].record(ns);
+    }
+
+    /** @brief Histogram of one phase. */
+    const PhaseHistogram& histogram(Phase phase) const { return m_Phases[static_cast<int>(phase)]; }
+
+    /** @brief Clears every phase. */
+    void reset();
+
+    /**
+     * @brief Multi-line p50/p99/max table in microseconds, for the overlay.
+     */
+    std::string summary() const;
+
+    /**
+     * @brief Writes one row per phase: count, mean, p50, p90, p99, p99.9 and max in microseconds.
+     * @return False if the file cannot be written.
+     */
+    bool writeCsv(const std::string& path) const;
+
+    /** @brief Monotonic clock in nanoseconds. */
+    static std::uint64_t now() {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+private:
+    FrameProfiler() = default;
+
+    std::atomic<bool> m_Enabled{false};
+    std::array<PhaseHistogram, static_cast<int>(Phase::Count)> m_Phases;
+};
+
+/**
+ * @brief Times the enclosing scope into a phase; costs one relaxed load when profiling is off.
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Phase phase)
+        : m_Phase(phase), m_Start(FrameProfiler::instance().enabled() ? FrameProfiler::now() : 0) {}
+
+    ~ScopedTimer() {
+        if (m_Start)
+            FrameProfiler::instance().record(m_Phase, FrameProfiler::now() - m_Start);
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Phase m_Phase;
+    std::uint64_t m_Start;
+};
@@ -0,0 +1,131 @@
+/**
+ * @file GameSimulation.hpp
+ * @brief Headless Pong rules: bats, ball, scoring, lives and game mode, with no window or keyboard.
+ * @author Oussama Amara
+ * @date 2025-08-16
+ */
+
+#pragma once
+#include "Ball.hpp"
+#include "Bat.hpp"
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief Screen the game is on.
+ */
+enum class GameMode : std::uint8_t { Menu = 0, Singleplayer = 1, Multiplayer = 2 };
+
+/**
+ * @brief Movement keys held by one player during a tick.
+ */
+struct PlayerInput {
+    bool left = false;
+    bool right = false;
+};
+
+/**
+ * @brief Inputs of both players for one tick. Player 1 owns the bottom bat.
+ */
+struct TickInput {
+    PlayerInput players[2];
+};
+
+/**
+ * @brief Bit flags returned by GameSimulation::step describing what happened in the tick.
+ */
+namespace SimEvent {
+enum : std::uint32_t {
+    None      = 0,
+    BatHit    = 1u << 0, ///< The ball bounced off a bat
+    WallHit   = 1u << 1, ///< The ball bounced off a side or the top wall
+    Point1    = 1u << 2, ///< Player 1 scored
+    Point2    = 1u << 3, ///< Player 2 scored
+    LifeLost1 = 1u << 4, ///< Player 1 lost a life
+    LifeLost2 = 1u << 5, ///< Player 2 lost a life
+    HighScore = 1u << 6, ///< A new single-player high score was set
+    GameOver  = 1u << 7  ///< The match ended and the game returned to the menu
+};
+}
+
+/**
+ * @brief Complete, trivially copyable state of the game.
+ * Index 0 of the per-player arrays is player 1 (bottom bat), index 1 is player 2 (top bat).
+ */
+struct MatchState {
+    GameMode mode = GameMode::Menu;
+    Ball ball;
+    Bat bats[2];
+    int score[2] = {0, 0};
+    int lives[2] = {3, 3};
+    int highScore = 0;
+    float timeElapsed = 0.f;
+    std::uint32_t tick = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<MatchState>, "MatchState must stay copyable with memcpy");
+
+/**
+ * @class GameSimulation
+ * @brief Owns a MatchState and applies the single-player and multiplayer rules to it.
+ * The game loop only turns keyboard state into TickInput, calls step() and draws the
+ * MatchState; Ball and Bat hold plain simulation state, and all drawing is done by
+ * DisplayManager. Tools can therefore drive matches at any speed without a display.
+ */
+class GameSimulation {
+public:
+    /** @brief Lives each player starts a match with. */
+    static constexpr int StartingLives = 3;
+
+    /** @brief Seconds after a game over before reaching the top scores in single player. */
+    static constexpr float ServeDelay = 1.f;
+
+    /**
+     * @brief Places the bats and the ball for a field of the given size.
+     * @param resolution Width and height of the field in pixels.
+     */
+    explicit GameSimulation(Vec2 resolution);
+
+    /**
+     * @brief Leaves the menu and starts (or resumes) a match in the given mode.
+     */
+    void start(GameMode mode);
+
+    /**
+     * @brief Goes back to the menu without resetting the match.
+     */
+    void returnToMenu();
+
+    /**
+     * @brief Advances the game by one tick.
+     * @param input Keys held by both players during the tick.
+     * @param dt Tick length in seconds.
+     * @return SimEvent flags for what happened during the tick.
+     */
+    std::uint32_t step(const TickInput& input, float dt);
+
+    /** @brief Current state, e.g. for rendering. */
+    const MatchState& state() const { return m_State; }
+
+    /** @brief Replaces the whole state (snapshots, replays). */
+    void restore(const MatchState& state) { m_State = state; }
+
+    /** @brief Current screen. */
+    GameMode mode() const { return m_State.mode; }
+
+    /** @brief Size of the field in pixels. */
+    Vec2 resolution() const { return m_Resolution; }
+
+    /**
+     * @brief Turns held keys into bat movement, refusing to leave a field of the given width.
+     */
+    static void applyInput(Bat& bat, const PlayerInput& input, float fieldWidth);
+
+private:
+    void setMode(GameMode mode);
+    std::uint32_t stepSingleplayer(const TickInput& input, float dt);
+    std::uint32_t stepMultiplayer(const TickInput& input, float dt);
+
+    Vec2 m_Resolution;
+    MatchState m_State;
+};
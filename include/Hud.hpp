@@ -0,0 +1,146 @@
+/**
+ * @file Hud.hpp
+ * @brief Builds the HUD lines drawn by DisplayManager and SoftwareRenderer.
+ * @author Oussama Amara
+ * @date 2025-08-20
+ */
+
+#pragma once
+#include "Collision.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Hud {
+
+/**
+ * @brief Single-player line, e.g. "Score:3 Lives:2 High:10".
+ */
+std::string singleplayer(int score, int lives, int highScore);
+
+/**
+ * @brief One player's multiplayer line, e.g. "Score:3 Lives:2".
+ */
+std::string player(int score, int lives);
+
+/** @brief The menu's lines, one per mode. */
+inline constexpr std::string_view MenuText =
+    "1- Single player mode\n2- Multiplayer mode\n3- Chaos mode\n4- Versus CPU";
+
+/**
+ * @brief Segment bits of a seven-segment cell; Colon is the pair of dots between label and value.
+ */
+enum Segment : std::uint8_t {
+    SegTop = 1 << 0,
+    SegUpperRight = 1 << 1,
+    SegLowerRight = 1 << 2,
+    SegBottom = 1 << 3,
+    SegLowerLeft = 1 << 4,
+    SegUpperLeft = 1 << 5,
+    SegMiddle = 1 << 6,
+    SegColon = 1 << 7
+};
+
+/**
+ * @brief Segments lit for every ASCII character; letters use the usual seven-segment shapes
+ * (V reads as U) and characters without a shape stay blank.
+ */
+constexpr std::array<std::uint8_t, 128> makeGlyphTable() {
+    std::array<std::uint8_t, 128> t{};
+    constexpr std::uint8_t A = SegTop, B = SegUpperRight, C = SegLowerRight, D = SegBottom,
+                           E = SegLowerLeft, F = SegUpperLeft, G = SegMiddle;
+    t['0'] = A | B | C | D | E | F;
+    t['1'] = B | C;
+    t['2'] = A | B | G | E | D;
+    t['3'] = A | B | G | C | D;
+    t['4'] = F | G | B | C;
+    t['5'] = A | F | G | C | D;
+    t['6'] = A | F | G | E | C | D;
+    t['7'] = A | B | C;
+    t['8'] = A | B | C | D | E | F | G;
+    t['9'] = A | B | C | D | F | G;
+    t['A'] = A | B | C | E | F | G;
+    t['B'] = F | E | G | C | D;
+    t['C'] = A | F | E | D;
+    t['D'] = B | C | D | E | G;
+    t['E'] = A | F | G | E | D;
+    t['F'] = A | F | G | E;
+    t['G'] = A | F | E | D | C;
+    t['H'] = F | E | G | B | C;
+    t['I'] = F | E;
+    t['J'] = B | C | D | E;
+    t['L'] = F | E | D;
+    t['N'] = E | G | C;
+    t['O'] = A | B | C | D | E | F;
+    t['P'] = A | B | F | G | E;
+    t['R'] = E | G;
+    t['S'] = A | F | G | C | D;
+    t['T'] = F | E | D | G;
+    t['U'] = F | E | D | C | B;
+    t['V'] = F | E | D | C | B;
+    t['Y'] = F | G | B | C | D;
+    t['-'] = G;
+    t[':'] = SegColon;
+    for (char c = 'a'; c <= 'z'; ++c)
+        t[static_cast<std::size_t>(c)] = t[static_cast<std::size_t>(c - 'a' + 'A')];
+    return t;
+}
+
+/** @brief Segment mask per ASCII character, built at compile time. */
+inline constexpr std::array<std::uint8_t, 128> GlyphTable = makeGlyphTable();
+
+/** @brief Segments of one character; non-ASCII characters are blank. */
+constexpr std::uint8_t glyph(char c) {
+    auto index = static_cast<unsigned char>(c);
+    return index < GlyphTable.size() ? GlyphTable[index] : 0;
+}
+
+/**
+ * @brief Size of a seven-segment cell in pixels.
+ */
+struct SegmentStyle {
+    float width = 14.f;     ///< Cell width
+    float height = 26.f;    ///< Cell height
+    float thickness = 3.f;  ///< Segment thickness
+    float spacing = 6.f;    ///< Gap between cells
+};
+
+/** @brief Width of a line laid out by appendSegments. */
+float segmentWidth(std::string_view text, const SegmentStyle& style);
+
+/**
+ * @brief Appends one rectangle per lit segment of every character, starting at (x, y).
+ * @return Number of rectangles appended.
+ */
+std::size_t appendSegments(std::vector<Aabb>& out, std::string_view text, float x, float y,
+                           const SegmentStyle& style);
+
+/**
+ * @brief Lays out the HUD lines the way the game shows them: the left line at the left
+ * edge and the right one right-aligned, both mid-screen.
+ * @param right Line for player 2, empty in single player.
+ * @return Number of rectangles appended.
+ */
+std::size_t appendHud(std::vector<Aabb>& out, std::string_view left, std::string_view right, Vec2 resolution,
+                      const SegmentStyle& style);
+
+/**
+ * @brief Size of a 5x7 dot-matrix cell, for text seven segments cannot spell (the menu).
+ */
+struct PixelStyle {
+    float dot = 8.f;        ///< Size of one dot
+    float spacing = 8.f;    ///< Gap between cells
+    float lineGap = 24.f;   ///< Gap between lines
+};
+
+/**
+ * @brief Appends the lit dots of every character, one rectangle per horizontal run,
+ * starting at (x, y). Letters are drawn upper case; '\n' starts a new line.
+ * @return Number of rectangles appended.
+ */
+std::size_t appendPixelText(std::vector<Aabb>& out, std::string_view text, float x, float y,
+                            const PixelStyle& style);
+
+} // namespace Hud
@@ -0,0 +1,121 @@
+/**
+ * @file InputQueue.hpp
+ * @brief Timestamped queue of gameplay key presses and releases, applied per simulation tick.
+ * @author Oussama Amara
+ * @date 2025-08-27
+ */
+
+#pragma once
+#include "GameSimulation.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Movement keys of both players.
+ */
+enum class InputKey : std::uint8_t { Player1Left, Player1Right, Player2Left, Player2Right, Count };
+
+/**
+ * @brief One press or release.
+ */
+struct InputEvent {
+    std::uint64_t timeNs; ///< InputQueue::now() when the event was seen
+    InputKey key;
+    bool pressed;
+};
+
+/**
+ * @brief Latency figures over the recorded presses, in microseconds.
+ */
+struct InputLatencySummary {
+    std::size_t presses = 0;
+    double appliedMean = 0, appliedP50 = 0, appliedP99 = 0, appliedMax = 0;
+    double visibleMean = 0, visibleP50 = 0, visibleP99 = 0, visibleMax = 0;
+};
+
+/**
+ * @class InputQueue
+ * @brief Fixed-capacity event queue plus held-key state and latency samples.
+ * When a frame runs several ticks, a key pressed late in the frame only moves its bat from
+ * the matching tick on, instead of every tick sharing one keyboard sample. For every press
+ * it measures the time until a tick applied it and until a frame showing it was presented.
+ */
+class InputQueue {
+public:
+    /** @brief Events waiting at once; more are dropped (and counted). */
+    static constexpr std::size_t Capacity = 256;
+
+    /** @brief Latency samples kept; the oldest are overwritten. */
+    static constexpr std::size_t MaxSamples = 4096;
+
+    InputQueue();
+
+    /** @brief Monotonic clock in nanoseconds used for every timestamp. */
+    static std::uint64_t now();
+
+    /**
+     * @brief Queues a press or release. Repeats of the key's latest state (auto-repeat)
+     * are ignored.
+     */
+    void push(InputKey key, bool pressed, std::uint64_t timeNs);
+
+    /** @brief Queues a release of every key that is down, e.g. when the window loses focus. */
+    void releaseAll(std::uint64_t timeNs);
+
+    /**
+     * @brief Applies the events stamped up to @p tickEndNs and returns the tick's input.
+     * A key counts as held if it was down at any moment of the tick, so a tap shorter than
+     * a tick still moves the bat for one tick.
+     * @param tickEndNs Wall-clock time the tick ends at.
+     * @param nowNs Current time, for the applied latency of the presses consumed.
+     */
+    TickInput consume(std::uint64_t tickEndNs, std::uint64_t nowNs);
+
+    /** @brief Marks the presses applied since the last call as visible on screen. */
+    void presented(std::uint64_t nowNs) { presented(nowNs, m_Applied); }
+
+    /**
+     * @brief Marks as visible the presses among the first @p applied ever applied that were
+     * not yet shown, for a frame drawn from a snapshot taken when applied() was @p applied.
+     */
+    void presented(std::uint64_t nowNs, std::uint64_t applied);
+
+    /** @brief Presses applied by consume() so far. */
+    std::uint64_t applied() const { return m_Applied; }
+
+    /** @brief Events dropped because the queue was full. */
+    std::uint64_t dropped() const { return m_Dropped; }
+
+    /** @brief Latency over the recorded presses. */
+    InputLatencySummary summary() const;
+
+    /**
+     * @brief Writes one CSV row per recorded press (applied and visible latency in microseconds).
+     * @return false if the file cannot be written.
+     */
+    bool writeCsv(const std::string& path) const;
+
+private:
+    static constexpr std::size_t KeyCount = static_cast<std::size_t>(InputKey::Count);
+
+    /** @brief Latency of one press; visible is 0 until the frame showing it is presented. */
+    struct Sample {
+        std::uint64_t pressNs;
+        std::uint64_t appliedNs;
+        std::uint64_t visibleNs;
+    };
+
+    std::array<InputEvent, Capacity> m_Events;
+    std::size_t m_Head = 0;  ///< Oldest queued event
+    std::size_t m_Count = 0;
+    std::array<bool, KeyCount> m_Held{};   ///< State after the consumed events
+    std::array<bool, KeyCount> m_Latest{}; ///< State after the queued events
+    std::uint64_t m_Dropped = 0;
+
+    std::vector<Sample> m_Samples; ///< Ring of MaxSamples
+    std::size_t m_NextSample = 0;
+    std::size_t m_Unpresented = 0; ///< Samples at the end of the ring still waiting for present()
+    std::uint64_t m_Applied = 0;
+};
@@ -0,0 +1,183 @@
+/**
+ * @file Leaderboard.hpp
+ * @brief Crash-safe persistent high scores and match history: an append-only checksummed log.
+ * @author Oussama Amara
+ * @date 2025-08-30
+ */
+
+#pragma once
+#include "GameSimulation.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Header at the start of the leaderboard file.
+ */
+struct LeaderboardHeader {
+    char magic[4];           ///< "PLBD"
+    std::uint16_t version;   ///< Format version, currently 1
+    std::uint16_t frameSize; ///< Bytes per record frame, sizeof(LeaderboardFrame)
+};
+
+static_assert(sizeof(LeaderboardHeader) == 8, "LeaderboardHeader layout is part of the file format");
+
+/**
+ * @brief One finished match. Slot 0 is player 1 (bottom bat); slot 1 is unused in single player.
+ */
+struct MatchRecord {
+    std::int64_t time = 0;        ///< Unix time the match ended
+    std::uint32_t durationMs = 0; ///< Length of the match in simulated time
+    std::uint8_t mode = 0;        ///< GameMode
+    std::uint8_t reserved[3] = {0, 0, 0};
+    std::int32_t score[2] = {0, 0};
+    char players[2][16] = {};     ///< NUL-padded names; empty for no player
+};
+
+/**
+ * @brief A record as stored in the log: checksum and sequence number, then the record.
+ */
+struct LeaderboardFrame {
+    std::uint32_t crc;      ///< CRC-32 of the sequence number and the record
+    std::uint32_t sequence; ///< Position of the record in the log, from 0
+    MatchRecord record;
+};
+
+static_assert(sizeof(MatchRecord) == 56, "MatchRecord layout is part of the file format");
+static_assert(sizeof(LeaderboardFrame) == 64, "LeaderboardFrame layout is part of the file format");
+static_assert(std::is_trivially_copyable_v<LeaderboardFrame>, "frames are written with a single copy");
+
+/**
+ * @brief One line of a top-scores table.
+ */
+struct LeaderboardEntry {
+    std::string player;
+    int score = 0;
+    std::int64_t time = 0;
+};
+
+/**
+ * @brief What the store has done so far.
+ */
+struct LeaderboardStats {
+    bool loaded = false;           ///< The initial scan has finished
+    std::uint64_t records = 0;     ///< Records in the log
+    std::uint64_t tornBytes = 0;   ///< Bytes cut off the end of the log at load
+    std::uint64_t compactions = 0;
+    double loadMs = 0.0;           ///< Time taken by the initial scan
+};
+
+/**
+ * @class Leaderboard
+ * @brief Append-only score log with a background writer and an in-memory index.
+ * All file I/O, loading included, happens on the writer thread; the game only queues
+ * records and reads the index under a short lock. Until the load finishes the index is empty.
+ */
+class Leaderboard {
+public:
+    /** @brief Entries kept per mode in the top-scores table. */
+    static constexpr std::size_t TopK = 10;
+
+    /** @brief Most recent matches kept in the history (and across compactions). */
+    static constexpr std::size_t HistoryKeep = 512;
+
+    /**
+     * @brief Records added since the last compaction that trigger the next one; a freshly
+     * loaded log counts in full.
+     */
+    static constexpr std::size_t CompactThreshold = 4096;
+
+    /** @brief Longest player name stored; longer names are cut. */
+    static constexpr std::size_t MaxNameLength = 15;
+
+    /**
+     * @brief Starts the writer thread, which loads the log (creating it if needed).
+     * @param path Log file.
+     */
+    explicit Leaderboard(std::string path);
+
+    /** @brief Writes every queued record, then stops the writer thread. */
+    ~Leaderboard();
+
+    Leaderboard(const Leaderboard&) = delete;
+    Leaderboard& operator=(const Leaderboard&) = delete;
+
+    /**
+     * @brief Builds a record stamped with the current time.
+     * @param player2 Empty in single player.
+     */
+    static MatchRecord makeRecord(GameMode mode, const std::string& player1, int score1,
+                                  const std::string& player2, int score2, float seconds);
+
+    /** @brief Queues a finished match; never waits for the disk. */
+    void submit(const MatchRecord& record);
+
+    /** @brief Blocks until every queued record has been written (tools, shutdown). */
+    void flush();
+
+    /** @brief Best score of @p player in @p mode, or 0 if they have none. */
+    int best(GameMode mode, const std::string& player) const;
+
+    /** @brief Top scores of a mode, best first. */
+    std::vector<LeaderboardEntry> top(GameMode mode) const;
+
+    /** @brief Up to @p count most recent matches, newest first. */
+    std::vector<MatchRecord> recent(std::size_t count) const;
+
+    /** @brief Load and compaction figures. */
+    LeaderboardStats stats() const;
+
+    /** @brief Whether the initial scan has finished; takes no lock, so a frame may ask. */
+    bool loaded() const { return m_Loaded.load(std::memory_order_acquire); }
+
+    /** @brief False if the log could not be opened or written; the index then stays in memory only. */
+    bool healthy() const;
+
+private:
+    static constexpr int ModeCount = 3;
+
+    /** @brief Index key: a mode and a player. */
+    using BestKey = std::pair<std::uint8_t, std::string>;
+
+    /** @brief What the game can query without touching the file. */
+    struct Index {
+        std::vector<LeaderboardEntry> top[ModeCount]; ///< Best first; ties keep the older entry first
+        std::map<BestKey, int> best;
+        std::deque<MatchRecord> history;              ///< Oldest first, at most HistoryKeep
+
+        void add(const MatchRecord& record);
+    };
+
+    void run();
+    bool load();
+    bool append(const std::vector<MatchRecord>& records);
+    bool compact();
+
+    std::string m_Path;
+    std::FILE* m_File = nullptr;      ///< Append handle (writer thread only)
+    std::uint32_t m_Sequence = 0;     ///< Sequence number of the next record (writer thread only)
+    std::uint64_t m_SinceCompact = 0; ///< Records not yet through a compaction; all of them after a load (writer thread only)
+
+    std::mutex m_QueueMutex;
+    std::condition_variable m_QueueReady;
+    std::condition_variable m_QueueDrained;
+    std::vector<MatchRecord> m_Queue;
+    bool m_Busy = true; ///< The writer is loading or writing records taken from the queue
+    bool m_Stop = false;
+
+    mutable std::mutex m_IndexMutex;
+    Index m_Index;
+    LeaderboardStats m_Stats;
+    bool m_Healthy = true;
+    std::atomic<bool> m_Loaded{false};
+
+    std::thread m_Writer;
+};
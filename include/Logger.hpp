@@ -1,47 +1,254 @@
 /**
  * @file Logger.hpp
- * @brief Minimal logging utility to write debug and error information to a log file.
+ * @brief Asynchronous logging utility writing debug and error information to a log file.
  * @author Oussama Amara
  * @date 2025-07-27
  */
 
 #pragma once
-#include <iostream>
-#include <fstream>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
 #include <string>
-#include <ctime>
+#include <thread>
+#include <type_traits>
 
+/**
+ * @brief Severity of a log entry, ordered from most to least verbose.
+ */
+enum class LogLevel : int { Trace = 0, Debug = 1, Info = 2, Error = 3, Off = 4 };
+
+/**
+ * @brief Minimum level compiled into the binary (0 = Trace ... 4 = Off).
+ * Override with -DPONG_LOG_LEVEL=0 to keep the per-tick trace lines in a build.
+ */
+#ifndef PONG_LOG_LEVEL
+#define PONG_LOG_LEVEL 2
+#endif
+
+/**
+ * @brief Emits a log entry when @p level passes both the compile-time and runtime filters.
+ * Arguments are not evaluated when the entry is filtered out.
+ */
+#define PONG_LOG(level, ...)                                                     \
+    do {                                                                         \
+        if constexpr (static_cast<int>(level) >= PONG_LOG_LEVEL) {               \
+            Logger& pongLogger_ = Logger::instance();                            \
+            if (pongLogger_.enabled(level))                                      \
+                pongLogger_.log(level, __VA_ARGS__);                             \
+        }                                                                        \
+    } while (0)
+
+#define LOG_TRACE(...) PONG_LOG(LogLevel::Trace, __VA_ARGS__)
+#define LOG_DEBUG(...) PONG_LOG(LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO(...)  PONG_LOG(LogLevel::Info, __VA_ARGS__)
+#define LOG_ERROR(...) PONG_LOG(LogLevel::Error, __VA_ARGS__)
+
+/**
+ * @class Logger
+ * @brief Long-lived logger with a lock-free MPSC ring buffer and a background writer thread.
+ *
+ * A call only captures its raw arguments into a fixed-size record and pushes it onto the
+ * ring; timestamp formatting, placeholder substitution and file/console I/O all happen on
+ * the writer thread. The format string must be a string literal; every "{}" in it is replaced by the next
+ * argument. Integers, floating-point values and strings are supported. String arguments
+ * are copied into the record, so callers may pass temporaries.
+ */
 class Logger {
 public:
-    Logger(const std::string& filename = "game.log") {
-        logFile.open(filename, std::ios::app);
-    }
+    /** @brief Maximum number of arguments captured per entry. */
+    static constexpr std::size_t MaxArgs = 6;
+
+    /** @brief Bytes reserved per entry for copied string arguments. */
+    static constexpr std::size_t StringBytes = 96;
+
+    /** @brief Number of records in the ring buffer (power of two). */
+    static constexpr std::size_t Capacity = 8192;
 
-    ~Logger() {
-        if (logFile.is_open())
-            logFile.close();
+    /**
+     * @brief Starts the writer thread.
+     * @param filename Path of the log file, opened in append mode when the first entry is written.
+     */
+    explicit Logger(const std::string& filename = "game.log");
+
+    /**
+     * @brief Drains all pending entries, stops the writer thread and closes the file.
+     */
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    /**
+     * @brief Returns the process-wide logger writing to game.log.
+     * The runtime level is taken from the PONG_LOG_LEVEL environment variable
+     * (trace, debug, info, error or off) when it is set.
+     */
+    static Logger& instance();
+
+    /** @brief Checks whether entries of the given level are currently accepted. */
+    bool enabled(LogLevel level) const {
+        return static_cast<int>(level) >= m_Level.load(std::memory_order_relaxed);
     }
 
-    void info(const std::string& message) {
-        log("[INFO] " + message);
+    /** @brief Changes the runtime level threshold. */
+    void setLevel(LogLevel level) { m_Level.store(static_cast<int>(level), std::memory_order_relaxed); }
+
+    /** @brief Enables or disables echoing entries to stdout (enabled by default). */
+    void setConsoleEcho(bool enabled) { m_ConsoleEcho.store(enabled, std::memory_order_relaxed); }
+
+    /**
+     * @brief Configures size-based rotation of the log file. Rotated files are compressed
+     * into game.log.1.lz ... game.log.N.lz by a separate compressor thread.
+     * @param maxBytes Size at which the current file is rotated (0 disables rotation).
+     * @param generations Number of compressed generations kept (game.log.1.lz is the newest).
+     */
+    void setRotation(std::size_t maxBytes, unsigned generations) {
+        m_Generations.store(generations, std::memory_order_relaxed);
+        m_MaxBytes.store(maxBytes, std::memory_order_relaxed);
     }
 
-    void error(const std::string& message) {
-        log("[ERROR] " + message);
+    /** @brief Number of entries discarded because the ring buffer was full. */
+    std::uint64_t droppedCount() const { return m_Dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Blocks until every entry pushed so far has been written out.
+     */
+    void flush();
+
+    /**
+     * @brief Captures an entry and queues it for the writer thread. Never blocks or allocates.
+     * @param level Severity of the entry.
+     * @param fmt Format string literal with "{}" placeholders.
+     * @param args Values substituted into the placeholders.
+     */
+    template <typename... Args>
+    void log(LogLevel level, const char* fmt, const Args&... args) {
+        static_assert(sizeof...(Args) <= MaxArgs, "Too many log arguments");
+        Slot* slot = acquire();
+        if (!slot) {
+            m_Dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        Record& rec = slot->record;
+        rec.timestamp = std::chrono::system_clock::now().time_since_epoch().count();
+        rec.level = level;
+        rec.format = fmt;
+        rec.argCount = 0;
+        rec.stringUsed = 0;
+        (capture(rec, args), ...);
+        publish(slot);
     }
 
+    /** @brief Convenience wrapper kept for call sites that log a plain message. */
+    void info(const std::string& message) { log(LogLevel::Info, "{}", message); }
+
+    /** @brief Convenience wrapper kept for call sites that log a plain message. */
+    void error(const std::string& message) { log(LogLevel::Error, "{}", message); }
+
 private:
-    std::ofstream logFile;
+    /** @brief A single captured argument. */
+    struct Arg {
+        enum class Type : std::uint8_t { Int, UInt, Float, String } type;
+        union {
+            long long i;
+            unsigned long long u;
+            double f;
+            struct { std::uint16_t offset, length; } s;
+        };
+    };
 
-    void log(const std::string& entry) {
-        std::time_t now = std::time(nullptr);
-        char buf[64];
-        std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", std::localtime(&now));
+    /** @brief Raw, unformatted log entry. */
+    struct Record {
+        std::int64_t timestamp;
+        LogLevel level;
+        const char* format;
+        std::uint8_t argCount;
+        std::uint16_t stringUsed;
+        Arg args[MaxArgs];
+        char strings[StringBytes];
+    };
 
-        std::string finalEntry = "[" + std::string(buf) + "] " + entry;
-        if (logFile.is_open())
-            logFile << finalEntry << std::endl;
+    /** @brief Ring buffer cell; the sequence number implements the Vyukov bounded queue. */
+    struct alignas(64) Slot {
+        std::atomic<std::size_t> sequence;
+        Record record;
+    };
 
-        std::cout << finalEntry << std::endl;
+    Slot* acquire();
+    void publish(Slot* slot);
+    void run();
+    void drain();
+    void write(const Record& rec);
+    static std::size_t format(const Record& rec, char* out, std::size_t size);
+    void openFile();
+    void rotate();
+    void runCompressor();
+    void compressRotated(const std::string& rotated);
+
+    template <typename T>
+    static void capture(Record& rec, const T& value) {
+        Arg& arg = rec.args[rec.argCount++];
+        if constexpr (std::is_same_v<T, bool>) {
+            arg.type = Arg::Type::String;
+            copyString(rec, arg, value ? "true" : "false", value ? 4 : 5);
+        } else if constexpr (std::is_enum_v<T>) {
+            arg.type = Arg::Type::Int;
+            arg.i = static_cast<long long>(value);
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            arg.type = Arg::Type::Int;
+            arg.i = value;
+        } else if constexpr (std::is_integral_v<T>) {
+            arg.type = Arg::Type::UInt;
+            arg.u = value;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            arg.type = Arg::Type::Float;
+            arg.f = value;
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            arg.type = Arg::Type::String;
+            copyString(rec, arg, value.data(), value.size());
+        } else {
+            const char* str = value;
+            arg.type = Arg::Type::String;
+            copyString(rec, arg, str, std::char_traits<char>::length(str));
+        }
     }
+
+    static void copyString(Record& rec, Arg& arg, const char* str, std::size_t length) {
+        std::size_t room = StringBytes - rec.stringUsed;
+        if (length > room) length = room;
+        std::char_traits<char>::copy(rec.strings + rec.stringUsed, str, length);
+        arg.s.offset = rec.stringUsed;
+        arg.s.length = static_cast<std::uint16_t>(length);
+        rec.stringUsed = static_cast<std::uint16_t>(rec.stringUsed + length);
+    }
+
+    Slot* m_Slots;
+    alignas(64) std::atomic<std::size_t> m_Head{0};
+    alignas(64) std::size_t m_Tail = 0;
+    std::atomic<std::size_t> m_Written{0};
+    std::atomic<std::size_t> m_Published{0};
+    std::atomic<int> m_Level{static_cast<int>(LogLevel::Info)};
+    std::atomic<bool> m_ConsoleEcho{true};
+    std::atomic<bool> m_Running{true};
+    std::atomic<std::uint64_t> m_Dropped{0};
+    std::atomic<std::size_t> m_MaxBytes{0};
+    std::atomic<unsigned> m_Generations{5};
+    std::string m_Filename;
+    std::FILE* m_File = nullptr;
+    bool m_Opened = false; ///< The file was opened (or failed to) by the first write
+    std::size_t m_FileSize = 0;
+    unsigned m_RotationCount = 0;
+    std::thread m_Writer;
+
+    std::thread m_Compressor;
+    std::mutex m_CompressMutex;
+    std::condition_variable m_CompressReady;
+    std::deque<std::string> m_Pending;
+    bool m_CompressorStop = false;
 };
@@ -0,0 +1,49 @@
+/**
+ * @file Lz.hpp
+ * @brief Small self-contained LZ77 codec (LZ4-style sequences) used to compress rotated logs.
+ * @author Oussama Amara
+ * @date 2025-08-12
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lz {
+
+/**
+ * @brief Compresses a buffer.
+ * The stream is a series of sequences: a token byte (high nibble literal count, low nibble
+ * match length - 4, 15 meaning "extended by following 255-run bytes"), the literals, a
+ * 16-bit little-endian match offset and the match length extension. The final sequence
+ * carries literals only.
+ * @param data Input bytes.
+ * @param size Number of input bytes.
+ * @return Compressed stream (without file header).
+ */
+std::vector<std::uint8_t> compress(const std::uint8_t* data, std::size_t size);
+
+/**
+ * @brief Decompresses a stream produced by compress().
+ * @param data Compressed bytes.
+ * @param size Number of compressed bytes.
+ * @param out Receives the decoded bytes (appended).
+ * @return false if the stream is malformed.
+ */
+bool decompress(const std::uint8_t* data, std::size_t size, std::vector<std::uint8_t>& out);
+
+/**
+ * @brief Compresses a whole file into a container: "PLZ1", the 64-bit raw size, then the stream.
+ * @return true on success.
+ */
+bool compressFile(const std::string& source, const std::string& destination);
+
+/**
+ * @brief Restores a file written by compressFile().
+ * @return true on success.
+ */
+bool decompressFile(const std::string& source, const std::string& destination);
+
+} // namespace lz
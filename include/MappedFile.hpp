@@ -0,0 +1,76 @@
+/**
+ * @file MappedFile.hpp
+ * @brief Thin cross-platform wrapper around a memory-mapped file (POSIX mmap / Win32 file mapping).
+ * @author Oussama Amara
+ * @date 2025-08-10
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief Maps a whole file into memory for reading or writing.
+ * Read-write mappings can be grown with resize(), which remaps the file; pointers
+ * obtained from data() are invalidated by resize() and close().
+ */
+class MappedFile {
+public:
+    /** @brief Access mode of the mapping. */
+    enum class Mode { ReadOnly, ReadWrite };
+
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Opens and maps a file.
+     * @param path File to map.
+     * @param mode ReadOnly maps an existing file; ReadWrite creates it if needed.
+     * @param size For ReadWrite, the size the file is set to before mapping (0 keeps its size).
+     * @return true on success.
+     */
+    bool open(const std::string& path, Mode mode, std::size_t size = 0);
+
+    /**
+     * @brief Changes the file size and remaps it (ReadWrite only).
+     * @return true on success.
+     */
+    bool resize(std::size_t size);
+
+    /** @brief Asks the OS to write dirty pages back without waiting for completion. */
+    void sync();
+
+    /** @brief Unmaps and closes the file. */
+    void close();
+
+    /** @brief Checks whether a file is currently mapped. */
+    bool isOpen() const { return m_Handle != InvalidHandle; }
+
+    /** @brief Start of the mapping, or nullptr for an empty file. */
+    std::uint8_t* data() { return m_Data; }
+
+    /** @brief Start of the mapping, or nullptr for an empty file. */
+    const std::uint8_t* data() const { return m_Data; }
+
+    /** @brief Size of the mapping in bytes. */
+    std::size_t size() const { return m_Size; }
+
+private:
+    bool map();
+    void unmap();
+
+    static constexpr std::intptr_t InvalidHandle = -1;
+
+    std::uint8_t* m_Data = nullptr;
+    std::size_t m_Size = 0;
+    Mode m_Mode = Mode::ReadOnly;
+    std::intptr_t m_Handle = InvalidHandle;
+    std::intptr_t m_Mapping = 0;
+};
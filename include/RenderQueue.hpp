@@ -0,0 +1,163 @@
+/**
+ * @file RenderQueue.hpp
+ * @brief Per-frame render command buffer and the backends it submits to.
+ * @author Oussama Amara
+ * @date 2025-09-03
+ */
+
+#pragma once
+#include "Collision.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/** @brief Drawing order of a command; later layers are painted over earlier ones. */
+enum class RenderLayer : std::uint8_t { Background, Gameplay, Hud, Overlay };
+
+/** @brief A solid rectangle; the colour is 0xRRGGBBAA, as sf::Color::toInteger(). */
+struct RenderQuad {
+    Aabb rect;
+    std::uint32_t color;
+};
+
+/** @brief Texture state of untextured quads and meshes; text uses its font's state. */
+inline constexpr std::uint32_t UntexturedState = 0;
+
+/**
+ * @brief Receives the sorted, merged commands of a frame.
+ * Vertex counts assume two triangles per quad or glyph.
+ */
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    /** @brief Clears the target to a colour (0xRRGGBBAA). */
+    virtual void clear(std::uint32_t color) = 0;
+
+    /** @brief Switches the texture state; called only when the next draw needs a different one. */
+    virtual void bindState(std::uint32_t state) = 0;
+
+    /** @brief Draws solid rectangles in order, in one call. */
+    virtual void drawQuads(const RenderQuad* quads, std::size_t count) = 0;
+
+    /** @brief Draws a text the backend knows by handle. */
+    virtual void drawText(std::uint32_t handle, std::size_t vertices) = 0;
+
+    /** @brief Draws a prebuilt vertex array the backend knows by handle. */
+    virtual void drawMesh(std::uint32_t handle, std::size_t vertices) = 0;
+};
+
+/** @brief Discards every command. */
+class NullRenderBackend final : public RenderBackend {
+public:
+    void clear(std::uint32_t) override {}
+    void bindState(std::uint32_t) override {}
+    void drawQuads(const RenderQuad*, std::size_t) override {}
+    void drawText(std::uint32_t, std::size_t) override {}
+    void drawMesh(std::uint32_t, std::size_t) override {}
+};
+
+/** @brief What a backend was asked to do. */
+struct RenderStats {
+    std::size_t clears = 0;
+    std::size_t drawCalls = 0;
+    std::size_t stateChanges = 0;
+    std::size_t vertices = 0;
+};
+
+/** @brief Counts calls instead of drawing; reset() between frames to count one frame. */
+class CountingRenderBackend final : public RenderBackend {
+public:
+    void clear(std::uint32_t) override { ++m_Stats.clears; }
+    void bindState(std::uint32_t) override { ++m_Stats.stateChanges; }
+    void drawQuads(const RenderQuad*, std::size_t count) override { draw(count * 6); }
+    void drawText(std::uint32_t, std::size_t vertices) override { draw(vertices); }
+    void drawMesh(std::uint32_t, std::size_t vertices) override { draw(vertices); }
+
+    const RenderStats& stats() const { return m_Stats; }
+    void reset() { m_Stats = RenderStats{}; }
+
+private:
+    void draw(std::size_t vertices) {
+        ++m_Stats.drawCalls;
+        m_Stats.vertices += vertices;
+    }
+
+    RenderStats m_Stats;
+};
+
+/**
+ * @class RenderQueue
+ * @brief Records one frame of commands, then sorts, merges and submits them.
+ */
+class RenderQueue {
+public:
+    /** @brief Opaque black, what window.clear() uses. */
+    static constexpr std::uint32_t Black = 0x000000ff;
+    static constexpr std::uint32_t White = 0xffffffff;
+
+    /** @brief Records a clear; it is issued before everything else. */
+    void clear(std::uint32_t color = Black);
+
+    /**
+     * @brief Records one rectangle. Consecutive quads in the same layer extend one command.
+     */
+    void quad(const Aabb& rect, std::uint32_t color = White, RenderLayer layer = RenderLayer::Gameplay);
+
+    /** @brief Records rectangles of one colour as a single command. */
+    void quads(const std::vector<Aabb>& rects, std::uint32_t color = White, RenderLayer layer = RenderLayer::Gameplay);
+
+    /**
+     * @brief Records a text the backend knows by handle.
+     * @param font Font the text uses; texts sharing a font are drawn together.
+     * @param vertices Vertices it takes, see glyphVertices().
+     */
+    void text(std::uint32_t handle, std::uint32_t font, std::size_t vertices, RenderLayer layer = RenderLayer::Hud);
+
+    /** @brief Records a prebuilt vertex array the backend knows by handle. */
+    void mesh(std::uint32_t handle, std::size_t vertices, RenderLayer layer = RenderLayer::Gameplay);
+
+    /**
+     * @brief Sorts and merges the recorded commands, issues them and empties the queue.
+     * Layers are drawn in order; inside a layer, commands are grouped by state (untextured
+     * quads and meshes first, then text per font) and otherwise keep their recording order,
+     * so a layer must not rely on text and quads overlapping in a given order. Quad commands
+     * that end up next to each other, in one layer or across two, become one draw call.
+     */
+    void submit(RenderBackend& backend);
+
+    /** @brief Commands recorded since the last submit. */
+    std::size_t size() const { return m_Commands.size(); }
+
+    /** @brief Commands the last submit received and draw calls it saved by merging. */
+    std::size_t lastCommands() const { return m_LastCommands; }
+    std::size_t lastMerged() const { return m_LastMerged; }
+
+    /** @brief Vertices of a text: two triangles per visible character. */
+    static std::size_t glyphVertices(std::string_view text);
+
+private:
+    enum class Kind : std::uint8_t { Clear, Quads, Text, Mesh };
+
+    /** @brief One recorded command; key orders by layer, then state, then recording order. */
+    struct Command {
+        std::uint64_t key;
+        Kind kind;
+        RenderLayer layer;
+        std::uint32_t state;
+        std::uint32_t handle;   ///< Text or mesh handle
+        std::uint32_t first;    ///< Quads: first index in m_Quads
+        std::uint32_t count;    ///< Quads: rectangles; text and mesh: vertices
+    };
+
+    void record(Kind kind, RenderLayer layer, std::uint32_t state, std::uint32_t handle, std::uint32_t first,
+                std::uint32_t count);
+
+    std::vector<Command> m_Commands;
+    std::vector<RenderQuad> m_Quads;
+    /** @brief Merged quad runs whose rectangles were not recorded contiguously. */
+    std::vector<RenderQuad> m_Scratch;
+    std::size_t m_LastCommands = 0;
+    std::size_t m_LastMerged = 0;
+};
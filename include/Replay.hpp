@@ -0,0 +1,225 @@
+/**
+ * @file Replay.hpp
+ * @brief Deterministic match recording: per-tick inputs plus periodic state snapshots.
+ * @author Oussama Amara
+ * @date 2025-08-25
+ */
+
+#pragma once
+#include "GameSimulation.hpp"
+#include "MappedFile.hpp"
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Header at the start of every replay file.
+ */
+struct ReplayHeader {
+    char magic[4];                  ///< "PRPL"
+    std::uint16_t version;          ///< Format version, currently 1
+    std::uint16_t stateSize;        ///< Replay::StateSize of the writer
+    float width;                    ///< Field width in pixels
+    float height;                   ///< Field height in pixels
+    float dt;                       ///< Tick length in seconds, exactly as passed to step()
+    std::uint32_t snapshotInterval; ///< Ticks between two snapshots
+};
+
+static_assert(sizeof(ReplayHeader) == 24, "ReplayHeader layout is part of the file format");
+
+namespace Replay {
+
+/**
+ * @brief Record tags following the header.
+ * Values are part of the file format: append new records, never renumber.
+ */
+enum class Record : std::uint8_t {
+    Input    = 1, ///< varint tick count, then one byte of InputBits held for all of them
+    Command  = 2, ///< one byte: GameMode to switch to before the next tick
+    Snapshot = 3, ///< varint tick, varint byte count, then the XOR/RLE-encoded state
+    End      = 4  ///< varint total ticks; missing if the recording was cut short
+};
+
+/** @brief Key bits of an Input record. */
+enum InputBits : std::uint8_t {
+    Player1Left  = 1u << 0,
+    Player1Right = 1u << 1,
+    Player2Left  = 1u << 2,
+    Player2Right = 1u << 3
+};
+
+/** @brief Ticks between two snapshots (one second at the default tick rate). */
+constexpr std::uint32_t SnapshotInterval = 240;
+
+/** @brief Bytes of a packed MatchState. */
+constexpr std::size_t StateSize = 1 + Ball::PackedSize + 2 * Bat::PackedSize + 5 * sizeof(int) +
+                                  sizeof(float) + sizeof(std::uint32_t);
+
+/** @brief A packed MatchState. */
+using PackedState = std::array<std::uint8_t, StateSize>;
+
+/**
+ * @brief Writes every field of the state without padding, so equal states pack to equal bytes.
+ */
+void packState(const MatchState& state, PackedState& out);
+
+/** @brief Restores a state written by packState(). */
+void unpackState(const PackedState& in, MatchState& state);
+
+/** @brief Key bits of a tick's input. */
+std::uint8_t encodeInput(const TickInput& input);
+
+/** @brief Input described by key bits. */
+TickInput decodeInput(std::uint8_t bits);
+
+/**
+ * @class Recorder
+ * @brief Appends a match to a replay file. Does nothing until open() succeeds.
+ * GameSimulation is a pure function of its state, the inputs and dt, so the starting
+ * state, the keys held every tick and the mode changes describe a match completely.
+ * Each snapshot is XORed against the previous one before run-length encoding, and the
+ * file is flushed at every snapshot so a crash leaves a playable prefix.
+ */
+class Recorder {
+public:
+    Recorder() = default;
+    ~Recorder();
+
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+
+    /**
+     * @brief Creates (or truncates) a replay file and snapshots the starting state.
+     * @param dt Tick length that will be passed to every step().
+     * @return true on success.
+     */
+    bool open(const std::string& path, const GameSimulation& sim, float dt);
+
+    /** @brief Writes the end record and closes the file. */
+    void close();
+
+    bool isOpen() const { return m_File != nullptr; }
+
+    /** @brief Records a mode change made between two ticks (start() or returnToMenu()). */
+    void command(GameMode mode);
+
+    /**
+     * @brief Records one step() call.
+     * @param input Input passed to step().
+     * @param sim Simulation after the step, snapshotted every SnapshotInterval ticks.
+     */
+    void tick(const TickInput& input, const GameSimulation& sim);
+
+    /** @brief Ticks recorded so far. */
+    std::uint32_t ticks() const { return m_Ticks; }
+
+private:
+    void flushRun();
+    void snapshot(const GameSimulation& sim);
+    void writeVarint(std::uint64_t value);
+
+    std::FILE* m_File = nullptr;
+    std::uint32_t m_Ticks = 0;
+    std::uint8_t m_RunBits = 0;
+    std::uint32_t m_RunLength = 0;
+    PackedState m_Previous{};          ///< Last snapshot, the base of the next delta
+    std::vector<std::uint8_t> m_Scratch;
+};
+
+/**
+ * @class Player
+ * @brief Plays back a replay file into a GameSimulation, with seeking and verification.
+ */
+class Player {
+public:
+    /**
+     * @brief Maps and indexes a replay file.
+     * @return false if the file is missing, not a replay, or was written for another state layout.
+     */
+    bool open(const std::string& path);
+
+    /** @brief Field size the match was recorded on; the simulation must be built with it. */
+    Vec2 resolution() const { return Vec2{m_Header.width, m_Header.height}; }
+
+    /** @brief Tick length the match was recorded with. */
+    float dt() const { return m_Header.dt; }
+
+    /** @brief Ticks in the recording. */
+    std::uint32_t ticks() const { return m_Ticks; }
+
+    /** @brief Tick the next advance() plays. */
+    std::uint32_t position() const { return m_Position; }
+
+    /** @brief Snapshots in the recording. */
+    std::size_t snapshotCount() const { return m_Snapshots.size(); }
+
+    /** @brief Mode changes in the recording. */
+    std::size_t commandCount() const { return m_Commands.size(); }
+
+    /** @brief Input runs in the recording. */
+    std::size_t runCount() const { return m_Runs.size(); }
+
+    /** @brief Size of the mapped file in bytes. */
+    std::size_t fileSize() const { return m_File.size(); }
+
+    /**
+     * @brief Puts the simulation in the state it had before tick @p tick (clamped to ticks()).
+     * Restores the nearest snapshot and re-simulates from there.
+     */
+    void seek(GameSimulation& sim, std::uint32_t tick);
+
+    /**
+     * @brief Plays the tick at position(): pending mode changes, then one step().
+     * @return false, without stepping, once every tick was played.
+     */
+    bool advance(GameSimulation& sim);
+
+    /** @brief Input recorded for a tick. */
+    TickInput inputAt(std::uint32_t tick) const;
+
+    /**
+     * @brief State recorded by a snapshot at exactly @p tick.
+     * @return false if no snapshot was taken at that tick.
+     */
+    bool snapshotAt(std::uint32_t tick, MatchState& state) const;
+
+    /**
+     * @brief Re-simulates the whole match and compares it with every snapshot.
+     * @param divergentTick Set to the tick of the first snapshot that differs.
+     * @return true if every snapshot matched bit for bit. On a mismatch the simulation is
+     * left at the divergent tick.
+     */
+    bool verify(GameSimulation& sim, std::uint32_t& divergentTick);
+
+private:
+    /** @brief Ticks from @c start on use the same keys until the next run. */
+    struct InputRun {
+        std::uint32_t start;
+        std::uint8_t bits;
+    };
+    struct Command {
+        std::uint32_t tick;
+        GameMode mode;
+    };
+    struct Snapshot {
+        std::uint32_t tick;
+        PackedState state;
+    };
+
+    bool index();
+    std::size_t runAt(std::uint32_t tick) const;
+
+    MappedFile m_File;
+    ReplayHeader m_Header{};
+    std::vector<InputRun> m_Runs;
+    std::vector<Command> m_Commands;
+    std::vector<Snapshot> m_Snapshots;
+    std::uint32_t m_Ticks = 0;
+    std::uint32_t m_Position = 0;
+    std::size_t m_NextRun = 0;     ///< Run of the last tick played
+    std::size_t m_NextCommand = 0; ///< First command not applied yet
+};
+
+} // namespace Replay
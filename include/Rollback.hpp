@@ -0,0 +1,174 @@
+/**
+ * @file Rollback.hpp
+ * @brief Rollback netcode for two-player matches: each peer plays its own bat without input delay.
+ * @author Oussama Amara
+ * @date 2025-08-26
+ */
+
+#pragma once
+#include "GameSimulation.hpp"
+#include "UdpSocket.hpp"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Header of every rollback packet; the input bytes of firstFrame onwards follow it.
+ * Values and layout are part of the wire format.
+ */
+struct NetPacketHeader {
+    std::uint16_t magic;      ///< 0x4E50 ("PN")
+    std::uint8_t version;     ///< Protocol version, currently 1
+    std::uint8_t count;       ///< Input bytes after the header
+    std::uint32_t config;     ///< Tag of the field size and tick length; mismatching packets are ignored
+    std::uint32_t firstFrame; ///< Tick of the first input byte
+    std::uint32_t ack;        ///< Remote inputs received so far: every tick below is known
+};
+
+static_assert(sizeof(NetPacketHeader) == 16, "NetPacketHeader layout is part of the wire format");
+
+/**
+ * @class NetTransport
+ * @brief Unreliable datagram link to the other peer.
+ */
+class NetTransport {
+public:
+    virtual ~NetTransport() = default;
+
+    /** @brief Sends one datagram; it may be lost, delayed or reordered. */
+    virtual void send(const std::uint8_t* data, std::size_t size) = 0;
+
+    /**
+     * @brief Takes the next datagram that arrived, without blocking.
+     * @return false if none is waiting.
+     */
+    virtual bool receive(std::vector<std::uint8_t>& packet) = 0;
+};
+
+/**
+ * @class UdpTransport
+ * @brief NetTransport over a UdpSocket. A host learns its peer from the first datagram.
+ */
+class UdpTransport : public NetTransport {
+public:
+    /**
+     * @brief Binds a local port and optionally sets the peer.
+     * @param localPort Port to listen on, 0 for any.
+     * @param peer Address of the host, or nullptr to wait for a peer to connect.
+     */
+    bool open(std::uint16_t localPort, const NetAddress* peer = nullptr);
+
+    void send(const std::uint8_t* data, std::size_t size) override;
+    bool receive(std::vector<std::uint8_t>& packet) override;
+
+    std::uint16_t localPort() const { return m_Socket.localPort(); }
+
+private:
+    UdpSocket m_Socket;
+    NetAddress m_Peer;
+    bool m_HasPeer = false;
+};
+
+/**
+ * @brief Counters kept by a RollbackSession.
+ */
+struct RollbackStats {
+    std::uint64_t ticks = 0;             ///< Ticks advanced
+    std::uint64_t stalls = 0;            ///< advance() calls that waited for the peer
+    std::uint64_t rollbacks = 0;         ///< Mispredictions corrected
+    std::uint64_t resimulatedTicks = 0;  ///< Ticks simulated again by rollbacks
+    std::uint32_t maxDepth = 0;          ///< Deepest rollback, in ticks
+    std::uint32_t lastDepth = 0;         ///< Ticks re-simulated by the last advance()
+    std::uint64_t lastResimNs = 0;       ///< Time spent re-simulating in the last advance()
+    std::uint64_t totalResimNs = 0;      ///< Time spent re-simulating overall
+    std::uint64_t packetsSent = 0;
+    std::uint64_t packetsReceived = 0;
+    std::uint64_t packetsRejected = 0;   ///< Malformed, foreign or from another configuration
+};
+
+/**
+ * @class RollbackSession
+ * @brief Drives a GameSimulation from local input plus predicted and corrected remote input.
+ * The remote input is predicted to repeat the last one received. When the real input of
+ * a past tick differs, the state saved before that tick is restored and the ticks up to
+ * the present are simulated again, so the local bat never lags and the remote one snaps
+ * to the truth as soon as it is known. Matches use multiplayer rules and restart at once.
+ */
+class RollbackSession {
+public:
+    /** @brief Ticks the session may run ahead of the confirmed remote input before stalling. */
+    static constexpr std::uint32_t MaxRollback = 48;
+
+    /** @brief Saved states and inputs; a power of two larger than any unacknowledged span. */
+    static constexpr std::uint32_t HistorySize = 256;
+
+    /**
+     * @brief Most inputs in one packet. Every unacknowledged input is resent, so a lost
+     * datagram is repaired by the next one.
+     */
+    static constexpr std::uint32_t MaxPacketInputs = 128;
+
+    /** @brief Field both peers play on, whatever the size of their screens. */
+    static constexpr float FieldWidth = 1280.f;
+    static constexpr float FieldHeight = 720.f;
+
+    /** @brief Result of advance(). */
+    enum class Status { Waiting, Advanced, Stalled };
+
+    /**
+     * @param sim Simulation to drive; both peers must build it with the same field size.
+     * @param localPlayer 0 for the bottom bat (the host), 1 for the top bat.
+     * @param transport Link to the other peer.
+     * @param dt Tick length, identical on both peers.
+     */
+    RollbackSession(GameSimulation& sim, int localPlayer, NetTransport& transport, float dt);
+
+    /**
+     * @brief Reads incoming packets, corrects mispredicted ticks and plays one new tick.
+     * @return Waiting until the peer was heard from, Stalled while too far ahead of it.
+     */
+    Status advance(const PlayerInput& local);
+
+    /** @brief Ticks played so far. */
+    std::uint32_t frame() const { return m_Frame; }
+
+    /** @brief Remote inputs are known for every tick below this one. */
+    std::uint32_t confirmedFrame() const { return m_RemoteConfirmed; }
+
+    /** @brief Whether a packet from the peer has arrived. */
+    bool connected() const { return m_Connected; }
+
+    const RollbackStats& stats() const { return m_Stats; }
+
+    /**
+     * @brief State before a tick, while it is still in the history.
+     * The state before a tick at or below confirmedFrame() is final on both peers.
+     * @return nullptr if the tick is in the future or too old.
+     */
+    const MatchState* savedState(std::uint32_t frame) const;
+
+private:
+    void receive();
+    void resimulate(std::uint32_t from);
+    void simulate(std::uint32_t frame);
+    void send();
+    std::uint8_t predictedRemote() const;
+
+    GameSimulation& m_Sim;
+    NetTransport& m_Transport;
+    int m_Local;
+    float m_Dt;
+    std::uint32_t m_Config;
+
+    std::uint32_t m_Frame = 0;           ///< Next tick to play
+    std::uint32_t m_RemoteConfirmed = 0; ///< Remote inputs received for ticks below this
+    std::uint32_t m_PeerAck = 0;         ///< Local inputs the peer has acknowledged
+    std::uint32_t m_Mispredicted;        ///< Earliest tick whose prediction was wrong, or ~0
+    bool m_Connected = false;
+
+    std::vector<MatchState> m_States;       ///< State before each tick, by tick % HistorySize
+    std::vector<std::uint8_t> m_LocalInput; ///< Two bits per tick: left, right
+    std::vector<std::uint8_t> m_RemoteInput;
+    std::vector<std::uint8_t> m_Packet;     ///< Outgoing datagram
+    std::vector<std::uint8_t> m_Received;   ///< Incoming datagram
+    RollbackStats m_Stats;
+};
@@ -0,0 +1,65 @@
+/**
+ * @file SceneRecorder.hpp
+ * @brief Records the game's screens into a RenderQueue.
+ * @author Oussama Amara
+ * @date 2025-09-03
+ */
+
+#pragma once
+#include "ChaosSimulation.hpp"
+#include "GameSimulation.hpp"
+#include "Hud.hpp"
+#include "RenderQueue.hpp"
+#include <array>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Texts and meshes the screens refer to by handle; the backend maps them to drawables.
+ */
+enum SceneResource : std::uint32_t { MenuTextResource, StatsTextResource, ProfilerTextResource, StressBoxesResource,
+                                     SceneResourceCount };
+
+/** @brief The only font the game loads. */
+inline constexpr std::uint32_t GameFont = 0;
+
+/**
+ * @class SceneRecorder
+ * @brief Records menu, single-player, multiplayer and multi-ball frames.
+ * This is what DisplayManager draws, minus the window, so the same frames can be measured
+ * headless with a CountingRenderBackend (pongbench --render-stats). Each screen records
+ * its layers bottom to top, so the sorted gameplay and HUD quads stay contiguous and go
+ * out as one draw call without being copied.
+ */
+class SceneRecorder {
+public:
+    explicit SceneRecorder(Vec2 resolution) : m_Resolution(resolution) {}
+
+    /** @brief Clear and the menu text. */
+    void recordMenu(RenderQueue& queue);
+
+    /** @brief Clear, HUD, bat and ball; arguments as in DisplayManager. */
+    void recordSingleplayer(RenderQueue& queue, const Bat& bat, const Ball& ball, int score, int lives, int highScore,
+                            float alpha = 1.f);
+
+    /** @brief Clear, both HUD lines, both bats and the ball. */
+    void recordMultiplayer(RenderQueue& queue, const Bat& bat1, const Bat& bat2, const Ball& ball, int score1,
+                           int lives1, int score2, int lives2, float alpha = 1.f);
+
+    /** @brief Clear, both scores, both bats and every ball. */
+    void recordChaos(RenderQueue& queue, const ChaosSimulation& chaos, float alpha = 1.f);
+
+    /** @brief Whichever screen the state is in. */
+    void recordMatch(RenderQueue& queue, const MatchState& state, float alpha = 1.f);
+
+private:
+    bool hudChanged(const std::array<int, 5>& key);
+    void rebuildHud(std::string_view left, std::string_view right);
+
+    Vec2 m_Resolution;
+    /** @brief HUD segment rectangles, rebuilt only when a shown value changes. */
+    std::vector<Aabb> m_HudRects;
+    /** @brief Mode and values the HUD was last built for; mode 0 means not built yet. */
+    std::array<int, 5> m_HudKey{};
+    Hud::SegmentStyle m_HudStyle;
+};
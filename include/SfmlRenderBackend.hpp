@@ -0,0 +1,59 @@
+/**
+ * @file SfmlRenderBackend.hpp
+ * @brief RenderBackend that draws a RenderQueue's commands into an SFML render target.
+ * @author Oussama Amara
+ * @date 2025-09-03
+ */
+
+#pragma once
+#include "BatchRenderer.hpp"
+#include "RenderQueue.hpp"
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+/**
+ * @class SfmlRenderBackend
+ * @brief Draws submitted commands into the target set with setTarget().
+ * Texts and meshes are drawables registered per handle by their owner. SFML binds textures
+ * per draw, so bindState() has nothing to do.
+ */
+class SfmlRenderBackend final : public RenderBackend {
+public:
+    /**
+     * @brief Target of the next frame's draws; call once per frame before submitting.
+     * Quad runs from here on are matched to their batches by order, starting with the first.
+     */
+    void setTarget(sf::RenderTarget& target) {
+        m_Target = &target;
+        m_NextRun = 0;
+    }
+
+    /** @brief Makes a text or mesh handle draw @p drawable; it must outlive the backend's use. */
+    void setResource(std::uint32_t handle, const sf::Drawable& drawable);
+
+    void clear(std::uint32_t color) override;
+    void bindState(std::uint32_t) override {}
+    void drawQuads(const RenderQuad* quads, std::size_t count) override;
+    void drawText(std::uint32_t handle, std::size_t vertices) override;
+    void drawMesh(std::uint32_t handle, std::size_t vertices) override;
+
+    /** @brief Draw calls since the last call; resets the counter. */
+    std::size_t takeDrawCalls();
+
+    /** @brief Rectangles whose vertices were rewritten since the last call; resets the counter. */
+    std::size_t takeRewrites();
+
+private:
+    void drawResource(std::uint32_t handle);
+
+    sf::RenderTarget* m_Target = nullptr;
+    std::vector<const sf::Drawable*> m_Resources;
+    /**
+     * @brief One batch per quad run of the frame, in submission order. A run only rewrites the
+     * rectangles that differ from the previous frame, so the cached HUD costs nothing until a
+     * shown value changes.
+     */
+    std::vector<BatchRenderer> m_Runs;
+    std::size_t m_NextRun = 0;
+    std::size_t m_DrawCalls = 0;
+};
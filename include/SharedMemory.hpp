@@ -0,0 +1,62 @@
+/**
+ * @file SharedMemory.hpp
+ * @brief Thin cross-platform wrapper around a named shared-memory object (POSIX shm_open / Win32 named mapping).
+ * @author Oussama Amara
+ * @date 2025-09-01
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class SharedMemory
+ * @brief Maps a named block of memory that other processes on the same machine can map too.
+ * The creator owns the name: on POSIX it replaces any stale object of the same name and
+ * removes the name again on close(); processes that still have it mapped keep their view.
+ * On Windows the object lives as long as a handle to it is open, and create() fails if
+ * it already exists.
+ */
+class SharedMemory {
+public:
+    SharedMemory() = default;
+    ~SharedMemory();
+
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    /**
+     * @brief Creates a zero-filled object of @p size bytes and maps it read-write.
+     * @param name Object name without a leading slash, e.g. "pong-feed".
+     * @return true on success.
+     */
+    bool create(const std::string& name, std::size_t size);
+
+    /**
+     * @brief Maps an existing object read-only; the mapping cannot write to it.
+     * @return true on success.
+     */
+    bool openReadOnly(const std::string& name);
+
+    /** @brief Unmaps the object; the creator also removes its name. */
+    void close();
+
+    /** @brief Checks whether an object is currently mapped. */
+    bool isOpen() const { return m_Data != nullptr; }
+
+    /** @brief Start of the mapping, or nullptr. */
+    std::uint8_t* data() { return m_Data; }
+
+    /** @brief Start of the mapping, or nullptr. */
+    const std::uint8_t* data() const { return m_Data; }
+
+    /** @brief Size of the mapping in bytes. */
+    std::size_t size() const { return m_Size; }
+
+private:
+    std::uint8_t* m_Data = nullptr;
+    std::size_t m_Size = 0;
+    std::string m_Name;   ///< Set only for the creator, which unlinks it
+    std::intptr_t m_Mapping = 0;
+};
@@ -0,0 +1,146 @@
+/**
+ * @file SimulationThread.hpp
+ * @brief Runs the simulation on its own thread at a fixed tick rate and hands snapshots to the renderer.
+ * @author Oussama Amara
+ * @date 2025-08-31
+ */
+
+#pragma once
+#include "FramePacer.hpp"
+#include "GameSimulation.hpp"
+#include "InputQueue.hpp"
+#include "TripleBuffer.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+/**
+ * @brief A request from the window thread, applied before the next tick.
+ */
+struct SimCommand {
+    enum class Type : std::uint8_t {
+        Key,        ///< A movement key was pressed or released
+        ReleaseAll, ///< The window lost focus
+        Start,      ///< Leave the menu for @c mode
+        StartCpu,   ///< Leave the menu for a multiplayer match against the CPU
+        Menu,       ///< Go back to the menu
+        Presented   ///< A frame drawn from a snapshot with @c applied presses reached the screen
+    };
+    Type type = Type::Key;
+    InputKey key = InputKey::Player1Left;
+    bool pressed = false;
+    GameMode mode = GameMode::Menu;
+    std::uint64_t timeNs = 0; ///< When the window thread saw the event
+    std::uint64_t applied = 0; ///< Presented: SimSnapshot::applied of the frame shown
+};
+
+/**
+ * @brief One published tick.
+ */
+struct SimSnapshot {
+    MatchState state;
+    std::uint64_t sequence = 0;    ///< Ticks simulated so far, from 1
+    std::uint64_t publishedNs = 0; ///< FrameProfiler::now() when it was published
+    std::uint64_t applied = 0;     ///< What the tick function returned, e.g. presses applied so far
+};
+
+/**
+ * @brief Hand-over figures; the render side counts are updated by acquire().
+ */
+struct SimThreadStats {
+    std::uint64_t ticks = 0;          ///< Ticks simulated
+    std::uint64_t drawn = 0;          ///< Frames drawn from a snapshot
+    std::uint64_t duplicated = 0;     ///< Frames that drew the same snapshot as the frame before
+    std::uint64_t dropped = 0;        ///< Ticks published but never drawn
+    std::uint64_t commandsLost = 0;   ///< Commands refused because the ring was full
+};
+
+/**
+ * @class SimulationThread
+ * @brief Fixed-rate simulation thread with a triple-buffered snapshot output.
+ * A slow window.display() or driver stall on the render thread no longer delays physics or
+ * input. Commands come in through a lock-free single-producer ring, so everything that
+ * touches the simulation runs on this thread.
+ */
+class SimulationThread {
+public:
+    /**
+     * @brief Runs one tick; the argument is the wall-clock time the tick ends at. The result
+     * is published as SimSnapshot::applied.
+     */
+    using TickFn = std::function<std::uint64_t(std::uint64_t tickEndNs)>;
+
+    /** @brief Applies one command on the simulation thread. */
+    using CommandFn = std::function<void(const SimCommand&)>;
+
+    /** @brief Commands that can wait at once; a frame's worth of events is far fewer. */
+    static constexpr std::size_t CommandCapacity = 256;
+
+    /**
+     * @param sim Simulation to tick; only the simulation thread touches it once started.
+     * @param tickRate Ticks per second.
+     * @param tick Called once per tick.
+     * @param command Called for every command, before the tick it precedes.
+     */
+    SimulationThread(GameSimulation& sim, double tickRate, TickFn tick, CommandFn command);
+
+    /** @brief Stops and joins the thread. */
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    /** @brief Starts ticking. */
+    void start();
+
+    /** @brief Finishes the current tick and joins the thread; the simulation is then free again. */
+    void stop();
+
+    /**
+     * @brief Queues a command (window thread).
+     * @return false if the ring is full; the command is dropped and counted.
+     */
+    bool post(const SimCommand& command);
+
+    /**
+     * @brief Latest complete snapshot, for drawing (render thread). Records its age as
+     * Phase::SnapshotAge and counts duplicated and dropped frames.
+     */
+    const SimSnapshot& acquire();
+
+    /**
+     * @brief Makes the next acquire() skip the dropped count, e.g. after the render thread
+     * slept in the idle menu on purpose (render thread).
+     */
+    void skipDropped() { m_SkipDropped = true; }
+
+    /** @brief Hand-over figures (render thread). */
+    SimThreadStats stats() const;
+
+private:
+    void run();
+
+    GameSimulation& m_Sim;
+    FramePacer m_Pacer;
+    TickFn m_Tick;
+    CommandFn m_Command;
+    TripleBuffer<SimSnapshot> m_Snapshots;
+
+    std::array<SimCommand, CommandCapacity> m_Commands;
+    alignas(64) std::atomic<std::size_t> m_CommandHead{0}; ///< Next command to apply (simulation thread)
+    alignas(64) std::atomic<std::size_t> m_CommandTail{0}; ///< Next free slot (window thread)
+    std::uint64_t m_CommandsLost = 0;
+
+    alignas(64) std::atomic<bool> m_Running{false};
+    std::atomic<std::uint64_t> m_Ticks{0};
+    std::thread m_Thread;
+
+    // Render side
+    std::uint64_t m_LastSequence = 0;
+    std::uint64_t m_Drawn = 0;
+    std::uint64_t m_Duplicated = 0;
+    std::uint64_t m_Dropped = 0;
+    bool m_SkipDropped = false;
+};
@@ -0,0 +1,99 @@
+/**
+ * @file SoftwareRenderer.hpp
+ * @brief Headless render backend: draws the game's screens into a CPU framebuffer.
+ * @author Oussama Amara
+ * @date 2025-09-02
+ */
+
+#pragma once
+#include "GameSimulation.hpp"
+#include "Hud.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Integer pixel rectangle, [x0, x1) x [y0, y1), already clipped to the framebuffer.
+ */
+struct PixelRect {
+    int x0 = 0;
+    int y0 = 0;
+    int x1 = 0;
+    int y1 = 0;
+};
+
+/**
+ * @class SoftwareRenderer
+ * @brief Rasterises the game's screens into an 0x00RRGGBB framebuffer.
+ * The screens are laid out with the same Hud helpers as DisplayManager, so a frame matches
+ * the window. Each frame clears only what the previous one drew, so a 1080p match frame
+ * fills a few thousand pixels instead of two million.
+ */
+class SoftwareRenderer {
+public:
+    /** @brief Colour of the cleared screen, as in window.clear(). */
+    static constexpr std::uint32_t Background = 0x000000;
+    /** @brief Colour of the bats, the ball and the HUD. */
+    static constexpr std::uint32_t Foreground = 0xffffff;
+
+    /** @brief Creates a framebuffer of the given size, cleared to the background. */
+    SoftwareRenderer(int width, int height);
+
+    /** @brief Draws the menu. */
+    void renderMenu();
+
+    /** @brief Draws a single-player frame; arguments as in DisplayManager. */
+    void renderSingleplayer(const Bat& bat, const Ball& ball, int score, int lives, int highScore, float alpha = 1.f);
+
+    /** @brief Draws a multiplayer frame; arguments as in DisplayManager. */
+    void renderMultiplayer(const Bat& bat1, const Bat& bat2, const Ball& ball, int score1, int lives1, int score2,
+                           int lives2, float alpha = 1.f);
+
+    /** @brief Draws whichever screen the state is in. */
+    void renderMatch(const MatchState& state, float alpha = 1.f);
+
+    /** @brief Pixels, row after row, width() per row. */
+    const std::uint32_t* pixels() const { return m_Pixels.data(); }
+
+    int width() const { return m_Width; }
+    int height() const { return m_Height; }
+
+    /**
+     * @brief Regions the last render changed (cleared or drawn); the first frame damages
+     * everything. Regions may overlap.
+     */
+    const std::vector<PixelRect>& damage() const { return m_Damage; }
+
+    /** @brief Makes the next render clear and damage the whole framebuffer, as a window would. */
+    void invalidate() { m_FullDamage = true; }
+
+    /** @brief Pixels written by the last render, clearing included. */
+    std::uint64_t pixelsFilled() const { return m_Filled; }
+
+    /** @brief Name of the span-fill implementation compiled in: "sse2" or "scalar". */
+    static const char* fillBackend();
+
+private:
+    void begin();
+    void fill(const Aabb& rect, std::uint32_t color);
+    void fillPixels(const PixelRect& r, std::uint32_t color);
+    bool hudChanged(const std::array<int, 5>& key);
+    void drawHud();
+    Vec2 field() const { return Vec2{static_cast<float>(m_Width), static_cast<float>(m_Height)}; }
+
+    int m_Width;
+    int m_Height;
+    std::vector<std::uint32_t> m_Pixels;
+    /** @brief Rectangles drawn by the current frame, cleared at the start of the next. */
+    std::vector<PixelRect> m_Drawn;
+    std::vector<PixelRect> m_Previous;
+    std::vector<PixelRect> m_Damage;
+    bool m_FullDamage = true;
+    std::uint64_t m_Filled = 0;
+
+    /** @brief HUD or menu rectangles, rebuilt only when a shown value changes (as in DisplayManager). */
+    std::vector<Aabb> m_HudRects;
+    std::array<int, 5> m_HudKey{};
+    Hud::SegmentStyle m_HudStyle;
+    Hud::PixelStyle m_MenuStyle;
+};
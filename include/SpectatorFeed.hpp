@@ -0,0 +1,182 @@
+/**
+ * @file SpectatorFeed.hpp
+ * @brief Per-tick match state published to a shared-memory ring for local observers.
+ * @author Oussama Amara
+ * @date 2025-09-01
+ */
+
+#pragma once
+#include "GameSimulation.hpp"
+#include "SharedMemory.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+/**
+ * @brief The match state of one tick, as observers see it. Slot 0 is the bottom bat.
+ * The layout is shared with other processes: append fields, never reorder them.
+ */
+struct SpectatorFrame {
+    std::uint64_t sequence = 0;    ///< Frames published before this one, plus one
+    std::uint64_t publishedNs = 0; ///< SpectatorFeed::now() when it was published
+    std::uint32_t tick = 0;        ///< MatchState::tick
+    std::uint8_t mode = 0;         ///< GameMode
+    std::uint8_t reserved[3] = {0, 0, 0};
+    Aabb ball;                     ///< Ball bounds in field pixels
+    float ballVelocity[2] = {0.f, 0.f}; ///< Pixels per second
+    Aabb bats[2];
+    std::int32_t score[2] = {0, 0};
+    std::int32_t lives[2] = {0, 0};
+    std::int32_t highScore = 0;
+    float timeElapsed = 0.f;
+};
+
+static_assert(sizeof(SpectatorFrame) == 104, "SpectatorFrame layout is shared with readers");
+static_assert(std::is_trivially_copyable_v<SpectatorFrame>, "SpectatorFrame is copied word by word");
+
+/**
+ * @brief Start of the shared-memory object.
+ */
+struct SpectatorHeader {
+    std::atomic<std::uint32_t> magic; ///< "PSPC", stored last once the ring is ready
+    std::uint16_t version;            ///< Layout version, currently 1
+    std::uint16_t frameSize;          ///< sizeof(SpectatorFrame) of the writer
+    std::uint32_t slotCount;          ///< Slots in the ring
+    float width;                      ///< Field width in pixels
+    float height;                     ///< Field height in pixels
+    alignas(64) std::atomic<std::uint64_t> head; ///< Sequence of the newest complete frame, 0 for none
+};
+
+/**
+ * @brief One ring slot on its own cache lines, so readers of one slot never share a line
+ * with the slot being written.
+ * Each slot is a seqlock: a reader loads the version, the payload and the version again,
+ * and keeps the frame only if both versions are 2n, so a slot overwritten mid-read is
+ * detected instead of returned torn. The payload is relaxed atomic words, which keeps the
+ * copy race-free in C++ terms.
+ */
+struct alignas(64) SpectatorSlot {
+    static constexpr std::size_t Words = sizeof(SpectatorFrame) / 4;
+    std::atomic<std::uint64_t> version; ///< 2n when it holds frame n, odd while being written
+    std::atomic<std::uint32_t> words[Words];
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "the ring needs address-free atomics");
+
+/**
+ * @class SpectatorFeed
+ * @brief Writer side: owns the shared-memory ring and publishes frames into it.
+ * Only one thread may publish. The writer never looks at its readers, so any number of
+ * them can attach, stall or crash without the game loop noticing.
+ */
+class SpectatorFeed {
+public:
+    /** @brief Slots in the ring: four seconds at 240 Hz for readers that fall behind. */
+    static constexpr std::uint32_t DefaultSlots = 1024;
+
+    SpectatorFeed() = default;
+    ~SpectatorFeed() { close(); }
+
+    SpectatorFeed(const SpectatorFeed&) = delete;
+    SpectatorFeed& operator=(const SpectatorFeed&) = delete;
+
+    /**
+     * @brief Creates the shared-memory ring.
+     * @param name Name readers open it by.
+     * @param field Field size, for readers that draw the match.
+     * @param slots Ring length in frames.
+     * @return true on success.
+     */
+    bool open(const std::string& name, Vec2 field, std::uint32_t slots = DefaultSlots);
+
+    /** @brief Removes the ring; attached readers keep the frames they can still see. */
+    void close();
+
+    /** @brief Checks whether the ring exists. */
+    bool isOpen() const { return m_Header != nullptr; }
+
+    /** @brief Publishes the state after a tick; does nothing if the feed is not open. */
+    void publish(const MatchState& state) {
+        if (m_Header)
+            publish(makeFrame(state));
+    }
+
+    /** @brief Publishes a frame; its sequence and publishedNs are filled in here. */
+    void publish(SpectatorFrame frame);
+
+    /** @brief Frames published so far. */
+    std::uint64_t published() const { return m_Published; }
+
+    /** @brief Converts a MatchState to its observer view. */
+    static SpectatorFrame makeFrame(const MatchState& state);
+
+    /** @brief Monotonic clock shared by all processes of the machine, in nanoseconds. */
+    static std::uint64_t now();
+
+private:
+    SharedMemory m_Memory;
+    SpectatorHeader* m_Header = nullptr;
+    SpectatorSlot* m_Slots = nullptr;
+    std::uint32_t m_SlotCount = 0;
+    std::uint64_t m_Published = 0;
+};
+
+/**
+ * @class SpectatorReader
+ * @brief Reader side: maps a feed read-only. Each reader keeps its own position, so one
+ * reader per thread or process.
+ */
+class SpectatorReader {
+public:
+    /**
+     * @brief Maps the feed of that name.
+     * @return false if it does not exist (yet) or has another layout.
+     */
+    bool open(const std::string& name);
+
+    /** @brief Unmaps the feed. */
+    void close();
+
+    /** @brief Checks whether a feed is mapped. */
+    bool isOpen() const { return m_Header != nullptr; }
+
+    /**
+     * @brief Reads the frame after the last one read; the first call starts at the newest.
+     * Frames the writer overwrote before this reader got to them are skipped and counted.
+     * @return false when the reader has caught up with the writer.
+     */
+    bool next(SpectatorFrame& out);
+
+    /**
+     * @brief Reads the newest complete frame, e.g. for an overlay that samples once per frame.
+     * @return false if nothing has been published yet.
+     */
+    bool latest(SpectatorFrame& out);
+
+    /** @brief Sequence of the newest frame published, without reading it. */
+    std::uint64_t head() const { return m_Header ? m_Header->head.load(std::memory_order_acquire) : 0; }
+
+    /** @brief Frames next() skipped because the writer had already overwritten them. */
+    std::uint64_t lost() const { return m_Lost; }
+
+    /** @brief Reads that raced the writer on their slot and were discarded. */
+    std::uint64_t collisions() const { return m_Collisions; }
+
+    /** @brief Field size the writer announced. */
+    Vec2 field() const { return m_Header ? Vec2{m_Header->width, m_Header->height} : Vec2{}; }
+
+    /** @brief Ring length in frames. */
+    std::uint32_t slots() const { return m_SlotCount; }
+
+private:
+    bool readSlot(std::uint64_t sequence, SpectatorFrame& out);
+
+    SharedMemory m_Memory;
+    const SpectatorHeader* m_Header = nullptr;
+    const SpectatorSlot* m_Slots = nullptr;
+    std::uint32_t m_SlotCount = 0;
+    std::uint64_t m_Next = 0;
+    std::uint64_t m_Lost = 0;
+    std::uint64_t m_Collisions = 0;
+};
@@ -0,0 +1,74 @@
+/**
+ * @file StartupProfiler.hpp
+ * @brief Times the phases of the game's startup, up to the first frame on screen.
+ * @author Oussama Amara
+ * @date 2025-09-04
+ */
+
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** @brief One timed startup phase, in nanoseconds since the profiler was created. */
+struct StartupPhase {
+    const char* name;
+    std::uint64_t startNs;
+    std::uint64_t durationNs;
+    bool mainThread;
+};
+
+/**
+ * @class StartupProfiler
+ * @brief Collects StartupPhase records from any thread.
+ */
+class StartupProfiler {
+public:
+    /** @brief The profiler; the first call starts its clock, so main() calls it first. */
+    static StartupProfiler& instance();
+
+    /** @brief Nanoseconds since the profiler was created. */
+    std::uint64_t elapsedNs() const;
+
+    /** @brief Adds a phase that started at @p startNs and ends now. */
+    void record(const char* name, std::uint64_t startNs);
+
+    /** @brief Marks startup as complete (first frame presented); later calls are ignored. */
+    void finish();
+
+    /** @brief Time from creation to finish(), or 0 before it. */
+    std::uint64_t totalNs() const;
+
+    /**
+     * @brief One line per phase (start, duration, thread) and the total, in milliseconds.
+     */
+    std::string summary() const;
+
+private:
+    StartupProfiler();
+
+    const std::uint64_t m_Origin;
+    const std::thread::id m_MainThread;
+    mutable std::mutex m_Mutex;
+    std::vector<StartupPhase> m_Phases;
+    std::uint64_t m_TotalNs = 0;
+};
+
+/**
+ * @brief Times the enclosing scope as a startup phase, on whichever thread it runs, so phases
+ * on the asset loader show up side by side with the window creation.
+ */
+class StartupTimer {
+public:
+    explicit StartupTimer(const char* name) : m_Name(name), m_Start(StartupProfiler::instance().elapsedNs()) {}
+    ~StartupTimer() { StartupProfiler::instance().record(m_Name, m_Start); }
+
+    StartupTimer(const StartupTimer&) = delete;
+    StartupTimer& operator=(const StartupTimer&) = delete;
+
+private:
+    const char* m_Name;
+    std::uint64_t m_Start;
+};
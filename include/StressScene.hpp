@@ -0,0 +1,37 @@
+/**
+ * @file StressScene.hpp
+ * @brief Thousands of drifting rectangles used to stress the renderer (pong --stress N).
+ * @author Oussama Amara
+ * @date 2025-08-22
+ */
+
+#pragma once
+#include "Collision.hpp"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class StressScene
+ * @brief Positions and velocities of the stress-test boxes. There is no game logic, so
+ * the frame time measures drawing.
+ */
+class StressScene {
+public:
+    /**
+     * @param count Number of boxes.
+     * @param resolution Screen size the boxes bounce inside.
+     * @param seed Seed for the start positions, sizes and velocities.
+     */
+    StressScene(std::size_t count, Vec2 resolution, std::uint32_t seed = 1);
+
+    /** @brief Moves every box and reflects it off the screen edges. */
+    void update(float dt);
+
+    /** @brief Current boxes. */
+    const std::vector<Aabb>& boxes() const { return m_Boxes; }
+
+private:
+    Vec2 m_Resolution;
+    std::vector<Aabb> m_Boxes;
+    std::vector<Vec2> m_Velocities;
+};
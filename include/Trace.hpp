@@ -0,0 +1,135 @@
+/**
+ * @file Trace.hpp
+ * @brief Optional binary trace log: fixed-size records written into a memory-mapped file
+ * and decoded offline by the pongtrace tool.
+ * @author Oussama Amara
+ * @date 2025-08-10
+ */
+
+#pragma once
+#include "MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Identifiers of the events recorded in a trace file.
+ * Values are part of the file format: append new events, never renumber.
+ */
+enum class TraceEvent : std::uint16_t {
+    SessionStart = 1, ///< i0 = window width, i1 = window height
+    StateChange  = 2, ///< i0 = new state (0 menu, 1 single player, 2 multiplayer)
+    BallUpdate   = 3, ///< f0,f1 = position, f2,f3 = direction
+    BallRebound  = 4, ///< f0,f1 = position, f2,f3 = direction, i0 = surface (0 side, 1 bat/top, 2 bottom, 3 multiplayer reset)
+    BatUpdate    = 5, ///< f0,f1 = position
+    Score        = 6, ///< i0 = player, i1 = new score
+    Lives        = 7, ///< i0 = player, i1 = lives left
+    HighScore    = 8, ///< i0 = player, i1 = new high score
+    SessionEnd   = 9,
+    BallContact  = 10, ///< f0,f1 = position at impact, f2,f3 = contact normal, i0 = Surface, i1 = bat index
+    Count
+};
+
+/**
+ * @brief Returns the printable name of an event, or "Unknown".
+ */
+const char* traceEventName(TraceEvent event);
+
+/**
+ * @brief Header at the start of every trace file.
+ */
+struct TraceHeader {
+    char magic[4];             ///< "PTRC"
+    std::uint16_t version;     ///< Format version, currently 1
+    std::uint16_t recordSize;  ///< sizeof(TraceRecord)
+    std::uint64_t recordCount; ///< Number of valid records following the header
+    std::uint64_t startNs;     ///< Monotonic clock value at session start
+};
+
+/**
+ * @brief One fixed-size trace entry: an event id, a monotonic timestamp and raw numeric
+ * payloads, so a per-frame event costs a 40-byte store instead of a formatted text line.
+ */
+struct TraceRecord {
+    std::uint16_t event;   ///< TraceEvent value
+    std::uint16_t flags;   ///< Reserved, zero
+    std::uint32_t frame;   ///< Frame or tick counter at the time of the event
+    std::uint64_t timeNs;  ///< Nanoseconds since TraceHeader::startNs
+    float f[4];            ///< Float payload, meaning depends on the event
+    std::int32_t i[2];     ///< Integer payload, meaning depends on the event
+};
+
+static_assert(sizeof(TraceHeader) == 24, "TraceHeader layout is part of the file format");
+static_assert(sizeof(TraceRecord) == 40, "TraceRecord layout is part of the file format");
+
+/**
+ * @class Trace
+ * @brief Process-wide binary trace writer. Disabled until open() succeeds.
+ * Records are written by the game thread only.
+ */
+class Trace {
+public:
+    /** @brief Returns the shared trace writer. */
+    static Trace& instance();
+
+    ~Trace();
+
+    /**
+     * @brief Creates (or truncates) a trace file and starts recording into it.
+     * @return true on success.
+     */
+    bool open(const std::string& path);
+
+    /** @brief Writes the final record count, trims the file and unmaps it. */
+    void close();
+
+    /** @brief Checks whether events are being recorded. */
+    bool enabled() const { return m_Enabled; }
+
+    /**
+     * @brief Sets the frame counter stamped on subsequent records.
+     * Ignored while tracing is off, so simulations on worker threads never write to the tracer.
+     */
+    void setFrame(std::uint32_t frame) {
+        if (m_Enabled)
+            m_Frame = frame;
+    }
+
+    /**
+     * @brief Appends one record; a no-op when tracing is disabled.
+     */
+    void record(TraceEvent event, float f0 = 0.f, float f1 = 0.f, float f2 = 0.f, float f3 = 0.f,
+                std::int32_t i0 = 0, std::int32_t i1 = 0) {
+        if (!m_Enabled)
+            return;
+        if (m_Count == m_Capacity && !grow())
+            return;
+        TraceRecord& rec = records()[m_Count];
+        rec.event = static_cast<std::uint16_t>(event);
+        rec.flags = 0;
+        rec.frame = m_Frame;
+        rec.timeNs = now() - m_StartNs;
+        rec.f[0] = f0; rec.f[1] = f1; rec.f[2] = f2; rec.f[3] = f3;
+        rec.i[0] = i0; rec.i[1] = i1;
+        header()->recordCount = ++m_Count;
+    }
+
+    /** @brief Current value of the monotonic clock in nanoseconds. */
+    static std::uint64_t now();
+
+private:
+    Trace() = default;
+    bool grow();
+    TraceHeader* header() { return reinterpret_cast<TraceHeader*>(m_File.data()); }
+    TraceRecord* records() { return reinterpret_cast<TraceRecord*>(m_File.data() + sizeof(TraceHeader)); }
+
+    /** @brief Number of records added each time the file is extended (4 MiB). */
+    static constexpr std::size_t GrowRecords = (4u << 20) / sizeof(TraceRecord);
+
+    MappedFile m_File;
+    bool m_Enabled = false;
+    std::size_t m_Count = 0;
+    std::size_t m_Capacity = 0;
+    std::uint32_t m_Frame = 0;
+    std::uint64_t m_StartNs = 0;
+};
@@ -0,0 +1,58 @@
+/**
+ * @file TripleBuffer.hpp
+ * @brief Lock-free single-producer, single-consumer triple buffer for handing over whole states.
+ * @author Oussama Amara
+ * @date 2025-08-31
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class TripleBuffer
+ * @brief Latest-value channel from one writer thread to one reader thread.
+ * Three slots rotate between the writer, the reader and the middle. Each hand-over is one
+ * atomic exchange of a byte holding the middle slot's index and a "fresh" flag, so neither
+ * side waits: values published while the reader was busy are overwritten, never half-read.
+ */
+template <class T>
+class TripleBuffer {
+public:
+    /** @brief Fills all three slots with @p initial; front() returns it until the first publish. */
+    explicit TripleBuffer(const T& initial) : m_Slots{initial, initial, initial} {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /** @brief Slot the writer fills next (writer thread). */
+    T& back() { return m_Slots[m_Back]; }
+
+    /** @brief Makes the back slot the latest value and takes a new back slot (writer thread). */
+    void publish() {
+        m_Back = m_Middle.exchange(static_cast<std::uint8_t>(m_Back | Fresh), std::memory_order_acq_rel) & IndexMask;
+    }
+
+    /**
+     * @brief Takes the latest published value if there is one newer than front() (reader thread).
+     * @return true if front() changed.
+     */
+    bool update() {
+        if (!(m_Middle.load(std::memory_order_relaxed) & Fresh))
+            return false;
+        m_Front = m_Middle.exchange(m_Front, std::memory_order_acq_rel) & IndexMask;
+        return true;
+    }
+
+    /** @brief Value the reader currently holds (reader thread). */
+    const T& front() const { return m_Slots[m_Front]; }
+
+private:
+    static constexpr std::uint8_t IndexMask = 3;
+    static constexpr std::uint8_t Fresh = 4;
+
+    T m_Slots[3];
+    alignas(64) std::atomic<std::uint8_t> m_Middle{1};
+    alignas(64) std::uint8_t m_Back = 2;  ///< Writer's slot
+    alignas(64) std::uint8_t m_Front = 0; ///< Reader's slot
+};
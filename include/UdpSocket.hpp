@@ -0,0 +1,78 @@
+/**
+ * @file UdpSocket.hpp
+ * @brief Thin cross-platform wrapper around a non-blocking UDP socket (BSD sockets / Winsock).
+ * @author Oussama Amara
+ * @date 2025-08-26
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief IPv4 address and port, both in host byte order.
+ */
+struct NetAddress {
+    std::uint32_t ip = 0;
+    std::uint16_t port = 0;
+
+    bool operator==(const NetAddress& other) const { return ip == other.ip && port == other.port; }
+    bool operator!=(const NetAddress& other) const { return !(*this == other); }
+
+    /** @brief "a.b.c.d:port", for logs. */
+    std::string toString() const;
+
+    /**
+     * @brief Looks up an IPv4 address for a host name or dotted address.
+     * @return false if the name does not resolve.
+     */
+    static bool resolve(const std::string& host, std::uint16_t port, NetAddress& out);
+};
+
+/**
+ * @class UdpSocket
+ * @brief Non-blocking UDP socket bound to a local port.
+ */
+class UdpSocket {
+public:
+    UdpSocket() = default;
+    ~UdpSocket();
+
+    UdpSocket(const UdpSocket&) = delete;
+    UdpSocket& operator=(const UdpSocket&) = delete;
+
+    /**
+     * @brief Opens the socket and binds it to a local port on every interface.
+     * @param port Local port, or 0 to let the system pick one.
+     * @return true on success.
+     */
+    bool open(std::uint16_t port);
+
+    /** @brief Closes the socket. */
+    void close();
+
+    /** @brief Checks whether the socket is open. */
+    bool isOpen() const { return m_Handle != InvalidHandle; }
+
+    /** @brief Port the socket is bound to. */
+    std::uint16_t localPort() const { return m_Port; }
+
+    /**
+     * @brief Sends one datagram.
+     * @return false if the system refused it; UDP gives no delivery guarantee either way.
+     */
+    bool sendTo(const NetAddress& to, const void* data, std::size_t size);
+
+    /**
+     * @brief Reads one pending datagram without blocking.
+     * @return Its size, or -1 if none is waiting. Datagrams longer than @p capacity are truncated.
+     */
+    long receive(void* buffer, std::size_t capacity, NetAddress& from);
+
+private:
+    static constexpr std::intptr_t InvalidHandle = -1;
+
+    std::intptr_t m_Handle = InvalidHandle;
+    std::uint16_t m_Port = 0;
+};
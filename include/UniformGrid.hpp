@@ -0,0 +1,98 @@
+/**
+ * @file UniformGrid.hpp
+ * @brief Uniform spatial grid used as the broadphase of the multi-ball mode.
+ * @author Oussama Amara
+ * @date 2025-08-23
+ */
+
+#pragma once
+#include "Collision.hpp"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class UniformGrid
+ * @brief Fixed-size grid of intrusive item lists plus a per-cell bit mask.
+ * Every item is linked into the cell holding its centre. Items are no larger than a cell,
+ * so two overlapping items are always in the same or neighbouring cells. Larger objects
+ * such as the bats are not items; they set bits in the cell masks with mark().
+ */
+class UniformGrid {
+public:
+    /**
+     * @param size Area covered; positions outside are clamped to the border cells.
+     * @param cellSize Cell edge in pixels, at least the size of the largest item.
+     */
+    UniformGrid(Vec2 size, float cellSize);
+
+    /** @brief Sets the number of items; new items are not in any cell until updated. */
+    void resize(std::size_t items);
+
+    /**
+     * @brief Moves an item to the cell of its box; it is only relinked when it crossed into
+     * another cell, so slow items cost almost nothing per tick.
+     * @return True if the item changed cell.
+     */
+    bool update(std::size_t item, const Aabb& box);
+
+    /** @brief Takes an item out of its cell until it is updated again. */
+    void remove(std::size_t item) { unlink(static_cast<int>(item)); }
+
+    /**
+     * @brief Calls f(a, b) once for every pair of items in the same or neighbouring cells.
+     * Each cell is paired with itself and with its right, lower-left, lower and lower-right
+     * neighbours, which covers every neighbouring pair exactly once.
+     */
+    template <class F>
+    void forEachPair(F&& f) const {
+        static const int dx[] = {1, -1, 0, 1}, dy[] = {0, 1, 1, 1};
+        for (int cy = 0; cy < m_Rows; ++cy) {
+            for (int cx = 0; cx < m_Cols; ++cx) {
+                int head = m_Head[cy * m_Cols + cx];
+                if (head < 0)
+                    continue;
+                for (int a = head; a >= 0; a = m_Next[a]) {
+                    for (int b = m_Next[a]; b >= 0; b = m_Next[b])
+                        f(static_cast<std::size_t>(a), static_cast<std::size_t>(b));
+                    for (int k = 0; k < 4; ++k) {
+                        int x = cx + dx[k], y = cy + dy[k];
+                        if (x < 0 || x >= m_Cols || y >= m_Rows)
+                            continue;
+                        for (int b = m_Head[y * m_Cols + x]; b >= 0; b = m_Next[b])
+                            f(static_cast<std::size_t>(a), static_cast<std::size_t>(b));
+                    }
+                }
+            }
+        }
+    }
+
+    /** @brief Clears every cell mask. */
+    void clearMarks();
+
+    /** @brief Sets @p bits in every cell the box overlaps. */
+    void mark(const Aabb& box, std::uint8_t bits);
+
+    /** @brief Union of the masks in the 3x3 cells around an item. */
+    std::uint8_t marksNear(std::size_t item) const;
+
+    /** @brief Relinks since the last call; resets the counter. */
+    std::size_t takeRelinks();
+
+    /** @brief Cell edge in pixels. */
+    float cellSize() const { return m_CellSize; }
+
+private:
+    int cellX(float x) const;
+    int cellY(float y) const;
+    void unlink(int item);
+
+    int m_Cols;
+    int m_Rows;
+    float m_CellSize;
+    std::vector<int> m_Head;          ///< First item per cell, -1 when empty
+    std::vector<int> m_Next;          ///< Next item in the same cell
+    std::vector<int> m_Prev;          ///< Previous item in the same cell
+    std::vector<int> m_Cell;          ///< Cell per item, -1 when not placed
+    std::vector<std::uint8_t> m_Marks;
+    std::size_t m_Relinks = 0;
+};
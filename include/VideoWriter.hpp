@@ -0,0 +1,77 @@
+/**
+ * @file VideoWriter.hpp
+ * @brief Streams SoftwareRenderer frames as uncompressed video: YUV4MPEG2 (.y4m) or a PPM sequence.
+ * @author Oussama Amara
+ * @date 2025-09-02
+ */
+
+#pragma once
+#include "SoftwareRenderer.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @class VideoWriter
+ * @brief Writes rendered frames to a Y4M or PPM stream.
+ * Y4M holds 4:2:0 full-range BT.601 planes, as ffmpeg and x264 read from a pipe; PPM is
+ * back-to-back binary images (ffmpeg -f image2pipe).
+ */
+class VideoWriter {
+public:
+    /** @brief Container written. */
+    enum class Format { Y4m, Ppm };
+
+    VideoWriter() = default;
+    ~VideoWriter() { close(); }
+
+    VideoWriter(const VideoWriter&) = delete;
+    VideoWriter& operator=(const VideoWriter&) = delete;
+
+    /**
+     * @brief Picks the format from the file extension: .ppm for PPM, anything else Y4M.
+     */
+    static Format formatOf(const std::string& path);
+
+    /**
+     * @brief Opens the output and writes the stream header.
+     * @param path File to write, "-" for standard output, or empty to discard the output.
+     * @param fps Frame rate recorded in the Y4M header.
+     * @return false if the file cannot be opened or, for Y4M, the size is odd.
+     */
+    bool open(const std::string& path, Format format, int width, int height, int fps);
+
+    /**
+     * @brief Converts the damaged regions of the renderer's frame and writes the whole frame.
+     * The writer keeps its own converted picture, so it must be given every frame rendered.
+     * @return false on a write error.
+     */
+    bool write(const SoftwareRenderer& frame);
+
+    /** @brief Flushes and closes the output. */
+    void close();
+
+    /** @brief Frames written. */
+    std::uint64_t frames() const { return m_Frames; }
+
+    /** @brief Bytes written, headers included. */
+    std::uint64_t bytes() const { return m_Bytes; }
+
+private:
+    void convertY4m(const SoftwareRenderer& frame, PixelRect r);
+    void convertPpm(const SoftwareRenderer& frame, const PixelRect& r);
+    bool put(const void* data, std::size_t size);
+
+    std::FILE* m_File = nullptr;
+    bool m_Open = false;
+    bool m_OwnsFile = false;
+    Format m_Format = Format::Y4m;
+    int m_Width = 0;
+    int m_Height = 0;
+    bool m_First = true;
+    /** @brief Y4M: Y plane, then U and V at quarter size. PPM: RGB triples. */
+    std::vector<std::uint8_t> m_Picture;
+    std::uint64_t m_Frames = 0;
+    std::uint64_t m_Bytes = 0;
+};
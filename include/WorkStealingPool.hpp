@@ -0,0 +1,86 @@
+/**
+ * @file WorkStealingPool.hpp
+ * @brief Fixed set of worker threads running parallel loops with work stealing.
+ * @author Oussama Amara
+ * @date 2025-08-19
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class WorkStealingPool
+ * @brief Runs parallelFor() bodies on a fixed number of threads, including the caller.
+ * The owner of a range takes indices from its front; an idle worker steals the back half
+ * of another worker's range, so loop bodies that run longer simply get their neighbours'
+ * work stolen.
+ */
+class WorkStealingPool {
+public:
+    /** @brief Loop body: worker index in [0, size()) and loop index. */
+    using Body = std::function<void(unsigned worker, std::uint32_t index)>;
+
+    /**
+     * @brief Starts threads - 1 worker threads; the calling thread is worker 0.
+     * @param threads Total number of workers (at least 1).
+     */
+    explicit WorkStealingPool(unsigned threads);
+
+    /** @brief Stops and joins the worker threads. */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /** @brief Number of workers, including the calling thread. */
+    unsigned size() const { return m_Workers; }
+
+    /**
+     * @brief Calls @p body once for every index in [0, count) and returns when all are done.
+     * Indices are split evenly between the workers up front and rebalanced by stealing.
+     */
+    void parallelFor(std::uint32_t count, const Body& body);
+
+    /** @brief Number of successful steals during the last parallelFor(). */
+    std::uint64_t steals() const { return m_Steals.load(std::memory_order_relaxed); }
+
+private:
+    /**
+     * @brief One worker's remaining indices, on its own cache line: begin in the low half,
+     * end in the high half. Taking and stealing are each one compare-and-swap on this word,
+     * so no index runs twice and no lock is taken while the loop runs.
+     */
+    struct alignas(64) Range {
+        std::atomic<std::uint64_t> bounds{0};
+    };
+
+    static std::uint64_t pack(std::uint32_t begin, std::uint32_t end) {
+        return static_cast<std::uint64_t>(end) << 32 | begin;
+    }
+
+    void threadMain(unsigned worker);
+    void work(unsigned worker);
+    bool popFront(unsigned worker, std::uint32_t& index);
+    bool steal(unsigned thief);
+
+    unsigned m_Workers;
+    std::unique_ptr<Range[]> m_Ranges;
+    std::vector<std::thread> m_Threads;
+    const Body* m_Body = nullptr;
+    std::atomic<std::uint64_t> m_Steals{0};
+
+    // Only used to start a loop and to wait for its end, never inside it.
+    std::mutex m_Mutex;
+    std::condition_variable m_Start;
+    std::condition_variable m_Finished;
+    std::uint64_t m_Generation = 0;
+    unsigned m_Running = 0;
+    bool m_Stop = false;
+};
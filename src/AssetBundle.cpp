@@ -0,0 +1,183 @@
+/**
+ * @file AssetBundle.cpp
+ * @brief Implementation of the asset bundle: writing, mapping, lookup and verification.
+ * @author Oussama Amara
+ * @date 2025-09-04
+ */
+
+#include "AssetBundle.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr std::uint32_t Version = 1;
+/** @brief Asset offsets are multiples of this, so data can be read in place at any width. */
+constexpr std::size_t Alignment = 16;
+
+std::array<std::uint32_t, 256> makeCrcTable() {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t c = i;
+        for (int k = 0; k < 8; ++k)
+            c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        table[i] = c;
+    }
+    return table;
+}
+
+std::uint32_t crc32(const void* data, std::size_t size) {
+    static const std::array<std::uint32_t, 256> table = makeCrcTable();
+    const auto* p = static_cast<const std::uint8_t*>(data);
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for (std::size_t i = 0; i < size; ++i)
+        crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+std::string_view entryName(const AssetBundleEntry& e) {
+    return std::string_view(e.name, static_cast<std::size_t>(std::find(e.name, e.name + sizeof e.name, '\0') - e.name));
+}
+} // namespace
+
+const AssetBundleEntry* AssetBundle::entries() const {
+    return reinterpret_cast<const AssetBundleEntry*>(m_File.data() + sizeof(AssetBundleHeader));
+}
+
+bool AssetBundle::open(const std::string& path) {
+    close();
+    if (!m_File.open(path, MappedFile::Mode::ReadOnly))
+        return false;
+    AssetBundleHeader header;
+    const std::size_t fileSize = m_File.size();
+    if (fileSize < sizeof header) {
+        close();
+        return false;
+    }
+    std::memcpy(&header, m_File.data(), sizeof header);
+    const std::size_t indexSize = static_cast<std::size_t>(header.count) * sizeof(AssetBundleEntry);
+    if (std::memcmp(header.magic, "PPAK", 4) != 0 || header.version != Version ||
+        indexSize > fileSize - sizeof header ||
+        crc32(m_File.data() + sizeof header, indexSize) != header.indexCrc) {
+        close();
+        return false;
+    }
+    // A sound index is enough to hand out assets safely: every one lies inside the file
+    const AssetBundleEntry* index = reinterpret_cast<const AssetBundleEntry*>(m_File.data() + sizeof header);
+    for (std::uint32_t i = 0; i < header.count; ++i) {
+        if (index[i].offset > fileSize || index[i].size > fileSize - index[i].offset) {
+            close();
+            return false;
+        }
+    }
+    m_Count = header.count;
+    return true;
+}
+
+void AssetBundle::close() {
+    m_File.close();
+    m_Count = 0;
+}
+
+AssetBundle::Asset AssetBundle::find(std::string_view name) const {
+    const AssetBundleEntry* first = entries();
+    const AssetBundleEntry* last = first + m_Count;
+    const AssetBundleEntry* it = std::lower_bound(
+        first, last, name, [](const AssetBundleEntry& e, std::string_view key) { return entryName(e) < key; });
+    if (it == last || entryName(*it) != name)
+        return Asset{};
+    return Asset{m_File.data() + it->offset, it->size};
+}
+
+std::string_view AssetBundle::name(std::size_t index) const {
+    return index < m_Count ? entryName(entries()[index]) : std::string_view();
+}
+
+AssetBundle::Asset AssetBundle::at(std::size_t index) const {
+    if (index >= m_Count)
+        return Asset{};
+    const AssetBundleEntry& e = entries()[index];
+    return Asset{m_File.data() + e.offset, e.size};
+}
+
+std::size_t AssetBundle::verify() const {
+    for (std::size_t i = 0; i < m_Count; ++i) {
+        const AssetBundleEntry& e = entries()[i];
+        if (crc32(m_File.data() + e.offset, e.size) != e.crc)
+            return i;
+    }
+    return m_Count;
+}
+
+/**
+ * @brief Sorts the assets by name, lays them out after the index and writes the file in one pass.
+ */
+bool AssetBundle::write(const std::string& path, std::vector<Source> assets) {
+    std::sort(assets.begin(), assets.end(), [](const Source& a, const Source& b) { return a.name < b.name; });
+    for (std::size_t i = 0; i < assets.size(); ++i) {
+        if (assets[i].name.empty() || assets[i].name.size() > MaxName ||
+            (i > 0 && assets[i].name == assets[i - 1].name))
+            return false;
+    }
+
+    std::vector<AssetBundleEntry> index(assets.size());
+    std::size_t offset = sizeof(AssetBundleHeader) + index.size() * sizeof(AssetBundleEntry);
+    for (std::size_t i = 0; i < assets.size(); ++i) {
+        offset = (offset + Alignment - 1) & ~(Alignment - 1);
+        AssetBundleEntry& e = index[i];
+        std::memcpy(e.name, assets[i].name.data(), assets[i].name.size());
+        e.offset = offset;
+        e.size = static_cast<std::uint32_t>(assets[i].bytes.size());
+        e.crc = crc32(assets[i].bytes.data(), assets[i].bytes.size());
+        offset += assets[i].bytes.size();
+    }
+    AssetBundleHeader header;
+    std::memcpy(header.magic, "PPAK", 4);
+    header.version = Version;
+    header.count = static_cast<std::uint32_t>(index.size());
+    header.indexCrc = crc32(index.data(), index.size() * sizeof(AssetBundleEntry));
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file)
+        return false;
+    bool ok = std::fwrite(&header, sizeof header, 1, file) == 1 &&
+              (index.empty() || std::fwrite(index.data(), sizeof(AssetBundleEntry), index.size(), file) == index.size());
+    std::size_t written = sizeof header + index.size() * sizeof(AssetBundleEntry);
+    static const char padding[Alignment] = {};
+    for (std::size_t i = 0; ok && i < assets.size(); ++i) {
+        const std::size_t pad = static_cast<std::size_t>(index[i].offset) - written;
+        ok = (pad == 0 || std::fwrite(padding, 1, pad, file) == pad) &&
+             (assets[i].bytes.empty() ||
+              std::fwrite(assets[i].bytes.data(), 1, assets[i].bytes.size(), file) == assets[i].bytes.size());
+        written = static_cast<std::size_t>(index[i].offset) + assets[i].bytes.size();
+    }
+    ok = std::fclose(file) == 0 && ok;
+    return ok;
+}
+
+std::string AssetBundle::executableDir(const char* argv0) {
+    std::string path;
+#ifdef _WIN32
+    char buffer[MAX_PATH];
+    DWORD n = GetModuleFileNameA(nullptr, buffer, MAX_PATH);
+    if (n > 0 && n < MAX_PATH)
+        path.assign(buffer, n);
+#else
+    char buffer[4096];
+    ssize_t n = readlink("/proc/self/exe", buffer, sizeof buffer);
+    if (n > 0 && static_cast<std::size_t>(n) < sizeof buffer)
+        path.assign(buffer, static_cast<std::size_t>(n));
+#endif
+    if (path.empty() && argv0)
+        path = argv0;
+    const std::size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+}
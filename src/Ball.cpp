@@ -7,39 +7,41 @@
  */
 
 #include "Ball.hpp"
+#include "FrameProfiler.hpp"
 #include "Logger.hpp"
+#include "Trace.hpp"
+#include <cstring>
 
 /**
  * @brief Constructs a ball at the specified position.
  */
-Ball::Ball(float startX, float startY, sf::Vector2f resolution)
-    : m_Position(startX, startY), m_Resolution(resolution)
+Ball::Ball(float startX, float startY, Vec2 resolution)
+    : m_Position{startX, startY}, m_PrevPosition{startX, startY}, m_Resolution(resolution)
 {
-    m_Shape.setSize(sf::Vector2f(10.f, 10.f));
-    m_Shape.setPosition(m_Position);
-    Logger().info("Ball created at position (" + std::to_string(startX) + ", " + std::to_string(startY) + ")");
+    LOG_INFO("Ball created at position ({}, {})", startX, startY);
 }
 
 
 /**
  * @brief Retrieves the global bounding rectangle of the ball.
  */
-sf::FloatRect Ball::getGlobalBounds() const {
-    return m_Shape.getGlobalBounds();
+Aabb Ball::getGlobalBounds() const {
+    return Aabb{m_Position.x, m_Position.y, m_Size.x, m_Size.y};
 }
 
 /**
  * @brief Retrieves the current position rectangle of the ball.
  */
-sf::FloatRect Ball::getPosition() const {
-    return m_Shape.getGlobalBounds();
+Aabb Ball::getPosition() const {
+    return getGlobalBounds();
 }
 
 /**
- * @brief Provides access to the ball's shape for rendering.
+ * @brief Blends the previous and current tick positions for drawing.
  */
-const sf::RectangleShape& Ball::getShape() const {
-    return m_Shape;
+Aabb Ball::getRenderBounds(float alpha) const {
+    return Aabb{m_PrevPosition.x + (m_Position.x - m_PrevPosition.x) * alpha,
+                m_PrevPosition.y + (m_Position.y - m_PrevPosition.y) * alpha, m_Size.x, m_Size.y};
 }
 
 /**
@@ -54,7 +56,8 @@ float Ball::getXVelocity() const {
  */
 void Ball::reboundSides() {
     m_DirectionX = -m_DirectionX;
-    Logger().info("Ball rebounded off side wall. DirectionX is now " + std::to_string(m_DirectionX));
+    LOG_DEBUG("Ball rebounded off side wall. DirectionX is now {}", m_DirectionX);
+    Trace::instance().record(TraceEvent::BallRebound, m_Position.x, m_Position.y, m_DirectionX, m_DirectionY, 0);
 }
 
 /**
@@ -62,7 +65,8 @@ void Ball::reboundSides() {
  */
 void Ball::reboundBatOrTop() {
     m_DirectionY = -m_DirectionY;
-    Logger().info("Ball rebounded off bat or top. DirectionY is now " + std::to_string(m_DirectionY));
+    LOG_DEBUG("Ball rebounded off bat or top. DirectionY is now {}", m_DirectionY);
+    Trace::instance().record(TraceEvent::BallRebound, m_Position.x, m_Position.y, m_DirectionX, m_DirectionY, 1);
 }
 
 /**
@@ -70,9 +74,10 @@ void Ball::reboundBatOrTop() {
  */
 void Ball::reboundBottom() {
     m_Position = {m_Resolution.x / 2.f, m_Resolution.y / 2.f};
+    m_PrevPosition = m_Position;
     m_DirectionY = -m_DirectionY;
-    m_Shape.setPosition(m_Position);
-    Logger().info("Ball hit bottom. Position reset to (" + std::to_string(m_Position.x) + ", " + std::to_string(m_Position.y) + "). DirectionY is now " + std::to_string(m_DirectionY));
+    LOG_INFO("Ball hit bottom. Position reset to ({}, {}). DirectionY is now {}", m_Position.x, m_Position.y, m_DirectionY);
+    Trace::instance().record(TraceEvent::BallRebound, m_Position.x, m_Position.y, m_DirectionX, m_DirectionY, 2);
 }
 
 /**
@@ -80,17 +85,73 @@ void Ball::reboundBottom() {
  */
 void Ball::reboundBatOrTopMultiplayer() {
     m_Position = {m_Resolution.x / 2.f, m_Resolution.y / 2.f};
+    m_PrevPosition = m_Position;
     m_DirectionY = -m_DirectionY;
-    m_Shape.setPosition(m_Position);
-    Logger().info("Multiplayer: Ball rebounded. Reset to (" + std::to_string(m_Position.x) + ", " + std::to_string(m_Position.y) + "). DirectionY is now " + std::to_string(m_DirectionY));
+    LOG_INFO("Multiplayer: Ball rebounded. Reset to ({}, {}). DirectionY is now {}", m_Position.x, m_Position.y, m_DirectionY);
+    Trace::instance().record(TraceEvent::BallRebound, m_Position.x, m_Position.y, m_DirectionX, m_DirectionY, 3);
 }
 
 /**
  * @brief Updates ball position based on velocity and delta time.
  */
-void Ball::update(sf::Time dt) {
-    m_Position.x += m_DirectionX * m_Speed * dt.asSeconds();
-    m_Position.y += m_DirectionY * m_Speed * dt.asSeconds();
-    m_Shape.setPosition(m_Position);
-    Logger().info("Ball updated position to (" + std::to_string(m_Position.x) + ", " + std::to_string(m_Position.y) + ")");
+void Ball::update(float dt) {
+    m_PrevPosition = m_Position;
+    m_Position.x += m_DirectionX * m_Speed * dt;
+    m_Position.y += m_DirectionY * m_Speed * dt;
+    LOG_TRACE("Ball updated position to ({}, {})", m_Position.x, m_Position.y);
+    Trace::instance().record(TraceEvent::BallUpdate, m_Position.x, m_Position.y, m_DirectionX, m_DirectionY);
+}
+
+/**
+ * @brief Sweeps the ball through the step and logs each bounce.
+ */
+int Ball::update(float dt, const Arena& arena, const Aabb* bats, int batCount, Contact* contacts) {
+    m_PrevPosition = m_Position;
+    Aabb box = getGlobalBounds();
+    Vec2 velocity{m_DirectionX * m_Speed, m_DirectionY * m_Speed};
+    int count;
+    {
+        ScopedTimer timer(Phase::Collision);
+        count = Collision::sweepBall(box, velocity, dt, arena, bats, batCount, contacts, Collision::MaxContacts);
+    }
+    m_Position = {box.x, box.y};
+    m_DirectionX = velocity.x / m_Speed;
+    m_DirectionY = velocity.y / m_Speed;
+
+    for (int i = 0; i < count; ++i) {
+        const Contact& c = contacts[i];
+        LOG_DEBUG("Ball contact with surface {} at ({}, {}), normal ({}, {})", static_cast<int>(c.surface),
+                  c.position.x, c.position.y, c.normal.x, c.normal.y);
+        Trace::instance().record(TraceEvent::BallContact, c.position.x, c.position.y, c.normal.x, c.normal.y,
+                                 static_cast<int>(c.surface), c.index);
+    }
+    LOG_TRACE("Ball updated position to ({}, {})", m_Position.x, m_Position.y);
+    Trace::instance().record(TraceEvent::BallUpdate, m_Position.x, m_Position.y, m_DirectionX, m_DirectionY);
+    return count;
+}
+
+/**
+ * @brief Copies the fields one after the other.
+ */
+void Ball::pack(std::uint8_t* out) const {
+    const float fields[] = {m_Position.x, m_Position.y, m_PrevPosition.x, m_PrevPosition.y,
+                            m_Resolution.x, m_Resolution.y, m_Size.x, m_Size.y,
+                            m_Speed, m_DirectionX, m_DirectionY};
+    static_assert(sizeof fields == PackedSize, "Ball::PackedSize is out of date");
+    std::memcpy(out, fields, sizeof fields);
+}
+
+/**
+ * @brief Reads the fields in the order pack() wrote them.
+ */
+void Ball::unpack(const std::uint8_t* in) {
+    float f[PackedSize / sizeof(float)];
+    std::memcpy(f, in, sizeof f);
+    m_Position = {f[0], f[1]};
+    m_PrevPosition = {f[2], f[3]};
+    m_Resolution = {f[4], f[5]};
+    m_Size = {f[6], f[7]};
+    m_Speed = f[8];
+    m_DirectionX = f[9];
+    m_DirectionY = f[10];
 }
@@ -1,60 +1,65 @@
 /**
  * @file Bat.cpp
  * @brief Implementation of the Bat class, representing the player's paddle in a Pong game.
- * This class handles the bat's position, movement, and rendering.
+ * This class handles the bat's position and movement.
  * @author Oussama Amara
  * @date 2025-07-27
  */
 
 #include "Bat.hpp"
 #include "Logger.hpp"
+#include "Trace.hpp"
+#include <cstring>
 
 /**
  * @brief Constructs a bat at the given coordinates.
  */
 Bat::Bat(float startX, float startY)
-    : m_Position(startX, startY)
+    : m_Position{startX, startY}, m_PrevPosition{startX, startY}
 {
-    m_Shape.setSize(sf::Vector2f(50.f, 5.f));
-    m_Shape.setPosition(m_Position);
-    Logger().info("Bat created at position (" + std::to_string(startX) + ", " + std::to_string(startY) + ")");
+    LOG_INFO("Bat created at position ({}, {})", startX, startY);
 }
 
 /**
  * @brief Retrieves the bat's bounding rectangle.
  */
-sf::FloatRect Bat::getPosition() const {
-    return m_Shape.getGlobalBounds();
+Aabb Bat::getPosition() const {
+    return getGlobalBounds();
 }
 
 /**
  * @brief Gets global bounds for collision detection.
  */
-sf::FloatRect Bat::getGlobalBounds() const {
-    return m_Shape.getGlobalBounds();
+Aabb Bat::getGlobalBounds() const {
+    return Aabb{m_Position.x, m_Position.y, m_Size.x, m_Size.y};
 }
 
 /**
- * @brief Accesses bat shape for rendering.
+ * @brief Blends the previous and current tick positions for drawing.
  */
-const sf::RectangleShape& Bat::getShape() const {
-    return m_Shape;
+Aabb Bat::getRenderBounds(float alpha) const {
+    return Aabb{m_PrevPosition.x + (m_Position.x - m_PrevPosition.x) * alpha,
+                m_PrevPosition.y + (m_Position.y - m_PrevPosition.y) * alpha, m_Size.x, m_Size.y};
 }
 
 /**
  * @brief Begins movement to the left.
  */
 void Bat::moveLeft() {
+    if (!m_MovingLeft) {
+        LOG_TRACE("Bat movement: left initiated");
+    }
     m_MovingLeft = true;
-    Logger().info("Bat movement: left initiated");
 }
 
 /**
  * @brief Begins movement to the right.
  */
 void Bat::moveRight() {
+    if (!m_MovingRight) {
+        LOG_TRACE("Bat movement: right initiated");
+    }
     m_MovingRight = true;
-    Logger().info("Bat movement: right initiated");
 }
 
 /**
@@ -62,7 +67,7 @@ void Bat::moveRight() {
  */
 void Bat::stopLeft() {
     if (m_MovingLeft) {
-        Logger().info("Bat movement: left stopped");
+        LOG_DEBUG("Bat movement: left stopped");
     }
     m_MovingLeft = false;
 }
@@ -72,7 +77,7 @@ void Bat::stopLeft() {
  */
 void Bat::stopRight() {
     if (m_MovingRight) {
-        Logger().info("Bat movement: right stopped");
+        LOG_DEBUG("Bat movement: right stopped");
     }
     m_MovingRight = false;
 }
@@ -80,22 +85,48 @@ void Bat::stopRight() {
 /**
  * @brief Updates bat position based on movement flags.
  */
-void Bat::update(sf::Time dt) {
+void Bat::update(float dt) {
     bool updated = false;
+    m_PrevPosition = m_Position;
 
     if (m_MovingLeft) {
-        m_Position.x -= m_Speed * dt.asSeconds();
+        m_Position.x -= m_Speed * dt;
         updated = true;
     }
 
     if (m_MovingRight) {
-        m_Position.x += m_Speed * dt.asSeconds();
+        m_Position.x += m_Speed * dt;
         updated = true;
     }
 
-    m_Shape.setPosition(m_Position);
-
     if (updated) {
-        Logger().info("Bat updated position to (" + std::to_string(m_Position.x) + ", " + std::to_string(m_Position.y) + ")");
+        LOG_TRACE("Bat updated position to ({}, {})", m_Position.x, m_Position.y);
+        Trace::instance().record(TraceEvent::BatUpdate, m_Position.x, m_Position.y);
     }
 }
+
+/**
+ * @brief Copies the fields one after the other; each flag takes one byte.
+ */
+void Bat::pack(std::uint8_t* out) const {
+    const float fields[] = {m_Position.x, m_Position.y, m_PrevPosition.x, m_PrevPosition.y,
+                            m_Size.x, m_Size.y, m_Speed};
+    static_assert(sizeof fields + 2 == PackedSize, "Bat::PackedSize is out of date");
+    std::memcpy(out, fields, sizeof fields);
+    out[sizeof fields] = m_MovingRight ? 1 : 0;
+    out[sizeof fields + 1] = m_MovingLeft ? 1 : 0;
+}
+
+/**
+ * @brief Reads the fields in the order pack() wrote them.
+ */
+void Bat::unpack(const std::uint8_t* in) {
+    float f[7];
+    std::memcpy(f, in, sizeof f);
+    m_Position = {f[0], f[1]};
+    m_PrevPosition = {f[2], f[3]};
+    m_Size = {f[4], f[5]};
+    m_Speed = f[6];
+    m_MovingRight = in[sizeof f] != 0;
+    m_MovingLeft = in[sizeof f + 1] != 0;
+}
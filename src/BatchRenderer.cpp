@@ -0,0 +1,54 @@
+/**
+ * @file BatchRenderer.cpp
+ * @brief Implementation of the single-draw-call rectangle batch.
+ * @author Oussama Amara
+ * @date 2025-08-22
+ */
+
+#include "BatchRenderer.hpp"
+
+void BatchRenderer::resize(std::size_t count) {
+    std::size_t old = m_Rects.size();
+    m_Rects.resize(count, Slot{Aabb{}, sf::Color::White});
+    m_Vertices.resize(count * VerticesPerRect);
+    for (std::size_t i = old; i < count; ++i)
+        write(i);
+}
+
+bool BatchRenderer::set(std::size_t slot, const Aabb& rect, sf::Color color) {
+    Slot& s = m_Rects[slot];
+    if (s.rect.x == rect.x && s.rect.y == rect.y && s.rect.w == rect.w && s.rect.h == rect.h &&
+        s.color == color)
+        return false;
+    s.rect = rect;
+    s.color = color;
+    write(slot);
+    ++m_Rewrites;
+    return true;
+}
+
+/**
+ * @brief Writes the two triangles of a slot: top-left, top-right, bottom-left and
+ * bottom-left, top-right, bottom-right.
+ */
+void BatchRenderer::write(std::size_t slot) {
+    const Slot& s = m_Rects[slot];
+    const float x0 = s.rect.x, y0 = s.rect.y, x1 = s.rect.x + s.rect.w, y1 = s.rect.y + s.rect.h;
+    const sf::Vector2f corners[VerticesPerRect] = {{x0, y0}, {x1, y0}, {x0, y1}, {x0, y1}, {x1, y0}, {x1, y1}};
+    sf::Vertex* v = &m_Vertices[slot * VerticesPerRect];
+    for (std::size_t k = 0; k < VerticesPerRect; ++k) {
+        v[k].position = corners[k];
+        v[k].color = s.color;
+    }
+}
+
+void BatchRenderer::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (!m_Rects.empty())
+        target.draw(m_Vertices, states);
+}
+
+std::size_t BatchRenderer::takeRewrites() {
+    std::size_t n = m_Rewrites;
+    m_Rewrites = 0;
+    return n;
+}
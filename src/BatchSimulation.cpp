@@ -0,0 +1,260 @@
+/**
+ * @file BatchSimulation.cpp
+ * @brief Batch setup, kernel selection, the scalar reference kernel and the SSE2 kernel.
+ * @author Oussama Amara
+ * @date 2025-08-18
+ */
+
+#include "BatchSimulation.hpp"
+#include "BatchKernel.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <random>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PONG_BATCH_SSE2 1
+#endif
+
+/**
+ * @brief Draws a serve angle and two bot speeds per match; padding lanes start finished.
+ */
+BatchSimulation::BatchSimulation(std::size_t count, const BatchParams& params, std::uint32_t seed)
+    : m_Count(count), m_Params(params)
+{
+    std::size_t padded = (count + LaneAlign - 1) / LaneAlign * LaneAlign;
+    BatchLanes& L = m_Lanes;
+    for (auto* v : {&L.ballX, &L.ballY, &L.dirX, &L.dirY, &L.bat1X, &L.bat2X, &L.botSpeed1, &L.botSpeed2, &L.time})
+        v->assign(padded, 0.f);
+    for (auto* v : {&L.score1, &L.score2, &L.lives1, &L.lives2, &L.batHits, &L.ticks, &L.done})
+        v->assign(padded, 0);
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> angle(0.1f, 0.5f);
+    std::uniform_real_distribution<float> botSpeed(150.f, 600.f);
+    for (std::size_t i = 0; i < padded; ++i) {
+        L.ballX[i] = params.width / 2.f;
+        L.dirX[i] = (rng() & 1) ? angle(rng) : -angle(rng);
+        L.dirY[i] = 0.2f;
+        L.bat1X[i] = params.width / 2.f;
+        L.bat2X[i] = params.width / 2.f;
+        L.botSpeed1[i] = botSpeed(rng);
+        L.botSpeed2[i] = botSpeed(rng);
+        L.lives1[i] = params.lives;
+        L.lives2[i] = params.lives;
+        L.done[i] = i < count ? 0 : 1;
+    }
+}
+
+/**
+ * @brief Runs the requested kernel, falling back to the best supported one.
+ */
+void BatchSimulation::step(int ticks, Backend backend) {
+    if (backend == Backend::Auto || !supported(backend))
+        backend = bestBackend();
+
+    std::size_t end = m_Lanes.done.size();
+    switch (backend) {
+        case Backend::Avx2: stepBatchAvx2(m_Lanes, m_Params, 0, end, ticks); break;
+        case Backend::Sse2: stepBatchSse2(m_Lanes, m_Params, 0, end, ticks); break;
+        default:            stepBatchScalar(m_Lanes, m_Params, 0, end, ticks); break;
+    }
+}
+
+/**
+ * @brief AVX2 needs both the compiled kernel and CPU support; SSE2 is part of x86-64.
+ */
+bool BatchSimulation::supported(Backend backend) {
+    switch (backend) {
+        case Backend::Scalar: return true;
+        case Backend::Sse2:
+#ifdef PONG_BATCH_SSE2
+            return true;
+#else
+            return false;
+#endif
+        case Backend::Avx2:
+#if defined(PONG_BATCH_SSE2) && (defined(__GNUC__) || defined(__clang__))
+            return batchAvx2Compiled() && __builtin_cpu_supports("avx2");
+#else
+            return false;
+#endif
+        default: return true;
+    }
+}
+
+/**
+ * @brief Widest supported kernel.
+ */
+BatchSimulation::Backend BatchSimulation::bestBackend() {
+    if (supported(Backend::Avx2)) return Backend::Avx2;
+    if (supported(Backend::Sse2)) return Backend::Sse2;
+    return Backend::Scalar;
+}
+
+/**
+ * @brief Name used in tool output.
+ */
+const char* BatchSimulation::backendName(Backend backend) {
+    switch (backend) {
+        case Backend::Scalar: return "scalar";
+        case Backend::Sse2:   return "sse2";
+        case Backend::Avx2:   return "avx2";
+        default:              return "auto";
+    }
+}
+
+/**
+ * @brief Counts real (non-padding) matches that are over.
+ */
+std::size_t BatchSimulation::finishedCount() const {
+    return static_cast<std::size_t>(std::count_if(m_Lanes.done.begin(), m_Lanes.done.begin() + m_Count,
+                                                  [](std::int32_t d) { return d != 0; }));
+}
+
+/**
+ * @brief One match at a time with plain branches. This is the reference the vector
+ * kernels are checked against, so keep the arithmetic in the same order as BatchKernel.hpp.
+ */
+void stepBatchScalar(BatchLanes& L, const BatchParams& p, std::size_t begin, std::size_t end, int ticks) {
+    const bool multiplayer = p.mode == GameMode::Multiplayer;
+    const float halfBall = p.ballSize / 2.f;
+    const float halfBat = p.batWidth / 2.f;
+    const float rightMirror = 2.f * (p.width - p.ballSize);
+    const float face1 = p.height - 80.f;
+    const float face1Rest = p.height - 80.f - p.ballSize;
+    const float face2 = 20.f + p.batHeight;
+
+    for (std::size_t i = begin; i < end; ++i) {
+        float bx = L.ballX[i], by = L.ballY[i], dirX = L.dirX[i], dirY = L.dirY[i];
+        float bat1 = L.bat1X[i], bat2 = L.bat2X[i];
+        float move1 = L.botSpeed1[i] * p.dt, move2 = L.botSpeed2[i] * p.dt;
+
+        for (int t = 0; t < ticks && !L.done[i]; ++t) {
+            L.time[i] += p.dt;
+            L.ticks[i]++;
+
+            float target = bx + halfBall;
+            float centre = bat1 + halfBat;
+            bool left = target < centre - p.botDeadZone && !(bat1 < 0.f);
+            bool right = target > centre + p.botDeadZone && !(bat1 + p.batWidth > p.width);
+            if (left) bat1 = bat1 - move1;
+            if (right) bat1 = bat1 + move1;
+            if (multiplayer) {
+                centre = bat2 + halfBat;
+                left = target < centre - p.botDeadZone && !(bat2 < 0.f);
+                right = target > centre + p.botDeadZone && !(bat2 + p.batWidth > p.width);
+                if (left) bat2 = bat2 - move2;
+                if (right) bat2 = bat2 + move2;
+            }
+
+            float nx = bx + dirX * p.ballSpeed * p.dt;
+            float ny = by + dirY * p.ballSpeed * p.dt;
+
+            bool hitLeft = nx < 0.f;
+            bool hitRight = nx + p.ballSize > p.width;
+            if (hitLeft) nx = 0.f - nx;
+            if (hitRight) nx = rightMirror - nx;
+            if (hitLeft || hitRight) dirX = 0.f - dirX;
+
+            if (dirY > 0.f && by + p.ballSize <= face1 && ny + p.ballSize > face1 &&
+                nx < bat1 + p.batWidth && nx + p.ballSize > bat1) {
+                ny = face1Rest - ((ny + p.ballSize) - face1);
+                dirY = 0.f - dirY;
+                L.batHits[i]++;
+            }
+            if (multiplayer && dirY < 0.f && by >= face2 && ny < face2 &&
+                nx < bat2 + p.batWidth && nx + p.ballSize > bat2) {
+                ny = face2 + (face2 - ny);
+                dirY = 0.f - dirY;
+                L.batHits[i]++;
+            }
+
+            if (ny < 0.f) {
+                if (multiplayer) {
+                    L.score1[i]++;
+                    L.lives2[i]--;
+                    nx = p.width / 2.f;
+                    ny = p.height / 2.f;
+                } else {
+                    if (L.time[i] > p.serveDelay) L.score1[i]++;
+                    ny = 0.f - ny;
+                }
+                dirY = 0.f - dirY;
+            }
+            if (ny > p.height) {
+                L.lives1[i]--;
+                if (multiplayer) L.score2[i]++;
+                nx = p.width / 2.f;
+                ny = p.height / 2.f;
+                dirY = 0.f - dirY;
+            }
+
+            bx = nx;
+            by = ny;
+            if (L.lives1[i] < 1 || L.lives2[i] < 1)
+                L.done[i] = 1;
+        }
+
+        L.ballX[i] = bx;
+        L.ballY[i] = by;
+        L.dirX[i] = dirX;
+        L.dirY[i] = dirY;
+        L.bat1X[i] = bat1;
+        L.bat2X[i] = bat2;
+    }
+}
+
+#ifdef PONG_BATCH_SSE2
+
+namespace {
+
+/**
+ * @brief Four lanes per register; masks are all-ones float lanes.
+ */
+struct Sse2Ops {
+    using F = __m128;
+    using I = __m128i;
+    static constexpr std::size_t Width = 4;
+
+    static F set1(float v) { return _mm_set1_ps(v); }
+    static I set1i(std::int32_t v) { return _mm_set1_epi32(v); }
+    static F load(const float* p) { return _mm_loadu_ps(p); }
+    static I loadi(const std::int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(float* p, F v) { _mm_storeu_ps(p, v); }
+    static void storei(std::int32_t* p, I v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+
+    static F add(F a, F b) { return _mm_add_ps(a, b); }
+    static F sub(F a, F b) { return _mm_sub_ps(a, b); }
+    static F mul(F a, F b) { return _mm_mul_ps(a, b); }
+    static F lt(F a, F b) { return _mm_cmplt_ps(a, b); }
+    static F le(F a, F b) { return _mm_cmple_ps(a, b); }
+    static F gt(F a, F b) { return _mm_cmpgt_ps(a, b); }
+    static F ge(F a, F b) { return _mm_cmpge_ps(a, b); }
+    static F band(F a, F b) { return _mm_and_ps(a, b); }
+    static F bor(F a, F b) { return _mm_or_ps(a, b); }
+    /** @brief b with the lanes of a cleared. */
+    static F andnot(F a, F b) { return _mm_andnot_ps(a, b); }
+    static F select(F m, F a, F b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+    static bool any(F m) { return _mm_movemask_ps(m) != 0; }
+
+    static F eqi(I a, I b) { return _mm_castsi128_ps(_mm_cmpeq_epi32(a, b)); }
+    static F lti(I a, I b) { return _mm_castsi128_ps(_mm_cmplt_epi32(a, b)); }
+    /** @brief Adds one where the mask is set (a set mask lane is -1). */
+    static I inc(I a, F m) { return _mm_sub_epi32(a, _mm_castps_si128(m)); }
+    static I dec(I a, F m) { return _mm_add_epi32(a, _mm_castps_si128(m)); }
+};
+
+} // namespace
+
+void stepBatchSse2(BatchLanes& lanes, const BatchParams& params, std::size_t begin, std::size_t end, int ticks) {
+    stepBatchKernel<Sse2Ops>(lanes, params, begin, end, ticks);
+}
+
+#else
+
+void stepBatchSse2(BatchLanes& lanes, const BatchParams& params, std::size_t begin, std::size_t end, int ticks) {
+    stepBatchScalar(lanes, params, begin, end, ticks);
+}
+
+#endif
@@ -0,0 +1,73 @@
+/**
+ * @file BatchSimulationAvx2.cpp
+ * @brief AVX2 instantiation of the batch kernel; the only file built with -mavx2.
+ * @author Oussama Amara
+ * @date 2025-08-18
+ */
+
+#include "BatchSimulation.hpp"
+#include "BatchKernel.hpp"
+
+// BatchSimulation::step only calls into this file after checking that the CPU supports AVX2
+#ifdef __AVX2__
+#include <immintrin.h>
+
+namespace {
+
+/**
+ * @brief Eight lanes per register; masks are all-ones float lanes.
+ */
+struct Avx2Ops {
+    using F = __m256;
+    using I = __m256i;
+    static constexpr std::size_t Width = 8;
+
+    static F set1(float v) { return _mm256_set1_ps(v); }
+    static I set1i(std::int32_t v) { return _mm256_set1_epi32(v); }
+    static F load(const float* p) { return _mm256_loadu_ps(p); }
+    static I loadi(const std::int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void store(float* p, F v) { _mm256_storeu_ps(p, v); }
+    static void storei(std::int32_t* p, I v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+
+    static F add(F a, F b) { return _mm256_add_ps(a, b); }
+    static F sub(F a, F b) { return _mm256_sub_ps(a, b); }
+    static F mul(F a, F b) { return _mm256_mul_ps(a, b); }
+    static F lt(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static F le(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static F gt(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static F ge(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static F band(F a, F b) { return _mm256_and_ps(a, b); }
+    static F bor(F a, F b) { return _mm256_or_ps(a, b); }
+    /** @brief b with the lanes of a cleared. */
+    static F andnot(F a, F b) { return _mm256_andnot_ps(a, b); }
+    static F select(F m, F a, F b) { return _mm256_blendv_ps(b, a, m); }
+    static bool any(F m) { return _mm256_movemask_ps(m) != 0; }
+
+    static F eqi(I a, I b) { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)); }
+    static F lti(I a, I b) { return _mm256_castsi256_ps(_mm256_cmpgt_epi32(b, a)); }
+    /** @brief Adds one where the mask is set (a set mask lane is -1). */
+    static I inc(I a, F m) { return _mm256_sub_epi32(a, _mm256_castps_si256(m)); }
+    static I dec(I a, F m) { return _mm256_add_epi32(a, _mm256_castps_si256(m)); }
+};
+
+} // namespace
+
+bool batchAvx2Compiled() {
+    return true;
+}
+
+void stepBatchAvx2(BatchLanes& lanes, const BatchParams& params, std::size_t begin, std::size_t end, int ticks) {
+    stepBatchKernel<Avx2Ops>(lanes, params, begin, end, ticks);
+}
+
+#else
+
+bool batchAvx2Compiled() {
+    return false;
+}
+
+void stepBatchAvx2(BatchLanes& lanes, const BatchParams& params, std::size_t begin, std::size_t end, int ticks) {
+    stepBatchSse2(lanes, params, begin, end, ticks);
+}
+
+#endif
@@ -0,0 +1,233 @@
+/**
+ * @file ChaosSimulation.cpp
+ * @brief Implementation of the multi-ball mode.
+ * @author Oussama Amara
+ * @date 2025-08-23
+ */
+
+#include "ChaosSimulation.hpp"
+#include "FrameProfiler.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+/**
+ * @brief Same bats as multiplayer; the store and the scored list are sized for every ball
+ * up front so play never allocates. The balls are served by reset().
+ */
+ChaosSimulation::ChaosSimulation(Vec2 resolution, std::size_t ballCount, std::uint32_t seed,
+                                 Broadphase broadphase)
+    : m_Resolution(resolution),
+      m_Seed(seed),
+      m_BallCount(ballCount),
+      m_Broadphase(broadphase),
+      m_Entities(ballCount),
+      m_Bats{Bat(resolution.x / 2.f, resolution.y - 80.f), Bat(resolution.x / 2.f, 20.f)},
+      m_Grid(resolution, CellSize)
+{
+    m_Grid.resize(m_Entities.capacity());
+    m_Scored.reserve(ballCount);
+    reset();
+}
+
+/**
+ * @brief Adds a ball and places it in the grid.
+ */
+EntityHandle ChaosSimulation::serve(Vec2 position, Vec2 direction) {
+    EntityHandle h = m_Entities.spawn(EntityKind::Ball, position, Vec2{BallSize, BallSize},
+                                      Motion{direction, BallSpeed});
+    m_Grid.update(h.slot, m_Entities.bounds(m_Entities.indexOf(h)));
+    return h;
+}
+
+/**
+ * @brief Lays the balls out on a jittered lattice filling the band between the bats, each
+ * with its own direction.
+ */
+void ChaosSimulation::reset() {
+    m_Entities.clear();
+    m_Grid.resize(0);
+    m_Grid.resize(m_Entities.capacity());
+
+    std::mt19937 rng(m_Seed);
+    std::uniform_real_distribution<float> jitter(0.f, 2.f), dirX(-0.3f, 0.3f), dirY(0.1f, 0.3f);
+    // Spread the lattice over the whole band between the bats, never tighter than 14 px
+    const float top = 60.f, bottom = m_Resolution.y - 120.f;
+    const float area = m_Resolution.x * (bottom - top);
+    const float spacing = std::max(14.f, std::sqrt(area / static_cast<float>(std::max<std::size_t>(1, m_BallCount))));
+    const auto cols = std::max<std::size_t>(1, static_cast<std::size_t>(m_Resolution.x / spacing));
+    const auto rows = std::max<std::size_t>(1, static_cast<std::size_t>((bottom - top) / spacing));
+
+    for (std::size_t i = 0; i < m_BallCount; ++i) {
+        std::size_t slot = i % (cols * rows);
+        float x = spacing / 2.f + static_cast<float>(slot % cols) * spacing + jitter(rng);
+        float y = top + static_cast<float>(slot / cols) * spacing + jitter(rng);
+        float dx = dirX(rng);
+        float dy = dirY(rng);
+        serve(Vec2{x, y}, Vec2{dx, (rng() & 1) ? dy : -dy});
+    }
+    m_Score[0] = m_Score[1] = 0;
+    LOG_INFO("Chaos mode served {} balls", m_BallCount);
+}
+
+std::uint32_t ChaosSimulation::step(const TickInput& input, float dt) {
+    LOG_TRACE("Chaos tick");
+    std::uint32_t events = SimEvent::None;
+
+    GameSimulation::applyInput(m_Bats[0], input.players[0], m_Resolution.x);
+    GameSimulation::applyInput(m_Bats[1], input.players[1], m_Resolution.x);
+    {
+        ScopedTimer timer(Phase::BatUpdate);
+        m_Bats[0].update(dt);
+        m_Bats[1].update(dt);
+    }
+
+    const Aabb bats[] = {m_Bats[0].getGlobalBounds(), m_Bats[1].getGlobalBounds()};
+    // A ball travels up to BallSpeed * dt this tick, more than a cell at low tick rates, so
+    // each bat is marked with that reach around it: every ball able to get to it sees it
+    const float reach = BallSpeed * dt;
+    m_Grid.clearMarks();
+    for (int b = 0; b < 2; ++b)
+        m_Grid.mark(Aabb{bats[b].x - reach, bats[b].y - reach, bats[b].w + 2.f * reach, bats[b].h + 2.f * reach},
+                    static_cast<std::uint8_t>(1 << b));
+
+    // Walls and bats: only the bats marked around a ball take part in its sweep
+    const Arena arena{0.f, m_Resolution.x, 0.f, m_Resolution.y, false};
+    Contact contacts[Collision::MaxContacts];
+    m_Scored.clear();
+    {
+        ScopedTimer timer(Phase::BallUpdate);
+        for (std::size_t i = 0; i < m_Entities.size(); ++i) {
+            Transform& t = m_Entities.transform(i);
+            Motion& m = m_Entities.motion(i);
+            std::uint32_t slot = m_Entities.handleAt(i).slot;
+            std::uint8_t nearMask = m_Broadphase == Broadphase::Grid ? m_Grid.marksNear(slot) : 3;
+            Aabb nearBats[2];
+            int batCount = 0;
+            for (int b = 0; b < 2; ++b)
+                if (nearMask & (1 << b))
+                    nearBats[batCount++] = bats[b];
+
+            t.previous = t.position;
+            Aabb box = m_Entities.bounds(i);
+            Vec2 velocity{m.direction.x * m.speed, m.direction.y * m.speed};
+            int count = Collision::sweepBall(box, velocity, dt, arena, nearBats, batCount, contacts,
+                                             Collision::MaxContacts);
+            t.position = Vec2{box.x, box.y};
+            m.direction = Vec2{velocity.x / m.speed, velocity.y / m.speed};
+
+            for (int c = 0; c < count; ++c) {
+                switch (contacts[c].surface) {
+                    case Surface::Bat:
+                        events |= SimEvent::BatHit;
+                        break;
+                    case Surface::LeftWall:
+                    case Surface::RightWall:
+                        events |= SimEvent::WallHit;
+                        break;
+                    case Surface::BottomWall:
+                        m_Score[1]++;
+                        events |= SimEvent::Point2;
+                        m_Scored.push_back({m_Entities.handleAt(i), Vec2{m.direction.x, -m.direction.y}});
+                        break;
+                    case Surface::TopWall:
+                        m_Score[0]++;
+                        events |= SimEvent::Point1;
+                        m_Scored.push_back({m_Entities.handleAt(i), Vec2{m.direction.x, -m.direction.y}});
+                        break;
+                }
+            }
+            m_Grid.update(slot, box);
+        }
+    }
+
+    // Balls that left the field make room for new ones served from the centre
+    for (const auto& [handle, direction] : m_Scored) {
+        m_Grid.remove(handle.slot);
+        m_Entities.despawn(handle);
+        serve(Vec2{m_Resolution.x / 2.f, m_Resolution.y / 2.f}, direction);
+    }
+
+    // Ball against ball: each neighbouring pair once
+    m_PairTests = 0;
+    m_Separated = 0;
+    if (m_Broadphase == Broadphase::Grid) {
+        m_Grid.forEachPair([this](std::size_t a, std::size_t b) {
+            collideBalls(m_Entities.indexOfSlot(static_cast<std::uint32_t>(a)),
+                         m_Entities.indexOfSlot(static_cast<std::uint32_t>(b)));
+        });
+    } else {
+        for (std::size_t i = 0; i < m_Entities.size(); ++i)
+            for (std::size_t j = i + 1; j < m_Entities.size(); ++j)
+                collideBalls(i, j);
+    }
+    // Relinking while forEachPair walks the cell lists would break the walk, so balls that
+    // were pushed into another cell move there now
+    if (m_Separated > 0)
+        for (std::size_t i = 0; i < m_Entities.size(); ++i)
+            m_Grid.update(m_Entities.handleAt(i).slot, m_Entities.bounds(i));
+    return events;
+}
+
+/**
+ * @brief Separates two overlapping balls along the axis of least overlap and bounces
+ * them if they were moving towards each other on it. Both stay inside the field.
+ */
+void ChaosSimulation::collideBalls(std::size_t a, std::size_t b) {
+    ++m_PairTests;
+    const Aabb ra = m_Entities.bounds(a), rb = m_Entities.bounds(b);
+    float overlapX = std::min(ra.x + ra.w, rb.x + rb.w) - std::max(ra.x, rb.x);
+    float overlapY = std::min(ra.y + ra.h, rb.y + rb.h) - std::max(ra.y, rb.y);
+    if (overlapX <= 0.f || overlapY <= 0.f)
+        return;
+
+    Vec2& pa = m_Entities.transform(a).position;
+    Vec2& pb = m_Entities.transform(b).position;
+    Vec2& da = m_Entities.motion(a).direction;
+    Vec2& db = m_Entities.motion(b).direction;
+    if (overlapX < overlapY) {
+        float side = rb.x >= ra.x ? 1.f : -1.f; // +1 when b is to the right of a
+        pa.x -= side * overlapX / 2.f;
+        pb.x += side * overlapX / 2.f;
+        if (side * (da.x - db.x) > 0.f) {
+            da.x = -da.x;
+            db.x = -db.x;
+        }
+    } else {
+        float side = rb.y >= ra.y ? 1.f : -1.f; // +1 when b is below a
+        pa.y -= side * overlapY / 2.f;
+        pb.y += side * overlapY / 2.f;
+        if (side * (da.y - db.y) > 0.f) {
+            da.y = -da.y;
+            db.y = -db.y;
+        }
+    }
+    keepInField(a);
+    keepInField(b);
+    ++m_Separated;
+}
+
+/**
+ * @brief Moves a ball that separation pushed into a side wall or a bat back out of it.
+ * Out of a bat it goes along the axis of least overlap, or vertically when the other way
+ * would put it past a side wall; the sweep of the next tick starts from a free position.
+ */
+void ChaosSimulation::keepInField(std::size_t index) {
+    Vec2& p = m_Entities.transform(index).position;
+    const Vec2 size = m_Entities.size(index);
+    p.x = std::clamp(p.x, 0.f, m_Resolution.x - size.x);
+    p.y = std::clamp(p.y, 0.f, m_Resolution.y - size.y);
+    for (const Bat& bat : m_Bats) {
+        const Aabb r = bat.getGlobalBounds();
+        float overlapX = std::min(p.x + size.x, r.x + r.w) - std::max(p.x, r.x);
+        float overlapY = std::min(p.y + size.y, r.y + r.h) - std::max(p.y, r.y);
+        if (overlapX <= 0.f || overlapY <= 0.f)
+            continue;
+        float x = p.x + size.x / 2.f < r.x + r.w / 2.f ? r.x - size.x : r.x + r.w;
+        if (overlapX < overlapY && x >= 0.f && x + size.x <= m_Resolution.x)
+            p.x = x;
+        else
+            p.y = p.y + size.y / 2.f < r.y + r.h / 2.f ? r.y - size.y : r.y + r.h;
+    }
+}
@@ -0,0 +1,153 @@
+/**
+ * @file Collision.cpp
+ * @brief Implementation of swept AABB tests and multi-bounce ball resolution.
+ * @author Oussama Amara
+ * @date 2025-08-14
+ */
+
+#include "Collision.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace {
+constexpr float Infinity = std::numeric_limits<float>::infinity();
+
+/**
+ * @brief Entry and exit times of a moving interval against a static one along one axis.
+ */
+void axisTimes(float pos, float size, float delta, float targetPos, float targetSize, float& entry, float& exit) {
+    if (delta > 0.f) {
+        entry = (targetPos - (pos + size)) / delta;
+        exit = (targetPos + targetSize - pos) / delta;
+    } else if (delta < 0.f) {
+        entry = (targetPos + targetSize - pos) / delta;
+        exit = (targetPos - (pos + size)) / delta;
+    } else if (pos < targetPos + targetSize && pos + size > targetPos) {
+        entry = -Infinity;
+        exit = Infinity;
+    } else {
+        entry = Infinity;
+        exit = -Infinity;
+    }
+}
+
+/**
+ * @brief Time at which the ball reaches a wall plane while moving towards it, or a value above 1.
+ * @param edge Coordinate of the ball edge facing the wall.
+ * @param delta Displacement along the axis; only movement with the given sign counts.
+ */
+float wallTime(float edge, float plane, float delta, float sign) {
+    if (delta * sign <= 0.f)
+        return Infinity;
+    float t = (plane - edge) / delta;
+    return t < 0.f ? 0.f : t;
+}
+} // namespace
+
+namespace Collision {
+
+/**
+ * @brief Classic slab test on the Minkowski difference of both boxes.
+ */
+SweepHit sweepAabb(const Aabb& moving, Vec2 displacement, const Aabb& target) {
+    float xEntry, xExit, yEntry, yExit;
+    axisTimes(moving.x, moving.w, displacement.x, target.x, target.w, xEntry, xExit);
+    axisTimes(moving.y, moving.h, displacement.y, target.y, target.h, yEntry, yExit);
+
+    float entry = std::max(xEntry, yEntry);
+    float exit = std::min(xExit, yExit);
+
+    SweepHit result;
+    if (entry > exit || exit <= 0.f || entry >= 1.f)
+        return result;
+
+    if (entry < 0.f) {
+        // Already overlapping (e.g. a bat moved into the ball): push out along the axis of
+        // least penetration, and only if the ball is still moving into the target.
+        float penX = std::min(moving.x + moving.w, target.x + target.w) - std::max(moving.x, target.x);
+        float penY = std::min(moving.y + moving.h, target.y + target.h) - std::max(moving.y, target.y);
+        float dx = (moving.x + moving.w / 2.f) - (target.x + target.w / 2.f);
+        float dy = (moving.y + moving.h / 2.f) - (target.y + target.h / 2.f);
+        if (penY <= penX)
+            result.normal.y = dy < 0.f ? -1.f : 1.f;
+        else
+            result.normal.x = dx < 0.f ? -1.f : 1.f;
+        result.hit = displacement.x * result.normal.x + displacement.y * result.normal.y < 0.f;
+        result.time = 0.f;
+        return result;
+    }
+
+    result.hit = true;
+    result.time = entry;
+    if (xEntry > yEntry)
+        result.normal.x = displacement.x > 0.f ? -1.f : 1.f;
+    else
+        result.normal.y = displacement.y > 0.f ? -1.f : 1.f;
+    return result;
+}
+
+/**
+ * @brief Repeatedly finds the earliest contact in the remaining part of the step,
+ * advances to it and reflects, until the step is consumed or the ball leaves the field.
+ */
+int sweepBall(Aabb& ball, Vec2& velocity, float dt, const Arena& arena,
+              const Aabb* bats, int batCount, Contact* contacts, int maxContacts) {
+    int count = 0;
+    float elapsed = 0.f; // fraction of the step already simulated
+
+    while (elapsed < 1.f) {
+        float remaining = 1.f - elapsed;
+        Vec2 d{velocity.x * dt * remaining, velocity.y * dt * remaining};
+
+        // Earliest wall contact
+        float best = Infinity;
+        Surface surface = Surface::LeftWall;
+        Vec2 normal;
+        auto consider = [&](float t, Surface s, Vec2 n) {
+            if (t <= 1.f && t < best) {
+                best = t;
+                surface = s;
+                normal = n;
+            }
+        };
+        consider(wallTime(ball.x, arena.left, d.x, -1.f), Surface::LeftWall, {1.f, 0.f});
+        consider(wallTime(ball.x + ball.w, arena.right, d.x, 1.f), Surface::RightWall, {-1.f, 0.f});
+        consider(wallTime(ball.y, arena.top, d.y, -1.f), Surface::TopWall, {0.f, 1.f});
+        consider(wallTime(ball.y, arena.bottom, d.y, 1.f), Surface::BottomWall, {0.f, -1.f});
+
+        // Earliest bat contact
+        int batIndex = -1;
+        for (int i = 0; i < batCount; ++i) {
+            SweepHit hit = sweepAabb(ball, d, bats[i]);
+            if (hit.hit && hit.time < best) {
+                best = hit.time;
+                surface = Surface::Bat;
+                normal = hit.normal;
+                batIndex = i;
+            }
+        }
+
+        if (best > 1.f) {
+            ball.x += d.x;
+            ball.y += d.y;
+            break;
+        }
+
+        ball.x += d.x * best;
+        ball.y += d.y * best;
+        elapsed += remaining * best;
+        if (count == maxContacts)
+            break;
+        contacts[count++] = Contact{surface, surface == Surface::Bat ? batIndex : -1, elapsed, normal, {ball.x, ball.y}};
+
+        bool leaves = surface == Surface::BottomWall || (surface == Surface::TopWall && !arena.reflectTop);
+        if (leaves)
+            break;
+
+        if (normal.x != 0.f) velocity.x = -velocity.x;
+        if (normal.y != 0.f) velocity.y = -velocity.y;
+    }
+    return count;
+}
+
+} // namespace Collision
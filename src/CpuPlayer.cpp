@@ -0,0 +1,92 @@
+/**
+ * @file CpuPlayer.cpp
+ * @brief Implementation of the closed-form intercept prediction and the CPU player.
+ * @author Oussama Amara
+ * @date 2025-08-29
+ */
+
+#include "CpuPlayer.hpp"
+#include <algorithm>
+#include <cmath>
+
+bool CpuDifficulty::fromName(const std::string& name, CpuDifficulty& out) {
+    if (name == "easy")
+        out = CpuDifficulty{0.2f, 30.f};
+    else if (name == "normal")
+        out = CpuDifficulty{0.12f, 18.f};
+    else if (name == "hard")
+        out = CpuDifficulty{0.05f, 10.f};
+    else
+        return false;
+    return true;
+}
+
+CpuPlayer::CpuPlayer(int player, const CpuDifficulty& difficulty, std::uint32_t seed)
+    : m_Player(player), m_Difficulty(difficulty), m_Rng(seed), m_Error(0.f, std::max(difficulty.aimError, 0.f)) {}
+
+/**
+ * @brief Unrolls the side walls: the free horizontal travel is folded back into the
+ * field with a triangle wave of period 2 * (fieldWidth - ballWidth). A ball moving away
+ * first travels to @p turnY and back.
+ */
+float CpuPlayer::interceptX(const Ball& ball, float planeY, float turnY, float fieldWidth) {
+    const Aabb box = ball.getGlobalBounds();
+    const float dirX = ball.getXVelocity();
+    const float dirY = ball.getYVelocity();
+    if (dirY == 0.f)
+        return box.x;
+
+    float distance;
+    if ((planeY - box.y) * dirY > 0.f)
+        distance = std::fabs(planeY - box.y);
+    else
+        distance = std::fabs(turnY - box.y) + std::fabs(planeY - turnY);
+    const float free = box.x + dirX * distance / std::fabs(dirY);
+
+    const float span = fieldWidth - box.w;
+    if (span <= 0.f)
+        return 0.f;
+    float folded = std::fmod(free, 2.f * span);
+    if (folded < 0.f)
+        folded += 2.f * span;
+    return folded <= span ? folded : 2.f * span - folded;
+}
+
+/**
+ * @brief Looks at the ball once per reaction time and steers towards the latched target
+ * on every tick.
+ */
+PlayerInput CpuPlayer::input(const MatchState& state, float fieldWidth, float dt) {
+    const Aabb bat = state.bats[m_Player].getGlobalBounds();
+    const Aabb ball = state.ball.getGlobalBounds();
+
+    m_SinceLook += dt;
+    if (m_Target < 0.f || m_SinceLook >= m_Difficulty.reactionTime) {
+        m_SinceLook = 0.f;
+        // The ball touches the bottom bat with its bottom edge and the top bat with its top edge
+        float planeY, turnY;
+        if (m_Player == 0) {
+            planeY = bat.y - ball.h;
+            const Aabb other = state.bats[1].getGlobalBounds();
+            turnY = state.mode == GameMode::Multiplayer ? other.y + other.h : 0.f;
+        } else {
+            planeY = bat.y + bat.h;
+            turnY = state.bats[0].getGlobalBounds().y - ball.h;
+        }
+        const bool approaching = (planeY - ball.y) * state.ball.getYVelocity() > 0.f;
+        if (approaching && !m_Approaching)
+            m_Offset = m_Error(m_Rng);
+        m_Approaching = approaching;
+
+        const float aim = interceptX(state.ball, planeY, turnY, fieldWidth) + ball.w / 2.f + m_Offset;
+        m_Target = std::clamp(aim, bat.w / 2.f, std::max(bat.w / 2.f, fieldWidth - bat.w / 2.f));
+    }
+
+    // Stop within half a tick's travel of the target so the bat does not oscillate around it
+    const float centre = bat.x + bat.w / 2.f;
+    const float deadZone = state.bats[m_Player].getSpeed() * dt * 0.5f;
+    PlayerInput in;
+    in.left = m_Target < centre - deadZone;
+    in.right = m_Target > centre + deadZone;
+    return in;
+}
@@ -1,6 +1,6 @@
 /**
  * @file DisplayManager.cpp
- * @brief Implementation of DisplayManager class for rendering game elements and HUD.   
+ * @brief Implementation of DisplayManager class for rendering game elements and HUD.
  * Handles different game states like menu, single-player, and multiplayer.
  * Provides methods to render the game screen and update HUD elements.
  *  @author Oussama Amara
@@ -8,35 +8,72 @@
  * @version 1.0
  */
 #include "DisplayManager.hpp"
-#include <sstream>
+#include "FrameProfiler.hpp"
+#include "Hud.hpp"
+#include <cstdio>
 
 
 /**
  * @brief Constructor for DisplayManager.
- * Initializes HUD texts and their properties.
- *  @param font Reference to the font used for HUD texts.
+ * Sets the game mode text to display available game modes; the score HUD is drawn
+ * with seven-segment quads and does not use the font.
+ *  @param font Reference to the font used for the menu and the timing overlay.
  * @param resolution The resolution of the game window.
- * Initializes the HUD texts with their positions, sizes, and colors.
- * Sets the game mode text to display available game modes.
  */
-DisplayManager::DisplayManager(sf::Font& font, const sf::Vector2f& resolution) : hud_1(font, "", 25),
-      hud_2(font, "", 25),
-      GameMode(font, "1- Single player mode\n2- Multiplayer mode", 80){
-    
-    hud_1.setFont(font);
-    hud_2.setFont(font);
-    hud_1.setCharacterSize(25);
-    hud_2.setCharacterSize(25);
-    hud_1.setFillColor(sf::Color::White);
-    hud_2.setFillColor(sf::Color::White);
-    hud_1.setPosition(sf::Vector2f(20.f, resolution.y / 2.f));
-    hud_2.setPosition(sf::Vector2f(resolution.x - 200.f, resolution.y / 2.f));
+DisplayManager::DisplayManager(sf::Font& font, const sf::Vector2f& resolution) :
+      GameMode(font, std::string(Hud::MenuText), 80),
+      resolution(resolution),
+      scenes(Vec2{resolution.x, resolution.y}),
+      statsText(font, "", 22),
+      profilerText(font, "", 18){
 
     GameMode.setFont(font);
     GameMode.setCharacterSize(80);
     GameMode.setFillColor(sf::Color::White);
     GameMode.setPosition(sf::Vector2f(resolution.x / 2 - 400, resolution.y / 2 - 100));
-    GameMode.setString("1- Single player mode\n2- Multiplayer mode");
+    GameMode.setString(std::string(Hud::MenuText));
+
+    statsText.setFillColor(sf::Color::Green);
+    statsText.setPosition(sf::Vector2f(20.f, resolution.y - 40.f));
+
+    profilerText.setFillColor(sf::Color::Yellow);
+    profilerText.setPosition(sf::Vector2f(20.f, 20.f));
+
+    backend.setResource(MenuTextResource, GameMode);
+    backend.setResource(StatsTextResource, statsText);
+    backend.setResource(ProfilerTextResource, profilerText);
+    backend.setResource(StressBoxesResource, stressBatch);
+}
+
+/**
+ * @brief Adds the frame-timing table when it is switched on, then sorts, merges and draws
+ * the recorded commands.
+ * The table is rebuilt every 250 ms so the overlay itself barely shows up in the numbers.
+ * @param window Reference to the render window.
+ */
+void DisplayManager::submit(sf::RenderWindow& window) {
+    if (showProfiler) {
+        if (profilerRefresh.getElapsedTime() >= sf::milliseconds(250)) {
+            const std::string summary = FrameProfiler::instance().summary();
+            profilerText.setString(summary);
+            profilerVertices = RenderQueue::glyphVertices(summary);
+            profilerRefresh.restart();
+        }
+        queue.text(ProfilerTextResource, GameFont, profilerVertices, RenderLayer::Overlay);
+    }
+    backend.setTarget(window);
+    queue.submit(backend);
+}
+
+/**
+ * @brief Shows the finished frame; timed on its own because it includes the vsync wait.
+ * @param window Reference to the render window.
+ */
+void DisplayManager::present(sf::RenderWindow& window) {
+    ScopedTimer timer(Phase::Display);
+    window.display();
+    lastDrawCalls = backend.takeDrawCalls();
+    lastQuadRewrites = backend.takeRewrites();
 }
 /**
  * @brief Renders the menu screen.
@@ -45,9 +82,12 @@ DisplayManager::DisplayManager(sf::Font& font, const sf::Vector2f& resolution) :
  * Displays the menu options for the player.
  */
 void DisplayManager::renderMenu(sf::RenderWindow& window) {
-    window.clear();
-    window.draw(GameMode);
-    window.display();
+    {
+        ScopedTimer timer(Phase::Render);
+        scenes.recordMenu(queue);
+        submit(window);
+    }
+    present(window);
 }
 /**
  * @brief Renders the single-player game screen.
@@ -58,18 +98,16 @@ void DisplayManager::renderMenu(sf::RenderWindow& window) {
  * @param score Current score of the player.
  * @param lives Remaining lives of the player.
  * @param highScore1 High score for player 1.
+ * @param alpha Interpolation factor between the last two simulation ticks.
  * Displays the player's score, lives, and high score on the HUD.
  */
-void DisplayManager::renderSingleplayer(sf::RenderWindow& window, const Bat& bat, const Ball& ball, int score, int lives, int highScore1) {
-    std::stringstream ss;
-    ss << "Score:" << score << " Lives:" << lives << " High:" << highScore1;
-    hud_1.setString(ss.str());
-
-    window.clear();
-    window.draw(hud_1);
-    window.draw(bat.getShape());
-    window.draw(ball.getShape());
-    window.display();
+void DisplayManager::renderSingleplayer(sf::RenderWindow& window, const Bat& bat, const Ball& ball, int score, int lives, int highScore1, float alpha) {
+    {
+        ScopedTimer timer(Phase::Render);
+        scenes.recordSingleplayer(queue, bat, ball, score, lives, highScore1, alpha);
+        submit(window);
+    }
+    present(window);
 }
 
 /**
@@ -83,19 +121,65 @@ void DisplayManager::renderSingleplayer(sf::RenderWindow& window, const Bat& bat
  * @param lives1 Remaining lives of player 1.
  * @param score2 Current score of player 2.
  * @param lives2 Remaining lives of player 2.
+ * @param alpha Interpolation factor between the last two simulation ticks.
  */
-void DisplayManager::renderMultiplayer(sf::RenderWindow& window, const Bat& bat1, const Bat& bat2, const Ball& ball, int score1, int lives1, int score2, int lives2) {
-    std::stringstream ss1, ss2;
-    ss1 << "Score:" << score1 << " Lives:" << lives1;
-    ss2 << "Score:" << score2 << " Lives:" << lives2;
-    hud_1.setString(ss1.str());
-    hud_2.setString(ss2.str());
+void DisplayManager::renderMultiplayer(sf::RenderWindow& window, const Bat& bat1, const Bat& bat2, const Ball& ball, int score1, int lives1, int score2, int lives2, float alpha) {
+    {
+        ScopedTimer timer(Phase::Render);
+        scenes.recordMultiplayer(queue, bat1, bat2, ball, score1, lives1, score2, lives2, alpha);
+        submit(window);
+    }
+    present(window);
+}
 
-    window.clear();
-    window.draw(hud_1);
-    window.draw(hud_2);
-    window.draw(bat1.getShape());
-    window.draw(bat2.getShape());
-    window.draw(ball.getShape());
-    window.display();
+/**
+ * @brief Renders the multi-ball mode.
+ * Bats, balls and the HUD merge into one quad run, so the whole field is still one draw call.
+ * @param window Reference to the render window.
+ * @param chaos Multi-ball simulation to draw.
+ * @param alpha Interpolation factor between the last two simulation ticks.
+ */
+void DisplayManager::renderChaos(sf::RenderWindow& window, const ChaosSimulation& chaos, float alpha) {
+    {
+        ScopedTimer timer(Phase::Render);
+        scenes.recordChaos(queue, chaos, alpha);
+        submit(window);
+    }
+    present(window);
+}
+
+/**
+ * @brief Renders the stress scene: every box in one batch plus a statistics line.
+ * The batch only rewrites the boxes that moved, so it is recorded as a prebuilt mesh
+ * rather than as quads. The statistics are refreshed every 250 ms, like the timing overlay.
+ * @param window Reference to the render window.
+ * @param scene Boxes to draw.
+ */
+void DisplayManager::renderStress(sf::RenderWindow& window, const StressScene& scene) {
+    {
+        ScopedTimer timer(Phase::Render);
+        const std::vector<Aabb>& boxes = scene.boxes();
+        stressBatch.resize(boxes.size());
+        for (std::size_t i = 0; i < boxes.size(); ++i)
+            stressBatch.set(i, boxes[i]);
+        std::size_t moved = stressBatch.takeRewrites();
+
+        if (statsRefresh.getElapsedTime() >= sf::milliseconds(250)) {
+            const PhaseHistogram& frame = FrameProfiler::instance().histogram(Phase::Frame);
+            char line[160];
+            std::snprintf(line, sizeof line,
+                          "%zu entities  %zu moved  %zu draw calls  frame p50 %.2f ms  p99 %.2f ms",
+                          boxes.size(), moved, lastDrawCalls,
+                          frame.quantileNs(0.5) / 1e6, frame.quantileNs(0.99) / 1e6);
+            statsText.setString(line);
+            statsVertices = RenderQueue::glyphVertices(line);
+            statsRefresh.restart();
+        }
+
+        queue.clear();
+        queue.mesh(StressBoxesResource, boxes.size() * BatchRenderer::VerticesPerRect);
+        queue.text(StatsTextResource, GameFont, statsVertices, RenderLayer::Overlay);
+        submit(window);
+    }
+    present(window);
 }
@@ -0,0 +1,84 @@
+/**
+ * @file EntityStore.cpp
+ * @brief Implementation of the chunked entity store.
+ * @author Oussama Amara
+ * @date 2025-08-24
+ */
+
+#include "EntityStore.hpp"
+
+/**
+ * @brief Allocates the chunks and the slot tables for the whole capacity.
+ */
+EntityStore::EntityStore(std::size_t capacity) {
+    std::size_t chunks = (capacity + ChunkSize - 1) / ChunkSize;
+    m_Chunks.reserve(chunks);
+    for (std::size_t i = 0; i < chunks; ++i)
+        m_Chunks.push_back(std::make_unique<Chunk>());
+    std::size_t slots = chunks * ChunkSize;
+    m_DenseOfSlot.assign(slots, Dead);
+    m_Generation.assign(slots, 0);
+    m_FreeSlots.reserve(slots);
+    clear();
+}
+
+/**
+ * @brief Takes a free slot and writes the components at the end of the dense arrays.
+ */
+EntityHandle EntityStore::spawn(EntityKind kind, Vec2 position, Vec2 size, const Motion& motion,
+                                std::uint32_t color) {
+    if (m_FreeSlots.empty())
+        return EntityHandle{};
+    std::uint32_t slot = m_FreeSlots.back();
+    m_FreeSlots.pop_back();
+
+    std::size_t index = m_Size++;
+    Chunk& c = chunk(index);
+    std::size_t i = index & Mask;
+    c.transforms[i] = Transform{position, position};
+    c.motions[i] = motion;
+    c.sizes[i] = size;
+    c.renders[i] = RenderInfo{color, kind};
+    c.slots[i] = slot;
+    m_DenseOfSlot[slot] = static_cast<std::uint32_t>(index);
+    return EntityHandle{slot, m_Generation[slot]};
+}
+
+/**
+ * @brief Swap-removes the entity so the dense arrays stay packed.
+ */
+bool EntityStore::despawn(EntityHandle handle) {
+    if (!alive(handle))
+        return false;
+    std::size_t index = m_DenseOfSlot[handle.slot];
+    std::size_t last = --m_Size;
+    if (index != last) {
+        Chunk& to = chunk(index);
+        const Chunk& from = chunk(last);
+        std::size_t i = index & Mask, j = last & Mask;
+        to.transforms[i] = from.transforms[j];
+        to.motions[i] = from.motions[j];
+        to.sizes[i] = from.sizes[j];
+        to.renders[i] = from.renders[j];
+        to.slots[i] = from.slots[j];
+        m_DenseOfSlot[to.slots[i]] = static_cast<std::uint32_t>(index);
+    }
+    m_DenseOfSlot[handle.slot] = Dead;
+    ++m_Generation[handle.slot];
+    m_FreeSlots.push_back(handle.slot);
+    return true;
+}
+
+/**
+ * @brief Frees every slot; the lowest slots are handed out first afterwards.
+ */
+void EntityStore::clear() {
+    for (std::size_t i = 0; i < m_Size; ++i)
+        ++m_Generation[chunk(i).slots[i & Mask]];
+    m_Size = 0;
+    m_FreeSlots.clear();
+    for (std::size_t slot = m_DenseOfSlot.size(); slot-- > 0;) {
+        m_DenseOfSlot[slot] = Dead;
+        m_FreeSlots.push_back(static_cast<std::uint32_t>(slot));
+    }
+}
@@ -0,0 +1,77 @@
+/**
+ * @file FramePacer.cpp
+ * @brief Implementation of the hybrid sleep-then-spin frame pacer.
+ * @author Oussama Amara
+ * @date 2025-08-28
+ */
+
+#include "FramePacer.hpp"
+#include "FrameProfiler.hpp"
+#include <algorithm>
+#include <thread>
+
+namespace {
+constexpr FramePacer::Clock::duration MinSpinMargin = std::chrono::microseconds(200);
+constexpr FramePacer::Clock::duration MaxSpinMargin = std::chrono::milliseconds(4);
+
+std::uint64_t toNs(FramePacer::Clock::duration d) {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+}
+} // namespace
+
+FramePacer::FramePacer(double targetHz, bool profile) : m_Profile(profile) {
+    setTarget(targetHz);
+}
+
+void FramePacer::setTarget(double targetHz) {
+    m_TargetHz = std::max(0.0, targetHz);
+    m_Period = m_TargetHz > 0.0
+                   ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_TargetHz))
+                   : Clock::duration{0};
+    m_Started = false;
+}
+
+/**
+ * @brief Sleeps until the spin margin before the deadline, adjusts the margin from the
+ * oversleep, then yields until the deadline itself.
+ */
+void FramePacer::wait() {
+    if (m_Period.count() == 0)
+        return;
+    Clock::time_point now = Clock::now();
+    if (!m_Started) {
+        m_Started = true;
+        m_Deadline = now;
+        m_LastFrame = now;
+        return;
+    }
+
+    m_Deadline += m_Period;
+    if (now - m_Deadline > m_Period)
+        m_Deadline = now; // far behind: start a new grid rather than rushing to catch up
+
+    const Clock::time_point start = now;
+    Clock::duration remaining = m_Deadline - now;
+    if (remaining > m_SpinMargin) {
+        Clock::duration requested = remaining - m_SpinMargin;
+        std::this_thread::sleep_for(requested);
+        Clock::duration overshoot = (Clock::now() - now) - requested;
+        // Grow at once to twice the overshoot; shrink by 1/16 of the excess per frame
+        Clock::duration wanted = std::clamp(overshoot * 2, MinSpinMargin, MaxSpinMargin);
+        if (wanted > m_SpinMargin)
+            m_SpinMargin = wanted;
+        else
+            m_SpinMargin -= (m_SpinMargin - wanted) / 16;
+    }
+    while (Clock::now() < m_Deadline)
+        std::this_thread::yield();
+    now = Clock::now();
+
+    Clock::duration interval = now - m_LastFrame;
+    m_LastFrame = now;
+    if (m_Profile) {
+        FrameProfiler::instance().record(Phase::Pacing, toNs(now - start));
+        FrameProfiler::instance().record(Phase::FrameJitter,
+                                         toNs(interval > m_Period ? interval - m_Period : m_Period - interval));
+    }
+}
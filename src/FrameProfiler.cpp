@@ -0,0 +1,123 @@
+/**
+ * @file FrameProfiler.cpp
+ * @brief Implementation of the phase histograms and their reports.
+ * @author Oussama Amara
+ * @date 2025-08-21
+ */
+
+#include "FrameProfiler.hpp"
+#include <cstdio>
+
+const char* phaseName(Phase phase) {
+    static const char* const names[] = {"frame", "input", "simulation", "bat_update", "ball_update",
+                                        "collision", "render", "display", "log_write",
+                                        "pacing", "frame_jitter", "snapshot_age"};
+    int index = static_cast<int>(phase);
+    return index < static_cast<int>(Phase::Count) ? names[index] : "?";
+}
+
+/**
+ * @brief Values below 16 ns get one bucket each; above, the top bit selects the octave
+ * and the next four bits the sub-bucket.
+ */
+int PhaseHistogram::bucketOf(std::uint64_t ns) {
+    if (ns < SubBuckets)
+        return static_cast<int>(ns);
+    int msb = 63;
+    while (!(ns >> msb))
+        --msb;
+    int sub = static_cast<int>((ns >> (msb - 4)) & (SubBuckets - 1));
+    int bucket = (msb - 3) * SubBuckets + sub;
+    return bucket < Buckets ? bucket : Buckets - 1;
+}
+
+std::uint64_t PhaseHistogram::bucketUpperNs(int bucket) {
+    if (bucket < SubBuckets)
+        return static_cast<std::uint64_t>(bucket);
+    int msb = bucket / SubBuckets + 3;
+    std::uint64_t sub = static_cast<std::uint64_t>(bucket % SubBuckets);
+    return ((SubBuckets + sub + 1) << (msb - 4)) - 1;
+}
+
+void PhaseHistogram::record(std::uint64_t ns) {
+    m_Buckets[static_cast<std::size_t>(bucketOf(ns))].fetch_add(1, std::memory_order_relaxed);
+    m_Count.fetch_add(1, std::memory_order_relaxed);
+    m_Sum.fetch_add(ns, std::memory_order_relaxed);
+    std::uint64_t max = m_Max.load(std::memory_order_relaxed);
+    while (ns > max && !m_Max.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+    }
+}
+
+void PhaseHistogram::reset() {
+    for (auto& b : m_Buckets)
+        b.store(0, std::memory_order_relaxed);
+    m_Count.store(0, std::memory_order_relaxed);
+    m_Sum.store(0, std::memory_order_relaxed);
+    m_Max.store(0, std::memory_order_relaxed);
+}
+
+double PhaseHistogram::meanNs() const {
+    std::uint64_t n = count();
+    return n ? static_cast<double>(m_Sum.load(std::memory_order_relaxed)) / static_cast<double>(n) : 0.0;
+}
+
+/**
+ * @brief Walks the buckets until the requested share of samples is covered.
+ * Counts are read one by one while other threads record, so the answer is approximate.
+ */
+std::uint64_t PhaseHistogram::quantileNs(double q) const {
+    std::uint64_t total = 0;
+    for (const auto& b : m_Buckets)
+        total += b.load(std::memory_order_relaxed);
+    if (total == 0)
+        return 0;
+    auto rank = static_cast<std::uint64_t>(q * static_cast<double>(total - 1)) + 1;
+    std::uint64_t seen = 0;
+    for (int i = 0; i < Buckets; ++i) {
+        seen += m_Buckets[static_cast<std::size_t>(i)].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            std::uint64_t upper = bucketUpperNs(i), max = maxNs();
+            return max && max < upper ? max : upper;
+        }
+    }
+    return maxNs();
+}
+
+FrameProfiler& FrameProfiler::instance() {
+    static FrameProfiler profiler;
+    return profiler;
+}
+
+void FrameProfiler::reset() {
+    for (auto& p : m_Phases)
+        p.reset();
+}
+
+std::string FrameProfiler::summary() const {
+    std::string text = "phase           p50     p99     max (us)\n";
+    char line[96];
+    for (int i = 0; i < static_cast<int>(Phase::Count); ++i) {
+        const PhaseHistogram& h = m_Phases[static_cast<std::size_t>(i)];
+        if (h.count() == 0)
+            continue;
+        std::snprintf(line, sizeof line, "%-12s %7.1f %7.1f %7.1f\n", phaseName(static_cast<Phase>(i)),
+                      h.quantileNs(0.5) / 1000.0, h.quantileNs(0.99) / 1000.0, h.maxNs() / 1000.0);
+        text += line;
+    }
+    return text;
+}
+
+bool FrameProfiler::writeCsv(const std::string& path) const {
+    std::FILE* f = std::fopen(path.c_str(), "w");
+    if (!f)
+        return false;
+    std::fprintf(f, "phase,count,mean_us,p50_us,p90_us,p99_us,p999_us,max_us\n");
+    for (int i = 0; i < static_cast<int>(Phase::Count); ++i) {
+        const PhaseHistogram& h = m_Phases[static_cast<std::size_t>(i)];
+        std::fprintf(f, "%s,%llu,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n", phaseName(static_cast<Phase>(i)),
+                     static_cast<unsigned long long>(h.count()), h.meanNs() / 1000.0,
+                     h.quantileNs(0.5) / 1000.0, h.quantileNs(0.9) / 1000.0, h.quantileNs(0.99) / 1000.0,
+                     h.quantileNs(0.999) / 1000.0, h.maxNs() / 1000.0);
+    }
+    return std::fclose(f) == 0;
+}
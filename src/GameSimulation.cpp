@@ -0,0 +1,217 @@
+/**
+ * @file GameSimulation.cpp
+ * @brief Implementation of the headless Pong rules.
+ * @author Oussama Amara
+ * @date 2025-08-16
+ */
+
+#include "GameSimulation.hpp"
+#include "FrameProfiler.hpp"
+#include "Logger.hpp"
+#include "Trace.hpp"
+
+/**
+ * @brief Bottom bat for player 1, top bat for player 2, ball dropping from the top centre.
+ */
+GameSimulation::GameSimulation(Vec2 resolution)
+    : m_Resolution(resolution),
+      m_State{GameMode::Menu,
+              Ball(resolution.x / 2.f, 0.f, resolution),
+              {Bat(resolution.x / 2.f, resolution.y - 80.f), Bat(resolution.x / 2.f, 20.f)}}
+{
+}
+
+/**
+ * @brief Switches from the menu to a game mode.
+ */
+void GameSimulation::start(GameMode mode) {
+    setMode(mode);
+}
+
+/**
+ * @brief Shows the menu; the match is kept as is.
+ */
+void GameSimulation::returnToMenu() {
+    setMode(GameMode::Menu);
+}
+
+/**
+ * @brief Changes the screen and reports it.
+ */
+void GameSimulation::setMode(GameMode mode) {
+    m_State.mode = mode;
+    static const char* const names[] = {"MENU", "SINGLEPLAYER", "MULTIPLAYER"};
+    LOG_INFO("Game mode changed to {}", names[static_cast<int>(mode)]);
+    Trace::instance().record(TraceEvent::StateChange, 0.f, 0.f, 0.f, 0.f, static_cast<int>(mode));
+}
+
+/**
+ * @brief Turns held keys into bat movement, refusing to leave the field.
+ */
+void GameSimulation::applyInput(Bat& bat, const PlayerInput& input, float fieldWidth) {
+    Aabb bounds = bat.getGlobalBounds();
+
+    if (input.left) {
+        bat.moveLeft();
+        if (bounds.x < 0) bat.stopLeft();
+    } else bat.stopLeft();
+
+    if (input.right) {
+        bat.moveRight();
+        if (bounds.x + bounds.w > fieldWidth) bat.stopRight();
+    } else bat.stopRight();
+}
+
+/**
+ * @brief Advances the active mode by one tick.
+ */
+std::uint32_t GameSimulation::step(const TickInput& input, float dt) {
+    m_State.timeElapsed += dt;
+    Trace::instance().setFrame(++m_State.tick);
+
+    switch (m_State.mode) {
+        case GameMode::Singleplayer: return stepSingleplayer(input, dt);
+        case GameMode::Multiplayer:  return stepMultiplayer(input, dt);
+        default:                     return SimEvent::None;
+    }
+}
+
+/**
+ * @brief Single player: the top wall bounces and scores, the bottom costs a life.
+ */
+std::uint32_t GameSimulation::stepSingleplayer(const TickInput& input, float dt) {
+    LOG_TRACE("Singleplayer tick");
+    MatchState& s = m_State;
+    std::uint32_t events = SimEvent::None;
+
+    applyInput(s.bats[0], input.players[0], m_Resolution.x);
+    {
+        ScopedTimer timer(Phase::BatUpdate);
+        s.bats[0].update(dt);
+    }
+
+    // Swept collision: bounces off the walls and the bat happen inside Ball::update,
+    // the contacts tell us when the ball reached the top or left through the bottom.
+    Aabb bats[] = {s.bats[0].getGlobalBounds()};
+    Arena arena{0.f, m_Resolution.x, 0.f, m_Resolution.y, true};
+    Contact contacts[Collision::MaxContacts];
+    int contactCount;
+    {
+        ScopedTimer timer(Phase::BallUpdate);
+        contactCount = s.ball.update(dt, arena, bats, 1, contacts);
+    }
+
+    for (int c = 0; c < contactCount; ++c) {
+        switch (contacts[c].surface) {
+            case Surface::Bat:
+                events |= SimEvent::BatHit;
+                break;
+            case Surface::LeftWall:
+            case Surface::RightWall:
+                events |= SimEvent::WallHit;
+                break;
+            case Surface::TopWall:
+                events |= SimEvent::WallHit;
+                if (s.timeElapsed > ServeDelay) {
+                    s.score[0]++;
+                    events |= SimEvent::Point1;
+                    LOG_INFO("Player 1 scored — Score: {}", s.score[0]);
+                    Trace::instance().record(TraceEvent::Score, 0.f, 0.f, 0.f, 0.f, 1, s.score[0]);
+                }
+                break;
+            case Surface::BottomWall:
+                s.ball.reboundBottom();
+                s.lives[0]--;
+                events |= SimEvent::LifeLost1;
+                LOG_INFO("Ball hit bottom — Player 1 lives left: {}", s.lives[0]);
+                Trace::instance().record(TraceEvent::Lives, 0.f, 0.f, 0.f, 0.f, 1, s.lives[0]);
+                if (s.lives[0] < 1) {
+                    if (s.score[0] > s.highScore) {
+                        s.highScore = s.score[0];
+                        events |= SimEvent::HighScore;
+                        LOG_INFO("🎉 New High Score for Player 1: {}", s.highScore);
+                        Trace::instance().record(TraceEvent::HighScore, 0.f, 0.f, 0.f, 0.f, 1, s.highScore);
+                    }
+                    s.ball = Ball(m_Resolution.x / 2.f, m_Resolution.y / 2.f, m_Resolution);
+                    s.timeElapsed = 0;
+                    s.score[0] = 0;
+                    s.lives[0] = StartingLives;
+                    setMode(GameMode::Menu);
+                    return events | SimEvent::GameOver;
+                }
+                break;
+        }
+    }
+    return events;
+}
+
+/**
+ * @brief Multiplayer: leaving through the bottom scores for player 2, through the top for player 1.
+ */
+std::uint32_t GameSimulation::stepMultiplayer(const TickInput& input, float dt) {
+    LOG_TRACE("Multiplayer tick");
+    MatchState& s = m_State;
+    std::uint32_t events = SimEvent::None;
+
+    applyInput(s.bats[0], input.players[0], m_Resolution.x);
+    applyInput(s.bats[1], input.players[1], m_Resolution.x);
+    {
+        ScopedTimer timer(Phase::BatUpdate);
+        s.bats[0].update(dt);
+        s.bats[1].update(dt);
+    }
+
+    Aabb bats[] = {s.bats[0].getGlobalBounds(), s.bats[1].getGlobalBounds()};
+    Arena arena{0.f, m_Resolution.x, 0.f, m_Resolution.y, false};
+    Contact contacts[Collision::MaxContacts];
+    int contactCount;
+    {
+        ScopedTimer timer(Phase::BallUpdate);
+        contactCount = s.ball.update(dt, arena, bats, 2, contacts);
+    }
+
+    for (int c = 0; c < contactCount; ++c) {
+        switch (contacts[c].surface) {
+            case Surface::Bat:
+                events |= SimEvent::BatHit;
+                break;
+            case Surface::LeftWall:
+            case Surface::RightWall:
+                events |= SimEvent::WallHit;
+                break;
+            case Surface::BottomWall:
+                s.ball.reboundBottom();
+                s.lives[0]--;
+                s.score[1]++;
+                events |= SimEvent::LifeLost1 | SimEvent::Point2;
+                LOG_INFO("Player 2 scored — Player 1 lives: {}", s.lives[0]);
+                Trace::instance().record(TraceEvent::Score, 0.f, 0.f, 0.f, 0.f, 2, s.score[1]);
+                Trace::instance().record(TraceEvent::Lives, 0.f, 0.f, 0.f, 0.f, 1, s.lives[0]);
+                if (s.lives[0] < 1) {
+                    s.ball = Ball(m_Resolution.x / 2.f, m_Resolution.y / 2.f, m_Resolution);
+                    s.timeElapsed = 0;
+                    s.score[0] = s.score[1] = 0;
+                    s.lives[0] = s.lives[1] = StartingLives;
+                    setMode(GameMode::Menu);
+                    return events | SimEvent::GameOver;
+                }
+                break;
+            case Surface::TopWall:
+                s.ball.reboundBatOrTopMultiplayer();
+                s.score[0]++;
+                s.lives[1]--;
+                events |= SimEvent::Point1 | SimEvent::LifeLost2;
+                LOG_INFO("Player 1 scored — Player 2 lives: {}", s.lives[1]);
+                Trace::instance().record(TraceEvent::Score, 0.f, 0.f, 0.f, 0.f, 1, s.score[0]);
+                Trace::instance().record(TraceEvent::Lives, 0.f, 0.f, 0.f, 0.f, 2, s.lives[1]);
+                if (s.lives[1] < 1) {
+                    s.score[0] = s.score[1] = 0;
+                    s.lives[0] = s.lives[1] = StartingLives;
+                    setMode(GameMode::Menu);
+                    return events | SimEvent::GameOver;
+                }
+                break;
+        }
+    }
+    return events;
+}
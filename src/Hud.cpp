@@ -0,0 +1,161 @@
+/**
+ * @file Hud.cpp
+ * @brief Implementation of the HUD text formatting, the seven-segment layout and the dot-matrix text.
+ * @author Oussama Amara
+ * @date 2025-08-20
+ */
+
+#include "Hud.hpp"
+#include <sstream>
+
+namespace Hud {
+
+std::string singleplayer(int score, int lives, int highScore) {
+    std::stringstream ss;
+    ss << "Score:" << score << " Lives:" << lives << " High:" << highScore;
+    return ss.str();
+}
+
+std::string player(int score, int lives) {
+    std::stringstream ss;
+    ss << "Score:" << score << " Lives:" << lives;
+    return ss.str();
+}
+
+namespace {
+/** @brief Dot rows of a 5x7 cell, top row first; bit 4 is the leftmost dot. */
+using DotRows = std::array<std::uint8_t, 7>;
+
+/** @brief Dot-matrix shapes of the upper-case letters, the digits and a little punctuation. */
+constexpr std::array<DotRows, 128> makeDotTable() {
+    std::array<DotRows, 128> t{};
+    t['A'] = {0b01110, 0b10001, 0b10001, 0b11111, 0b10001, 0b10001, 0b10001};
+    t['B'] = {0b11110, 0b10001, 0b10001, 0b11110, 0b10001, 0b10001, 0b11110};
+    t['C'] = {0b01110, 0b10001, 0b10000, 0b10000, 0b10000, 0b10001, 0b01110};
+    t['D'] = {0b11110, 0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b11110};
+    t['E'] = {0b11111, 0b10000, 0b10000, 0b11110, 0b10000, 0b10000, 0b11111};
+    t['F'] = {0b11111, 0b10000, 0b10000, 0b11110, 0b10000, 0b10000, 0b10000};
+    t['G'] = {0b01110, 0b10001, 0b10000, 0b10111, 0b10001, 0b10001, 0b01111};
+    t['H'] = {0b10001, 0b10001, 0b10001, 0b11111, 0b10001, 0b10001, 0b10001};
+    t['I'] = {0b01110, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b01110};
+    t['J'] = {0b00111, 0b00010, 0b00010, 0b00010, 0b00010, 0b10010, 0b01100};
+    t['K'] = {0b10001, 0b10010, 0b10100, 0b11000, 0b10100, 0b10010, 0b10001};
+    t['L'] = {0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b11111};
+    t['M'] = {0b10001, 0b11011, 0b10101, 0b10101, 0b10001, 0b10001, 0b10001};
+    t['N'] = {0b10001, 0b10001, 0b11001, 0b10101, 0b10011, 0b10001, 0b10001};
+    t['O'] = {0b01110, 0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b01110};
+    t['P'] = {0b11110, 0b10001, 0b10001, 0b11110, 0b10000, 0b10000, 0b10000};
+    t['Q'] = {0b01110, 0b10001, 0b10001, 0b10001, 0b10101, 0b10010, 0b01101};
+    t['R'] = {0b11110, 0b10001, 0b10001, 0b11110, 0b10100, 0b10010, 0b10001};
+    t['S'] = {0b01111, 0b10000, 0b10000, 0b01110, 0b00001, 0b00001, 0b11110};
+    t['T'] = {0b11111, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100};
+    t['U'] = {0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b01110};
+    t['V'] = {0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b01010, 0b00100};
+    t['W'] = {0b10001, 0b10001, 0b10001, 0b10101, 0b10101, 0b10101, 0b01010};
+    t['X'] = {0b10001, 0b10001, 0b01010, 0b00100, 0b01010, 0b10001, 0b10001};
+    t['Y'] = {0b10001, 0b10001, 0b01010, 0b00100, 0b00100, 0b00100, 0b00100};
+    t['Z'] = {0b11111, 0b00001, 0b00010, 0b00100, 0b01000, 0b10000, 0b11111};
+    t['0'] = {0b01110, 0b10001, 0b10011, 0b10101, 0b11001, 0b10001, 0b01110};
+    t['1'] = {0b00100, 0b01100, 0b00100, 0b00100, 0b00100, 0b00100, 0b01110};
+    t['2'] = {0b01110, 0b10001, 0b00001, 0b00010, 0b00100, 0b01000, 0b11111};
+    t['3'] = {0b11111, 0b00010, 0b00100, 0b00010, 0b00001, 0b10001, 0b01110};
+    t['4'] = {0b00010, 0b00110, 0b01010, 0b10010, 0b11111, 0b00010, 0b00010};
+    t['5'] = {0b11111, 0b10000, 0b11110, 0b00001, 0b00001, 0b10001, 0b01110};
+    t['6'] = {0b00110, 0b01000, 0b10000, 0b11110, 0b10001, 0b10001, 0b01110};
+    t['7'] = {0b11111, 0b00001, 0b00010, 0b00100, 0b01000, 0b01000, 0b01000};
+    t['8'] = {0b01110, 0b10001, 0b10001, 0b01110, 0b10001, 0b10001, 0b01110};
+    t['9'] = {0b01110, 0b10001, 0b10001, 0b01111, 0b00001, 0b00010, 0b01100};
+    t['-'] = {0b00000, 0b00000, 0b00000, 0b11111, 0b00000, 0b00000, 0b00000};
+    t[':'] = {0b00000, 0b01100, 0b01100, 0b00000, 0b01100, 0b01100, 0b00000};
+    t['.'] = {0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b01100, 0b01100};
+    for (char c = 'a'; c <= 'z'; ++c)
+        t[static_cast<std::size_t>(c)] = t[static_cast<std::size_t>(c - 'a' + 'A')];
+    return t;
+}
+
+constexpr std::array<DotRows, 128> DotTable = makeDotTable();
+
+/** @brief A colon only takes a narrow cell. */
+float advance(char c, const SegmentStyle& style) {
+    return (glyph(c) == SegColon ? style.thickness : style.width) + style.spacing;
+}
+} // namespace
+
+float segmentWidth(std::string_view text, const SegmentStyle& style) {
+    float width = 0.f;
+    for (char c : text)
+        width += advance(c, style);
+    return text.empty() ? 0.f : width - style.spacing;
+}
+
+std::size_t appendSegments(std::vector<Aabb>& out, std::string_view text, float x, float y,
+                           const SegmentStyle& style) {
+    const float w = style.width, h = style.height, t = style.thickness;
+    const float half = h / 2.f;
+    const float bar = w - 2.f * t;           // horizontal segments sit between the verticals
+    const float post = half - 1.5f * t;      // vertical segments stop short of the bars
+    const std::size_t first = out.size();
+    for (char c : text) {
+        std::uint8_t s = glyph(c);
+        if (s & SegTop) out.push_back({x + t, y, bar, t});
+        if (s & SegMiddle) out.push_back({x + t, y + half - t / 2.f, bar, t});
+        if (s & SegBottom) out.push_back({x + t, y + h - t, bar, t});
+        if (s & SegUpperLeft) out.push_back({x, y + t, t, post});
+        if (s & SegUpperRight) out.push_back({x + w - t, y + t, t, post});
+        if (s & SegLowerLeft) out.push_back({x, y + half + t / 2.f, t, post});
+        if (s & SegLowerRight) out.push_back({x + w - t, y + half + t / 2.f, t, post});
+        if (s & SegColon) {
+            out.push_back({x, y + h / 3.f - t / 2.f, t, t});
+            out.push_back({x, y + 2.f * h / 3.f - t / 2.f, t, t});
+        }
+        x += advance(c, style);
+    }
+    return out.size() - first;
+}
+
+std::size_t appendHud(std::vector<Aabb>& out, std::string_view left, std::string_view right, Vec2 resolution,
+                      const SegmentStyle& style) {
+    const float y = resolution.y / 2.f;
+    std::size_t count = appendSegments(out, left, 20.f, y, style);
+    if (!right.empty())
+        count += appendSegments(out, right, resolution.x - 20.f - segmentWidth(right, style), y, style);
+    return count;
+}
+
+std::size_t appendPixelText(std::vector<Aabb>& out, std::string_view text, float x, float y,
+                            const PixelStyle& style) {
+    const float d = style.dot;
+    const std::size_t first = out.size();
+    float penX = x;
+    for (char c : text) {
+        if (c == '\n') {
+            penX = x;
+            y += 7.f * d + style.lineGap;
+            continue;
+        }
+        const auto index = static_cast<unsigned char>(c);
+        if (index < DotTable.size()) {
+            const DotRows& rows = DotTable[index];
+            for (int row = 0; row < 7; ++row) {
+                // One rectangle per run of lit dots
+                int col = 0;
+                while (col < 5) {
+                    if (!(rows[row] & (0x10 >> col))) {
+                        ++col;
+                        continue;
+                    }
+                    int end = col;
+                    while (end < 5 && (rows[row] & (0x10 >> end)))
+                        ++end;
+                    out.push_back({penX + static_cast<float>(col) * d, y + static_cast<float>(row) * d,
+                                   static_cast<float>(end - col) * d, d});
+                    col = end;
+                }
+            }
+        }
+        penX += 5.f * d + style.spacing;
+    }
+    return out.size() - first;
+}
+
+} // namespace Hud
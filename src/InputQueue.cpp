@@ -0,0 +1,126 @@
+/**
+ * @file InputQueue.cpp
+ * @brief Implementation of the timestamped input queue and its latency report.
+ * @author Oussama Amara
+ * @date 2025-08-27
+ */
+
+#include "InputQueue.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+InputQueue::InputQueue() {
+    m_Samples.reserve(MaxSamples);
+}
+
+std::uint64_t InputQueue::now() {
+    using namespace std::chrono;
+    return static_cast<std::uint64_t>(
+        duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+void InputQueue::push(InputKey key, bool pressed, std::uint64_t timeNs) {
+    std::size_t k = static_cast<std::size_t>(key);
+    if (m_Latest[k] == pressed)
+        return;
+    if (m_Count == Capacity) {
+        ++m_Dropped;
+        return;
+    }
+    m_Events[(m_Head + m_Count++) % Capacity] = InputEvent{timeNs, key, pressed};
+    m_Latest[k] = pressed;
+}
+
+void InputQueue::releaseAll(std::uint64_t timeNs) {
+    for (std::size_t k = 0; k < KeyCount; ++k)
+        push(static_cast<InputKey>(k), false, timeNs);
+}
+
+/**
+ * @brief Keys start the tick as they ended the last one; every press during the tick
+ * latches the key for the whole tick.
+ */
+TickInput InputQueue::consume(std::uint64_t tickEndNs, std::uint64_t nowNs) {
+    std::array<bool, KeyCount> down = m_Held;
+    while (m_Count > 0 && m_Events[m_Head].timeNs <= tickEndNs) {
+        const InputEvent& e = m_Events[m_Head];
+        std::size_t k = static_cast<std::size_t>(e.key);
+        m_Held[k] = e.pressed;
+        if (e.pressed) {
+            down[k] = true;
+            Sample sample{e.timeNs, nowNs, 0};
+            if (m_Samples.size() < MaxSamples)
+                m_Samples.push_back(sample);
+            else
+                m_Samples[m_NextSample] = sample;
+            m_NextSample = (m_NextSample + 1) % MaxSamples;
+            m_Unpresented = std::min(m_Unpresented + 1, MaxSamples);
+            ++m_Applied;
+        }
+        m_Head = (m_Head + 1) % Capacity;
+        --m_Count;
+    }
+
+    TickInput input;
+    input.players[0] = {down[0], down[1]};
+    input.players[1] = {down[2], down[3]};
+    return input;
+}
+
+/**
+ * @brief The unpresented samples are the last m_Unpresented applied, oldest first.
+ */
+void InputQueue::presented(std::uint64_t nowNs, std::uint64_t applied) {
+    for (; m_Unpresented > 0 && m_Applied - m_Unpresented < applied; --m_Unpresented)
+        m_Samples[(m_NextSample + MaxSamples - m_Unpresented) % MaxSamples].visibleNs = nowNs;
+}
+
+namespace {
+/** @brief Mean, median, 99th percentile and maximum of the values, in place. */
+void describe(std::vector<double>& values, double& mean, double& p50, double& p99, double& max) {
+    if (values.empty())
+        return;
+    std::sort(values.begin(), values.end());
+    double sum = 0;
+    for (double v : values)
+        sum += v;
+    mean = sum / static_cast<double>(values.size());
+    p50 = values[(values.size() - 1) / 2];
+    p99 = values[static_cast<std::size_t>(0.99 * static_cast<double>(values.size() - 1))];
+    max = values.back();
+}
+} // namespace
+
+InputLatencySummary InputQueue::summary() const {
+    InputLatencySummary s;
+    std::vector<double> applied, visible;
+    for (const Sample& sample : m_Samples) {
+        applied.push_back(static_cast<double>(sample.appliedNs - sample.pressNs) / 1000.0);
+        if (sample.visibleNs)
+            visible.push_back(static_cast<double>(sample.visibleNs - sample.pressNs) / 1000.0);
+    }
+    s.presses = applied.size();
+    describe(applied, s.appliedMean, s.appliedP50, s.appliedP99, s.appliedMax);
+    describe(visible, s.visibleMean, s.visibleP50, s.visibleP99, s.visibleMax);
+    return s;
+}
+
+bool InputQueue::writeCsv(const std::string& path) const {
+    std::FILE* f = std::fopen(path.c_str(), "w");
+    if (!f)
+        return false;
+    std::fprintf(f, "press_ns,applied_us,visible_us\n");
+    // Oldest first: once the ring is full it starts at the next slot to overwrite
+    std::size_t start = m_Samples.size() < MaxSamples ? 0 : m_NextSample;
+    for (std::size_t i = 0; i < m_Samples.size(); ++i) {
+        const Sample& s = m_Samples[(start + i) % m_Samples.size()];
+        std::fprintf(f, "%llu,%.1f,", static_cast<unsigned long long>(s.pressNs),
+                     static_cast<double>(s.appliedNs - s.pressNs) / 1000.0);
+        if (s.visibleNs)
+            std::fprintf(f, "%.1f\n", static_cast<double>(s.visibleNs - s.pressNs) / 1000.0);
+        else
+            std::fprintf(f, "\n");
+    }
+    return std::fclose(f) == 0;
+}
@@ -0,0 +1,429 @@
+/**
+ * @file Leaderboard.cpp
+ * @brief Implementation of the append-only score log, its recovery scan and compaction.
+ * @author Oussama Amara
+ * @date 2025-08-30
+ */
+
+#include "Leaderboard.hpp"
+#include "Logger.hpp"
+#include "MappedFile.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr std::uint16_t Version = 1;
+
+/** @brief CRC-32 (IEEE, reflected) lookup table. */
+std::array<std::uint32_t, 256> makeCrcTable() {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t c = i;
+        for (int k = 0; k < 8; ++k)
+            c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        table[i] = c;
+    }
+    return table;
+}
+
+/** @brief CRC-32 of everything in the frame after the checksum itself. */
+std::uint32_t frameCrc(const LeaderboardFrame& frame) {
+    static const std::array<std::uint32_t, 256> table = makeCrcTable();
+    const auto* p = reinterpret_cast<const std::uint8_t*>(&frame) + sizeof frame.crc;
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for (std::size_t i = 0; i < sizeof frame - sizeof frame.crc; ++i)
+        crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+LeaderboardFrame makeFrame(const MatchRecord& record, std::uint32_t sequence) {
+    LeaderboardFrame frame;
+    frame.sequence = sequence;
+    frame.record = record;
+    frame.crc = frameCrc(frame);
+    return frame;
+}
+
+LeaderboardHeader makeHeader() {
+    LeaderboardHeader header;
+    std::memcpy(header.magic, "PLBD", 4);
+    header.version = Version;
+    header.frameSize = sizeof(LeaderboardFrame);
+    return header;
+}
+
+/** @brief Pushes the file's data to the disk; fflush alone only reaches the OS. */
+bool syncFile(std::FILE* file) {
+    if (std::fflush(file) != 0)
+        return false;
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+/** @brief Replaces @p to with @p from in one step, even where rename() will not overwrite. */
+bool replaceFile(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+/**
+ * @brief Makes a rename in the file's directory durable. Windows has no equivalent;
+ * NTFS journals the rename itself.
+ */
+void syncDirectory(const std::string& path) {
+#ifndef _WIN32
+    std::size_t slash = path.rfind('/');
+    std::string dir = slash == std::string::npos ? "." : path.substr(0, slash + 1);
+    int fd = ::open(dir.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        ::close(fd);
+    }
+#else
+    (void)path;
+#endif
+}
+
+/** @brief Name stored in a record slot, which need not be NUL-terminated. */
+std::string slotName(const MatchRecord& record, int slot) {
+    const char* name = record.players[slot];
+    return std::string(name, strnlen(name, sizeof record.players[slot]));
+}
+
+bool validFrame(const LeaderboardFrame& frame, std::uint32_t sequence) {
+    return frame.crc == frameCrc(frame) && frame.sequence == sequence &&
+           frame.record.mode <= static_cast<std::uint8_t>(GameMode::Multiplayer);
+}
+} // namespace
+
+Leaderboard::Leaderboard(std::string path) : m_Path(std::move(path)) {
+    m_Writer = std::thread(&Leaderboard::run, this);
+}
+
+Leaderboard::~Leaderboard() {
+    {
+        std::lock_guard<std::mutex> lock(m_QueueMutex);
+        m_Stop = true;
+    }
+    m_QueueReady.notify_one();
+    m_Writer.join();
+    if (m_File)
+        std::fclose(m_File);
+}
+
+MatchRecord Leaderboard::makeRecord(GameMode mode, const std::string& player1, int score1,
+                                    const std::string& player2, int score2, float seconds) {
+    MatchRecord record;
+    record.time = static_cast<std::int64_t>(std::time(nullptr));
+    record.durationMs = static_cast<std::uint32_t>(std::max(0.f, seconds) * 1000.f);
+    record.mode = static_cast<std::uint8_t>(mode);
+    record.score[0] = score1;
+    record.score[1] = score2;
+    std::memcpy(record.players[0], player1.data(), std::min(player1.size(), MaxNameLength));
+    std::memcpy(record.players[1], player2.data(), std::min(player2.size(), MaxNameLength));
+    return record;
+}
+
+void Leaderboard::submit(const MatchRecord& record) {
+    {
+        std::lock_guard<std::mutex> lock(m_QueueMutex);
+        m_Queue.push_back(record);
+    }
+    m_QueueReady.notify_one();
+}
+
+void Leaderboard::flush() {
+    std::unique_lock<std::mutex> lock(m_QueueMutex);
+    m_QueueDrained.wait(lock, [this] { return m_Queue.empty() && !m_Busy; });
+}
+
+int Leaderboard::best(GameMode mode, const std::string& player) const {
+    std::lock_guard<std::mutex> lock(m_IndexMutex);
+    auto it = m_Index.best.find(BestKey{static_cast<std::uint8_t>(mode), player.substr(0, MaxNameLength)});
+    return it == m_Index.best.end() ? 0 : it->second;
+}
+
+std::vector<LeaderboardEntry> Leaderboard::top(GameMode mode) const {
+    std::lock_guard<std::mutex> lock(m_IndexMutex);
+    return m_Index.top[static_cast<int>(mode)];
+}
+
+std::vector<MatchRecord> Leaderboard::recent(std::size_t count) const {
+    std::lock_guard<std::mutex> lock(m_IndexMutex);
+    count = std::min(count, m_Index.history.size());
+    return std::vector<MatchRecord>(m_Index.history.rbegin(), m_Index.history.rbegin() + static_cast<std::ptrdiff_t>(count));
+}
+
+LeaderboardStats Leaderboard::stats() const {
+    std::lock_guard<std::mutex> lock(m_IndexMutex);
+    return m_Stats;
+}
+
+bool Leaderboard::healthy() const {
+    std::lock_guard<std::mutex> lock(m_IndexMutex);
+    return m_Healthy;
+}
+
+/**
+ * @brief Every named slot of the record competes for its mode's table and its player's best.
+ */
+void Leaderboard::Index::add(const MatchRecord& record) {
+    for (int slot = 0; slot < 2; ++slot) {
+        std::string name = slotName(record, slot);
+        if (name.empty())
+            continue;
+        int score = record.score[slot];
+        std::vector<LeaderboardEntry>& table = top[record.mode];
+        if (table.size() < TopK || score > table.back().score) {
+            auto at = std::upper_bound(table.begin(), table.end(), score,
+                                       [](int s, const LeaderboardEntry& e) { return s > e.score; });
+            table.insert(at, LeaderboardEntry{name, score, record.time});
+            if (table.size() > TopK)
+                table.pop_back();
+        }
+        auto [it, inserted] = best.emplace(BestKey{record.mode, std::move(name)}, score);
+        if (!inserted && score > it->second)
+            it->second = score;
+    }
+    history.push_back(record);
+    if (history.size() > HistoryKeep)
+        history.pop_front();
+}
+
+/**
+ * @brief Writer thread body: loads the log, then writes queued records in batches with
+ * one sync per batch.
+ */
+void Leaderboard::run() {
+    bool loaded = load();
+    {
+        std::lock_guard<std::mutex> lock(m_IndexMutex);
+        if (!loaded)
+            m_Healthy = false;
+        m_Stats.loaded = true;
+    }
+    m_Loaded.store(true, std::memory_order_release);
+    std::unique_lock<std::mutex> lock(m_QueueMutex);
+    m_Busy = false;
+    m_QueueDrained.notify_all();
+    for (;;) {
+        m_QueueReady.wait(lock, [this] { return m_Stop || !m_Queue.empty(); });
+        if (m_Queue.empty())
+            return;
+        std::vector<MatchRecord> batch;
+        batch.swap(m_Queue);
+        m_Busy = true;
+        lock.unlock();
+
+        if (!append(batch)) {
+            std::lock_guard<std::mutex> indexLock(m_IndexMutex);
+            for (const MatchRecord& record : batch)
+                m_Index.add(record);
+        }
+
+        lock.lock();
+        m_Busy = false;
+        m_QueueDrained.notify_all();
+    }
+}
+
+/**
+ * @brief Maps the log, indexes every valid record up to the first bad one, truncates what
+ * follows and opens the file for appending.
+ */
+bool Leaderboard::load() {
+    auto start = std::chrono::steady_clock::now();
+    std::remove((m_Path + ".tmp").c_str()); // left over by a compaction that never finished
+
+    MappedFile map;
+    if (!map.open(m_Path, MappedFile::Mode::ReadWrite)) {
+        LOG_ERROR("Leaderboard: cannot open {}", m_Path);
+        return false;
+    }
+    const LeaderboardHeader expected = makeHeader();
+    if (map.size() < sizeof expected) {
+        // New (or torn before its header was complete): start an empty log
+        if (!map.resize(sizeof expected)) {
+            LOG_ERROR("Leaderboard: cannot initialise {}", m_Path);
+            return false;
+        }
+        std::memcpy(map.data(), &expected, sizeof expected);
+        map.sync();
+    } else if (std::memcmp(map.data(), &expected, sizeof expected) != 0) {
+        LOG_ERROR("Leaderboard: {} is not a version {} score log; leaving it alone", m_Path, Version);
+        return false;
+    }
+
+    Index index;
+    std::size_t offset = sizeof expected;
+    std::uint32_t sequence = 0;
+    while (offset + sizeof(LeaderboardFrame) <= map.size()) {
+        LeaderboardFrame frame;
+        std::memcpy(&frame, map.data() + offset, sizeof frame);
+        if (!validFrame(frame, sequence))
+            break;
+        index.add(frame.record);
+        ++sequence;
+        offset += sizeof frame;
+    }
+    const std::size_t torn = map.size() - offset;
+    if (torn > 0) {
+        LOG_INFO("Leaderboard: dropping {} bytes of an incomplete record at the end of {}", torn, m_Path);
+        if (!map.resize(offset)) {
+            LOG_ERROR("Leaderboard: cannot truncate {}", m_Path);
+            return false;
+        }
+    }
+    map.close();
+
+    m_Sequence = sequence;
+    m_SinceCompact = sequence;
+    m_File = std::fopen(m_Path.c_str(), "ab");
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    {
+        std::lock_guard<std::mutex> lock(m_IndexMutex);
+        m_Index = std::move(index);
+        m_Stats.records = sequence;
+        m_Stats.tornBytes = torn;
+        m_Stats.loadMs = ms;
+    }
+    LOG_INFO("Leaderboard: {} records loaded from {} in {} ms", sequence, m_Path, ms);
+    if (!m_File) {
+        LOG_ERROR("Leaderboard: cannot append to {}", m_Path);
+        return false;
+    }
+    if (m_SinceCompact >= CompactThreshold)
+        compact();
+    return true;
+}
+
+/**
+ * @brief Writes the batch with one write and one sync; the records join the index only
+ * once they are durable. After a failed write the file is abandoned, since anything
+ * appended behind a torn record would be cut off at the next load.
+ */
+bool Leaderboard::append(const std::vector<MatchRecord>& records) {
+    if (!m_File)
+        return false;
+    std::vector<LeaderboardFrame> frames;
+    frames.reserve(records.size());
+    for (const MatchRecord& record : records)
+        frames.push_back(makeFrame(record, m_Sequence + static_cast<std::uint32_t>(frames.size())));
+
+    if (std::fwrite(frames.data(), sizeof(LeaderboardFrame), frames.size(), m_File) != frames.size() ||
+        !syncFile(m_File)) {
+        LOG_ERROR("Leaderboard: write to {} failed; scores are kept in memory only", m_Path);
+        std::fclose(m_File);
+        m_File = nullptr;
+        std::lock_guard<std::mutex> lock(m_IndexMutex);
+        m_Healthy = false;
+        return false;
+    }
+    m_Sequence += static_cast<std::uint32_t>(frames.size());
+    m_SinceCompact += frames.size();
+    {
+        std::lock_guard<std::mutex> lock(m_IndexMutex);
+        for (const MatchRecord& record : records)
+            m_Index.add(record);
+        m_Stats.records = m_Sequence;
+    }
+    if (m_SinceCompact >= CompactThreshold)
+        compact();
+    return true;
+}
+
+/**
+ * @brief Rewrites the log with only the records behind the index: every top-table entry,
+ * every player's best and the recent history, in their original order.
+ */
+bool Leaderboard::compact() {
+    Index keep;
+    {
+        std::lock_guard<std::mutex> lock(m_IndexMutex);
+        keep = m_Index;
+    }
+    std::fclose(m_File);
+    m_File = nullptr;
+
+    const std::string tmp = m_Path + ".tmp";
+    MappedFile map;
+    std::FILE* out = nullptr;
+    bool ok = map.open(m_Path, MappedFile::Mode::ReadOnly) && (out = std::fopen(tmp.c_str(), "wb")) != nullptr;
+    const LeaderboardHeader header = makeHeader();
+    ok = ok && std::fwrite(&header, sizeof header, 1, out) == 1;
+
+    std::uint32_t kept = 0;
+    const std::uint32_t total = m_Sequence;
+    for (std::uint32_t k = 0; ok && k < total; ++k) {
+        LeaderboardFrame frame;
+        std::memcpy(&frame, map.data() + sizeof header + static_cast<std::size_t>(k) * sizeof frame, sizeof frame);
+        const MatchRecord& record = frame.record;
+        bool wanted = k + HistoryKeep >= total;
+        for (int slot = 0; slot < 2; ++slot) {
+            std::string name = slotName(record, slot);
+            if (name.empty())
+                continue;
+            // Each table entry and best score claims the first record that matches it
+            auto it = keep.best.find(BestKey{record.mode, name});
+            if (it != keep.best.end() && it->second == record.score[slot]) {
+                keep.best.erase(it);
+                wanted = true;
+            }
+            std::vector<LeaderboardEntry>& table = keep.top[record.mode];
+            auto entry = std::find_if(table.begin(), table.end(), [&](const LeaderboardEntry& e) {
+                return e.score == record.score[slot] && e.time == record.time && e.player == name;
+            });
+            if (entry != table.end()) {
+                table.erase(entry);
+                wanted = true;
+            }
+        }
+        if (wanted) {
+            LeaderboardFrame copy = makeFrame(record, kept++);
+            ok = std::fwrite(&copy, sizeof copy, 1, out) == 1;
+        }
+    }
+    ok = ok && syncFile(out);
+    if (out)
+        ok = std::fclose(out) == 0 && ok;
+    map.close();
+    ok = ok && replaceFile(tmp, m_Path);
+    // A failed compaction is retried after another CompactThreshold records, not on every append
+    m_SinceCompact = 0;
+    if (ok) {
+        syncDirectory(m_Path);
+        m_Sequence = kept;
+        LOG_INFO("Leaderboard: compacted {} records into {}", total, kept);
+    } else {
+        std::remove(tmp.c_str());
+        LOG_ERROR("Leaderboard: compaction of {} failed; keeping the full log", m_Path);
+    }
+
+    m_File = std::fopen(m_Path.c_str(), "ab");
+    std::lock_guard<std::mutex> lock(m_IndexMutex);
+    if (ok) {
+        m_Stats.compactions++;
+        m_Stats.records = m_Sequence;
+    }
+    if (!m_File)
+        m_Healthy = false;
+    return ok;
+}
@@ -0,0 +1,301 @@
+/**
+ * @file Logger.cpp
+ * @brief Implementation of the asynchronous Logger: ring buffer, writer thread and deferred formatting.
+ * @author Oussama Amara
+ * @date 2025-07-27
+ */
+
+#include "Logger.hpp"
+#include "FrameProfiler.hpp"
+#include "Lz.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+namespace {
+/** @brief Textual tag written in front of each entry. */
+const char* levelTag(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace: return "[TRACE] ";
+        case LogLevel::Debug: return "[DEBUG] ";
+        case LogLevel::Info:  return "[INFO] ";
+        case LogLevel::Error: return "[ERROR] ";
+        default:              return "";
+    }
+}
+
+/** @brief Parses a level name as used by the PONG_LOG_LEVEL environment variable. */
+LogLevel parseLevel(const char* name, LogLevel fallback) {
+    if (!name) return fallback;
+    if (!std::strcmp(name, "trace")) return LogLevel::Trace;
+    if (!std::strcmp(name, "debug")) return LogLevel::Debug;
+    if (!std::strcmp(name, "info"))  return LogLevel::Info;
+    if (!std::strcmp(name, "error")) return LogLevel::Error;
+    if (!std::strcmp(name, "off"))   return LogLevel::Off;
+    return fallback;
+}
+} // namespace
+
+/**
+ * @brief Prepares the ring buffer and starts the writer thread. The file is only created
+ * by the first entry written, so a process that logs nothing leaves no empty game.log.
+ */
+Logger::Logger(const std::string& filename)
+    : m_Slots(new Slot[Capacity]), m_Filename(filename)
+{
+    for (std::size_t i = 0; i < Capacity; ++i)
+        m_Slots[i].sequence.store(i, std::memory_order_relaxed);
+    m_Writer = std::thread(&Logger::run, this);
+    m_Compressor = std::thread(&Logger::runCompressor, this);
+}
+
+/**
+ * @brief Stops the writer thread after it has drained the queue, then lets the
+ * compressor finish the files still waiting for it.
+ */
+Logger::~Logger() {
+    m_Running.store(false, std::memory_order_release);
+    if (m_Writer.joinable())
+        m_Writer.join();
+    if (m_File)
+        std::fclose(m_File);
+    {
+        std::lock_guard<std::mutex> lock(m_CompressMutex);
+        m_CompressorStop = true;
+    }
+    m_CompressReady.notify_one();
+    if (m_Compressor.joinable())
+        m_Compressor.join();
+    delete[] m_Slots;
+}
+
+/**
+ * @brief Returns the shared game logger.
+ */
+Logger& Logger::instance() {
+    static Logger logger;
+    static const bool configured = [] {
+        logger.setLevel(parseLevel(std::getenv("PONG_LOG_LEVEL"), LogLevel::Info));
+        logger.setRotation(8u << 20, 5);
+        return true;
+    }();
+    (void)configured;
+    return logger;
+}
+
+/**
+ * @brief Waits for the writer thread to catch up with every entry reserved so far.
+ */
+void Logger::flush() {
+    std::size_t target = m_Head.load(std::memory_order_acquire);
+    while (m_Written.load(std::memory_order_acquire) < target)
+        std::this_thread::yield();
+}
+
+/**
+ * @brief Reserves a free slot, or returns nullptr when the buffer is full.
+ */
+Logger::Slot* Logger::acquire() {
+    std::size_t pos = m_Head.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot* slot = &m_Slots[pos & (Capacity - 1)];
+        std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (m_Head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                return slot;
+        } else if (diff < 0) {
+            return nullptr;
+        } else {
+            pos = m_Head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Hands a filled slot over to the writer thread.
+ */
+void Logger::publish(Slot* slot) {
+    std::size_t seq = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(seq + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Writer thread body: drains the queue until shutdown.
+ */
+void Logger::run() {
+    while (m_Running.load(std::memory_order_acquire)) {
+        drain();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    drain();
+}
+
+/**
+ * @brief Formats and writes every published entry, then flushes the outputs once.
+ * The time a non-empty batch takes is reported to the frame profiler as log I/O.
+ */
+void Logger::drain() {
+    std::uint64_t start = FrameProfiler::instance().enabled() ? FrameProfiler::now() : 0;
+    bool wrote = false;
+    for (;;) {
+        Slot& slot = m_Slots[m_Tail & (Capacity - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != m_Tail + 1)
+            break;
+        write(slot.record);
+        slot.sequence.store(m_Tail + Capacity, std::memory_order_release);
+        ++m_Tail;
+        m_Written.store(m_Tail, std::memory_order_release);
+        wrote = true;
+    }
+    if (wrote) {
+        if (m_File) std::fflush(m_File);
+        if (m_ConsoleEcho.load(std::memory_order_relaxed)) std::fflush(stdout);
+        if (start)
+            FrameProfiler::instance().record(Phase::LogWrite, FrameProfiler::now() - start);
+    }
+}
+
+/**
+ * @brief Formats one entry and writes it to the file and, optionally, stdout.
+ */
+void Logger::write(const Record& rec) {
+    char line[512];
+    std::size_t length = format(rec, line, sizeof(line) - 1);
+    line[length++] = '\n';
+    if (!m_Opened) {
+        m_Opened = true;
+        openFile();
+    }
+    if (m_File) {
+        std::fwrite(line, 1, length, m_File);
+        m_FileSize += length;
+        std::size_t maxBytes = m_MaxBytes.load(std::memory_order_relaxed);
+        if (maxBytes && m_FileSize >= maxBytes)
+            rotate();
+    }
+    if (m_ConsoleEcho.load(std::memory_order_relaxed))
+        std::fwrite(line, 1, length, stdout);
+}
+
+/**
+ * @brief Builds "[timestamp] [LEVEL] message" with placeholders substituted.
+ * @return Number of characters written (not null-terminated).
+ */
+std::size_t Logger::format(const Record& rec, char* out, std::size_t size) {
+    using namespace std::chrono;
+    system_clock::time_point tp{system_clock::duration{rec.timestamp}};
+    std::time_t now = system_clock::to_time_t(tp);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    std::size_t n = 0;
+    out[n++] = '[';
+    n += std::strftime(out + n, size - n, "%Y-%m-%d %H:%M:%S", &local);
+    auto append = [&](const char* str, std::size_t length) {
+        if (length > size - n) length = size - n;
+        std::memcpy(out + n, str, length);
+        n += length;
+    };
+    append("] ", 2);
+    const char* tag = levelTag(rec.level);
+    append(tag, std::strlen(tag));
+
+    std::size_t argIndex = 0;
+    for (const char* p = rec.format; *p && n < size; ++p) {
+        if (p[0] == '{' && p[1] == '}' && argIndex < rec.argCount) {
+            const Arg& arg = rec.args[argIndex++];
+            char num[64];
+            int len = 0;
+            switch (arg.type) {
+                case Arg::Type::Int:    len = std::snprintf(num, sizeof(num), "%lld", arg.i); break;
+                case Arg::Type::UInt:   len = std::snprintf(num, sizeof(num), "%llu", arg.u); break;
+                case Arg::Type::Float:  len = std::snprintf(num, sizeof(num), "%f", arg.f); break;
+                case Arg::Type::String: append(rec.strings + arg.s.offset, arg.s.length); break;
+            }
+            if (len > 0) append(num, static_cast<std::size_t>(len));
+            ++p;
+        } else {
+            out[n++] = *p;
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief Opens the log file in append mode and records its current size.
+ */
+void Logger::openFile() {
+    m_File = std::fopen(m_Filename.c_str(), "a");
+    m_FileSize = 0;
+    if (m_File && std::fseek(m_File, 0, SEEK_END) == 0) {
+        long position = std::ftell(m_File);
+        m_FileSize = position > 0 ? static_cast<std::size_t>(position) : 0;
+    }
+}
+
+/**
+ * @brief Moves the full log aside and reopens an empty one (writer thread).
+ * Only a rename happens here; shifting generations and compression are left
+ * to the compressor thread so the writer never stalls on them.
+ */
+void Logger::rotate() {
+    std::fclose(m_File);
+    std::string rotated = m_Filename + ".rotating." + std::to_string(++m_RotationCount);
+    std::remove(rotated.c_str());
+    bool moved = std::rename(m_Filename.c_str(), rotated.c_str()) == 0;
+    openFile();
+    if (!moved)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(m_CompressMutex);
+        m_Pending.push_back(std::move(rotated));
+    }
+    m_CompressReady.notify_one();
+}
+
+/**
+ * @brief Compressor thread body: processes rotated files in rotation order.
+ */
+void Logger::runCompressor() {
+    std::unique_lock<std::mutex> lock(m_CompressMutex);
+    for (;;) {
+        m_CompressReady.wait(lock, [this] { return m_CompressorStop || !m_Pending.empty(); });
+        if (m_Pending.empty())
+            return;
+        std::string rotated = std::move(m_Pending.front());
+        m_Pending.pop_front();
+        lock.unlock();
+        compressRotated(rotated);
+        lock.lock();
+    }
+}
+
+/**
+ * @brief Shifts game.log.K.lz to K+1 (dropping the oldest) and compresses the
+ * rotated file into game.log.1.lz. Falls back to an uncompressed game.log.1.
+ */
+void Logger::compressRotated(const std::string& rotated) {
+    unsigned generations = m_Generations.load(std::memory_order_relaxed);
+    if (generations == 0) {
+        std::remove(rotated.c_str());
+        return;
+    }
+    auto generation = [this](unsigned index) {
+        return m_Filename + "." + std::to_string(index) + ".lz";
+    };
+    std::remove(generation(generations).c_str());
+    for (unsigned k = generations - 1; k >= 1; --k)
+        std::rename(generation(k).c_str(), generation(k + 1).c_str());
+
+    if (lz::compressFile(rotated, generation(1))) {
+        std::remove(rotated.c_str());
+    } else {
+        std::string fallback = m_Filename + ".1";
+        std::remove(fallback.c_str());
+        std::rename(rotated.c_str(), fallback.c_str());
+    }
+}
@@ -0,0 +1,170 @@
+/**
+ * @file Lz.cpp
+ * @brief Implementation of the LZ77 codec and its file container.
+ * @author Oussama Amara
+ * @date 2025-08-12
+ */
+
+#include "Lz.hpp"
+#include "MappedFile.hpp"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+constexpr std::size_t MinMatch = 4;
+constexpr std::size_t MaxOffset = 65535;
+constexpr int HashBits = 14;
+constexpr char Magic[4] = {'P', 'L', 'Z', '1'};
+
+std::uint32_t read32(const std::uint8_t* p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+std::uint32_t hash(std::uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - HashBits);
+}
+
+/** @brief Writes a length that did not fit in its 4-bit token nibble. */
+void writeLength(std::vector<std::uint8_t>& out, std::size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<std::uint8_t>(length));
+}
+
+/** @brief Reads a length extension; returns false on truncated input. */
+bool readLength(const std::uint8_t*& p, const std::uint8_t* end, std::size_t& length) {
+    std::uint8_t b;
+    do {
+        if (p == end) return false;
+        b = *p++;
+        length += b;
+    } while (b == 255);
+    return true;
+}
+
+/** @brief Emits one sequence; a zero match length marks the trailing literals. */
+void emit(std::vector<std::uint8_t>& out, const std::uint8_t* literals, std::size_t literalCount,
+          std::size_t offset, std::size_t matchLength) {
+    std::size_t matchCode = matchLength ? matchLength - MinMatch : 0;
+    std::uint8_t token = static_cast<std::uint8_t>((literalCount < 15 ? literalCount : 15) << 4);
+    token |= static_cast<std::uint8_t>(matchCode < 15 ? matchCode : 15);
+    out.push_back(token);
+    if (literalCount >= 15) writeLength(out, literalCount - 15);
+    out.insert(out.end(), literals, literals + literalCount);
+    if (!matchLength) return;
+    out.push_back(static_cast<std::uint8_t>(offset & 0xff));
+    out.push_back(static_cast<std::uint8_t>(offset >> 8));
+    if (matchCode >= 15) writeLength(out, matchCode - 15);
+}
+} // namespace
+
+namespace lz {
+
+/**
+ * @brief Greedy single-pass compressor with a 16K-entry hash of 4-byte sequences.
+ */
+std::vector<std::uint8_t> compress(const std::uint8_t* data, std::size_t size) {
+    std::vector<std::uint8_t> out;
+    out.reserve(size / 2 + 16);
+    std::vector<std::int64_t> table(std::size_t(1) << HashBits, -1);
+
+    std::size_t ip = 0, anchor = 0;
+    while (ip + MinMatch <= size) {
+        std::uint32_t sequence = read32(data + ip);
+        std::uint32_t h = hash(sequence);
+        std::int64_t ref = table[h];
+        table[h] = static_cast<std::int64_t>(ip);
+        if (ref >= 0 && ip - static_cast<std::size_t>(ref) <= MaxOffset && read32(data + ref) == sequence) {
+            std::size_t length = MinMatch;
+            while (ip + length < size && data[ref + length] == data[ip + length])
+                ++length;
+            emit(out, data + anchor, ip - anchor, ip - static_cast<std::size_t>(ref), length);
+            ip += length;
+            anchor = ip;
+        } else {
+            ++ip;
+        }
+    }
+    emit(out, data + anchor, size - anchor, 0, 0);
+    return out;
+}
+
+/**
+ * @brief Decodes sequences until the input is exhausted.
+ */
+bool decompress(const std::uint8_t* data, std::size_t size, std::vector<std::uint8_t>& out) {
+    const std::uint8_t* p = data;
+    const std::uint8_t* end = data + size;
+    while (p < end) {
+        std::uint8_t token = *p++;
+        std::size_t literalCount = token >> 4;
+        if (literalCount == 15 && !readLength(p, end, literalCount)) return false;
+        if (static_cast<std::size_t>(end - p) < literalCount) return false;
+        out.insert(out.end(), p, p + literalCount);
+        p += literalCount;
+        if (p == end) return true;
+
+        if (end - p < 2) return false;
+        std::size_t offset = p[0] | (static_cast<std::size_t>(p[1]) << 8);
+        p += 2;
+        std::size_t matchLength = token & 0x0f;
+        if (matchLength == 15 && !readLength(p, end, matchLength)) return false;
+        matchLength += MinMatch;
+        if (offset == 0 || offset > out.size()) return false;
+        std::size_t from = out.size() - offset;
+        for (std::size_t i = 0; i < matchLength; ++i)
+            out.push_back(out[from + i]);
+    }
+    return true;
+}
+
+/**
+ * @brief Maps the source file, compresses it and writes header plus stream.
+ */
+bool compressFile(const std::string& source, const std::string& destination) {
+    MappedFile input;
+    if (!input.open(source, MappedFile::Mode::ReadOnly))
+        return false;
+    std::vector<std::uint8_t> packed = compress(input.data(), input.size());
+
+    std::FILE* file = std::fopen(destination.c_str(), "wb");
+    if (!file)
+        return false;
+    std::uint64_t rawSize = input.size();
+    bool ok = std::fwrite(Magic, 1, sizeof(Magic), file) == sizeof(Magic)
+           && std::fwrite(&rawSize, sizeof(rawSize), 1, file) == 1
+           && std::fwrite(packed.data(), 1, packed.size(), file) == packed.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+/**
+ * @brief Checks the container header, decodes the stream and verifies its size.
+ */
+bool decompressFile(const std::string& source, const std::string& destination) {
+    MappedFile input;
+    if (!input.open(source, MappedFile::Mode::ReadOnly) || input.size() < 12
+        || std::memcmp(input.data(), Magic, sizeof(Magic)) != 0)
+        return false;
+    std::uint64_t rawSize;
+    std::memcpy(&rawSize, input.data() + 4, sizeof(rawSize));
+    // No stream byte expands to more than 255 output bytes; a larger size is a damaged header
+    if (rawSize / 255 > input.size() - 12)
+        return false;
+
+    std::vector<std::uint8_t> raw;
+    raw.reserve(static_cast<std::size_t>(rawSize));
+    if (!decompress(input.data() + 12, input.size() - 12, raw) || raw.size() != rawSize)
+        return false;
+
+    std::FILE* file = std::fopen(destination.c_str(), "wb");
+    if (!file)
+        return false;
+    bool ok = std::fwrite(raw.data(), 1, raw.size(), file) == raw.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+} // namespace lz
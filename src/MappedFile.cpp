@@ -0,0 +1,172 @@
+/**
+ * @file MappedFile.cpp
+ * @brief Implementation of MappedFile for POSIX and Windows.
+ * @author Oussama Amara
+ * @date 2025-08-10
+ */
+
+#include "MappedFile.hpp"
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        m_Data = std::exchange(other.m_Data, nullptr);
+        m_Size = std::exchange(other.m_Size, 0);
+        m_Mode = other.m_Mode;
+        m_Handle = std::exchange(other.m_Handle, InvalidHandle);
+        m_Mapping = std::exchange(other.m_Mapping, 0);
+    }
+    return *this;
+}
+
+/**
+ * @brief Opens the file, optionally sizes it, and maps it.
+ */
+bool MappedFile::open(const std::string& path, Mode mode, std::size_t size) {
+    close();
+    m_Mode = mode;
+#ifdef _WIN32
+    DWORD access = mode == Mode::ReadWrite ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ;
+    DWORD creation = mode == Mode::ReadWrite ? OPEN_ALWAYS : OPEN_EXISTING;
+    HANDLE file = CreateFileA(path.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              creation, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    m_Handle = reinterpret_cast<std::intptr_t>(file);
+    LARGE_INTEGER current;
+    GetFileSizeEx(file, &current);
+    m_Size = static_cast<std::size_t>(current.QuadPart);
+#else
+    int fd = ::open(path.c_str(), mode == Mode::ReadWrite ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+    if (fd < 0)
+        return false;
+    m_Handle = fd;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close();
+        return false;
+    }
+    m_Size = static_cast<std::size_t>(st.st_size);
+#endif
+    if (mode == Mode::ReadWrite && size != 0)
+        return resize(size);
+    if (!map()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Unmaps, changes the file length and maps it again.
+ */
+bool MappedFile::resize(std::size_t size) {
+    if (m_Mode != Mode::ReadWrite || m_Handle == InvalidHandle)
+        return false;
+    unmap();
+#ifdef _WIN32
+    HANDLE file = reinterpret_cast<HANDLE>(m_Handle);
+    LARGE_INTEGER length;
+    length.QuadPart = static_cast<LONGLONG>(size);
+    if (!SetFilePointerEx(file, length, nullptr, FILE_BEGIN) || !SetEndOfFile(file))
+        return false;
+#else
+    if (ftruncate(static_cast<int>(m_Handle), static_cast<off_t>(size)) != 0)
+        return false;
+#endif
+    m_Size = size;
+    return map();
+}
+
+/**
+ * @brief Schedules dirty pages for write-back.
+ */
+void MappedFile::sync() {
+    if (!m_Data)
+        return;
+#ifdef _WIN32
+    FlushViewOfFile(m_Data, 0);
+#else
+    msync(m_Data, m_Size, MS_ASYNC);
+#endif
+}
+
+/**
+ * @brief Releases the mapping and the file handle.
+ */
+void MappedFile::close() {
+    unmap();
+    if (m_Handle != InvalidHandle) {
+#ifdef _WIN32
+        CloseHandle(reinterpret_cast<HANDLE>(m_Handle));
+#else
+        ::close(static_cast<int>(m_Handle));
+#endif
+        m_Handle = InvalidHandle;
+    }
+    m_Size = 0;
+}
+
+/**
+ * @brief Maps the current file length; an empty file maps to nullptr.
+ */
+bool MappedFile::map() {
+    if (m_Size == 0)
+        return true;
+#ifdef _WIN32
+    bool writable = m_Mode == Mode::ReadWrite;
+    HANDLE mapping = CreateFileMappingA(reinterpret_cast<HANDLE>(m_Handle), nullptr,
+                                        writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+        return false;
+    void* view = MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, m_Size);
+    if (!view) {
+        CloseHandle(mapping);
+        return false;
+    }
+    m_Mapping = reinterpret_cast<std::intptr_t>(mapping);
+    m_Data = static_cast<std::uint8_t*>(view);
+#else
+    int prot = m_Mode == Mode::ReadWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* view = mmap(nullptr, m_Size, prot, MAP_SHARED, static_cast<int>(m_Handle), 0);
+    if (view == MAP_FAILED)
+        return false;
+    m_Data = static_cast<std::uint8_t*>(view);
+#endif
+    return true;
+}
+
+/**
+ * @brief Removes the current mapping, if any.
+ */
+void MappedFile::unmap() {
+    if (!m_Data)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(m_Data);
+    CloseHandle(reinterpret_cast<HANDLE>(m_Mapping));
+    m_Mapping = 0;
+#else
+    munmap(m_Data, m_Size);
+#endif
+    m_Data = nullptr;
+}
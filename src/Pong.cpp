@@ -1,236 +1,625 @@
 /**
  * @file Pong.cpp
  * @brief Main entry point for the Pong game using SFML.
- * Handles game loop, rendering, input management, and transitions between menu, single-player, and multiplayer modes.
+ * Handles the game loop, window events, keyboard input and rendering; the game rules
+ * themselves run in GameSimulation.
  * @author Oussama Amara
  * @date 2025-07-27
  */
 
-#include "Bat.hpp"
-#include "Ball.hpp"
+#include "AssetBundle.hpp"
+#include "ChaosSimulation.hpp"
+#include "CpuPlayer.hpp"
 #include "DisplayManager.hpp"
+#include "FramePacer.hpp"
+#include "FrameProfiler.hpp"
+#include "GameSimulation.hpp"
+#include "InputQueue.hpp"
+#include "Leaderboard.hpp"
 #include "Logger.hpp"
+#include "Replay.hpp"
+#include "Rollback.hpp"
+#include "SimulationThread.hpp"
+#include "SpectatorFeed.hpp"
+#include "StartupProfiler.hpp"
+#include "StressScene.hpp"
+#include "Trace.hpp"
 #include <SFML/Graphics.hpp>
 #include <sstream>
 #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <cstdlib>
+#include <future>
+#include <optional>
+#include <string>
 
-int main() {
-    Logger log;
-    log.info("Game starting...");
-    int high_score_1 = 0;
-    enum class State { MENU, SINGLEPLAYER, MULTIPLAYER };
-    State state = State::MENU;
-    log.info("Initial game state: MENU");
+namespace {
+/** @brief Name of the HUD font in the asset bundle and under the executable's directory. */
+constexpr const char* FontAsset = "fonts/DS-DIGI.TTF";
+
+/**
+ * @brief Loads the font from the asset bundle, or from the loose file when there is no
+ * usable bundle (a build without pongpack): first next to the executable, then in the
+ * working directory. The bundle stays mapped because SFML reads the font from it.
+ */
+bool loadAssets(const std::string& bundlePath, const std::string& exeDir, AssetBundle& bundle, sf::Font& font) {
+    if (bundle.open(bundlePath)) {
+        const AssetBundle::Asset asset = bundle.find(FontAsset);
+        if (asset && font.openFromMemory(asset.data, asset.size)) {
+            LOG_INFO("Assets: {} from {}", FontAsset, bundlePath);
+            return true;
+        }
+        LOG_ERROR("Asset bundle {} has no usable {}", bundlePath, FontAsset);
+    }
+    for (const std::string& dir : {exeDir, std::string()}) {
+        if (font.openFromFile(dir + FontAsset)) {
+            LOG_INFO("Assets: {}{} (no bundle at {})", dir, FontAsset, bundlePath);
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    // Every startup phase is timed from here to the first frame on screen
+    StartupProfiler::instance();
+    {
+        StartupTimer timer("logger");
+        LOG_INFO("Game starting...");
+    }
+    // Command-line options:
+    //   --trace <file>   records a binary trace (decode with pongtrace)
+    //   --tickrate <hz>  simulation rate, independent of the display refresh rate
+    //   --profile-csv <file>  where per-phase frame timings are written on exit
+    //   --input-report <file> writes the latency of every key press as CSV on exit
+    //   --stress <n>     draws n moving boxes instead of the game to measure the renderer
+    //   --balls <n>      number of balls in chaos mode (menu option 3)
+    //   --cpu <level>    CPU opponent difficulty for menu option 4: easy, normal or hard
+    //   --player <name>  name player 1's scores are kept under (default "Player 1")
+    //   --scores <file>  persistent leaderboard and match history (default scores.db)
+    //   --record <file>  records the inputs of the session for bit-exact replay
+    //   --replay <file>  plays a recording back (Space pause, F fast-forward, Left/Right seek)
+    //   --host <port>    waits for a remote player and plays the bottom bat over UDP
+    //   --connect <host>:<port>  joins a hosted match and plays the top bat
+    //   --fps <hz>       frame rate cap (0 = unlimited); 240 by default, off with --vsync
+    //   --vsync          lets the display's refresh rate pace the frames
+    //   --sim-thread     runs the simulation on its own thread; rendering draws its snapshots
+    //   --feed <name>    publishes every tick to a shared-memory ring for local observers (pongfeed)
+    //   --assets <file>  asset bundle to load (default: assets.pak next to the executable)
+    //   --startup-only   exits after the first frame, to time cold starts (see the startup report in game.log)
+    float tickRate = 240.f;
+    std::string recordPath;
+    std::string replayPath;
+    int hostPort = -1;
+    std::string connectTo;
+    std::string profileCsv = "frame_profile.csv";
+    std::string inputReport;
+    std::size_t stressCount = 0;
+    std::size_t chaosBalls = 500;
+    CpuDifficulty cpuDifficulty;
+    std::string playerName = "Player 1";
+    std::string scoresPath = "scores.db";
+    double targetFps = -1.0;
+    bool vsync = false;
+    bool simThreaded = false;
+    std::string feedName;
+    const std::string exeDir = AssetBundle::executableDir(argc > 0 ? argv[0] : nullptr);
+    std::string assetsPath = exeDir + "assets.pak";
+    bool startupOnly = false;
+    std::optional<StartupTimer> optionsTimer(std::in_place, "options");
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--tickrate" && i + 1 < argc) {
+            tickRate = std::max(1.f, static_cast<float>(std::atof(argv[++i])));
+            LOG_INFO("Simulation tick rate set to {} Hz", tickRate);
+        } else if (arg == "--stress" && i + 1 < argc) {
+            stressCount = static_cast<std::size_t>(std::max(0, std::atoi(argv[++i])));
+        } else if (arg == "--balls" && i + 1 < argc) {
+            chaosBalls = static_cast<std::size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (arg == "--cpu" && i + 1 < argc) {
+            if (!CpuDifficulty::fromName(argv[++i], cpuDifficulty))
+                LOG_ERROR("Unknown CPU level {}; using normal", argv[i]);
+        } else if (arg == "--player" && i + 1 < argc) {
+            playerName = argv[++i];
+        } else if (arg == "--scores" && i + 1 < argc) {
+            scoresPath = argv[++i];
+        } else if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (arg == "--host" && i + 1 < argc) {
+            hostPort = std::atoi(argv[++i]);
+        } else if (arg == "--connect" && i + 1 < argc) {
+            connectTo = argv[++i];
+        } else if (arg == "--fps" && i + 1 < argc) {
+            targetFps = std::max(0.0, std::atof(argv[++i]));
+        } else if (arg == "--vsync") {
+            vsync = true;
+        } else if (arg == "--sim-thread") {
+            simThreaded = true;
+        } else if (arg == "--feed" && i + 1 < argc) {
+            feedName = argv[++i];
+        } else if (arg == "--assets" && i + 1 < argc) {
+            assetsPath = argv[++i];
+        } else if (arg == "--startup-only") {
+            startupOnly = true;
+        } else if (arg == "--profile-csv" && i + 1 < argc) {
+            profileCsv = argv[++i];
+        } else if (arg == "--input-report" && i + 1 < argc) {
+            inputReport = argv[++i];
+        } else if (arg == "--trace" && i + 1 < argc) {
+            const char* tracePath = argv[++i];
+            if (Trace::instance().open(tracePath))
+                LOG_INFO("Binary trace enabled: {}", tracePath);
+            else
+                LOG_ERROR("Failed to open trace file {}", tracePath);
+        }
+    }
+    optionsTimer.reset();
+
+    // The font is mapped and parsed on a loader thread while the window is being created
+    AssetBundle assets;
+    sf::Font font;
+    std::future<bool> assetsLoaded = std::async(std::launch::async, [&] {
+        StartupTimer timer("assets");
+        return loadAssets(assetsPath, exeDir, assets, font);
+    });
+
+    // A replay is played on the field size and at the tick length it was recorded with
+    std::optional<Replay::Player> replay;
+    if (!replayPath.empty()) {
+        StartupTimer timer("replay");
+        replay.emplace();
+        if (!replay->open(replayPath)) {
+            std::cerr << "Failed to open replay " << replayPath << "\n";
+            LOG_ERROR("Failed to open replay {}", replayPath);
+            return -1;
+        }
+    }
+    LOG_INFO("Initial game state: MENU");
     // Create a video mode object based on desktop resolution
     sf::Vector2f resolution;
-    resolution.x = sf::VideoMode::getDesktopMode().size.x;
-    resolution.y = sf::VideoMode::getDesktopMode().size.y;
+    {
+        StartupTimer timer("desktop mode");
+        const sf::Vector2u desktop = sf::VideoMode::getDesktopMode().size;
+        resolution.x = static_cast<float>(desktop.x);
+        resolution.y = static_cast<float>(desktop.y);
+    }
+    if (replay) {
+        resolution.x = replay->resolution().x;
+        resolution.y = replay->resolution().y;
+    }
+
+    // Remote multiplayer: both peers must simulate the same field
+    UdpTransport transport;
+    const bool online = hostPort >= 0 || !connectTo.empty();
+    if (online) {
+        StartupTimer timer("network");
+        NetAddress peer;
+        std::size_t colon = connectTo.rfind(':');
+        bool ok;
+        if (hostPort >= 0) {
+            ok = transport.open(static_cast<std::uint16_t>(hostPort));
+        } else {
+            ok = colon != std::string::npos &&
+                 NetAddress::resolve(connectTo.substr(0, colon),
+                                     static_cast<std::uint16_t>(std::atoi(connectTo.c_str() + colon + 1)), peer) &&
+                 transport.open(0, &peer);
+        }
+        if (!ok) {
+            std::cerr << "Failed to set up the network session\n";
+            LOG_ERROR("Failed to set up the network session (--host {} / --connect {})", hostPort, connectTo);
+            return -1;
+        }
+        resolution.x = RollbackSession::FieldWidth;
+        resolution.y = RollbackSession::FieldHeight;
+        LOG_INFO("Network session on UDP port {}", transport.localPort());
+    }
 // Create and open a window for the game
     sf::RenderWindow window;
-    window.create(sf::VideoMode({static_cast<unsigned int>(resolution.x), static_cast<unsigned int>(resolution.y)}), "Pong");
-    log.info("Render window created with resolution: " + std::to_string((int)resolution.x) + "x" + std::to_string((int)resolution.y));
-
-    int score_1 = 0, lives_1 = 3;
-    int score_2 = 0, lives_2 = 3;
+    {
+        StartupTimer timer("window");
+        window.create(sf::VideoMode({static_cast<unsigned int>(resolution.x), static_cast<unsigned int>(resolution.y)}), "Pong");
+        // With vsync, display() already blocks until the refresh; the pacer only runs on top
+        // of it when a rate was asked for explicitly
+        window.setVerticalSyncEnabled(vsync);
+    }
+    LOG_INFO("Render window created with resolution: {}x{}", (int)resolution.x, (int)resolution.y);
+    FramePacer pacer(targetFps >= 0.0 ? targetFps : (vsync ? 0.0 : 240.0));
+    LOG_INFO("Frame pacing: vsync {}, cap {} fps", vsync ? "on" : "off", pacer.target());
+    Trace::instance().record(TraceEvent::SessionStart, 0.f, 0.f, 0.f, 0.f, (int)resolution.x, (int)resolution.y);
 
-    Bat bat_1(resolution.x / 2, resolution.y - 80);
-    Bat bat_2(resolution.x / 2, 20);
-    Ball ball(resolution.x / 2.f, 0.f, resolution);
+    // All game rules live in the headless simulation; this file only feeds it input and draws it.
+    GameSimulation sim(Vec2{resolution.x, resolution.y});
 // HUD setup (SFML 3.0.0 compliant)
-    sf::Font font;
-    if (!font.openFromFile("fonts/DS-DIGI.TTF")) {
+    bool fontLoaded;
+    {
+        StartupTimer timer("wait for assets");
+        fontLoaded = assetsLoaded.get();
+    }
+    if (!fontLoaded) {
         std::cerr << "Failed to load font\n";
-        log.error("Failed to load font");
+        LOG_ERROR("Failed to load font: no asset bundle at {} and no {}", assetsPath, FontAsset);
         return -1;
     }
-    log.info("Font loaded successfully");
 
+    std::optional<StartupTimer> sceneTimer(std::in_place, "scene setup");
     DisplayManager display(font, resolution);
+    // Per-phase frame timings: F3 shows them on screen, F4 starts a new measurement window
+    FrameProfiler::instance().enable(true);
     sf::Clock clock;
-    float Time_elapsed = 0;
+    const sf::Time step = sf::seconds(replay ? replay->dt() : 1.f / tickRate);
+    // The exact dt handed to step(); a replay must reuse it bit for bit
+    const float tickDt = replay ? replay->dt() : step.asSeconds();
+    const sf::Time maxFrameTime = sf::seconds(0.25f);
+    sf::Time accumulator = sf::Time::Zero;
+
+    // Multi-ball mode; it has its own simulation and exists only while it is being played
+    std::optional<ChaosSimulation> chaos;
+    std::optional<StressScene> stress;
+    // Versus CPU is a multiplayer match whose top bat is steered by the computer
+    std::optional<CpuPlayer> cpu;
+    // High scores and match history survive restarts; the store loads and writes on its own thread
+    Leaderboard leaderboard(scoresPath);
+    // The player's stored best is read from the index once, after the load, and then raised
+    // by their own game overs, so drawing a frame never takes the leaderboard's lock
+    std::atomic<int> storedBest{0};
+    bool storedBestRead = false; // render thread only
+    auto raiseStoredBest = [&](int score) {
+        int current = storedBest.load(std::memory_order_relaxed);
+        while (score > current && !storedBest.compare_exchange_weak(current, score, std::memory_order_relaxed)) {
+        }
+    };
+    int lastScore[2] = {0, 0};
+    float matchSeconds = 0.f;
+
+    Replay::Recorder recorder;
+    if (!recordPath.empty() && !replay && !recorder.open(recordPath, sim, tickDt))
+        LOG_ERROR("Failed to open replay file {}", recordPath);
+    std::optional<RollbackSession> session;
+    if (online)
+        session.emplace(sim, hostPort >= 0 ? 0 : 1, transport, tickDt);
+    // Scoreboards and overlays read the match from shared memory; they can never slow the game
+    SpectatorFeed feed;
+    if (!feedName.empty())
+        feed.open(feedName, Vec2{resolution.x, resolution.y});
+    bool replayPaused = false;
+    int replaySpeed = 1;
+
+    // Player 1 uses the arrow keys, player 2 Q/D. Presses and releases are queued with the
+    // time they were seen and applied by the tick they fall in.
+    InputQueue inputs;
+    auto movementKey = [](sf::Keyboard::Scancode code, InputKey& key) {
+        switch (code) {
+            case sf::Keyboard::Scancode::Left:  key = InputKey::Player1Left; return true;
+            case sf::Keyboard::Scancode::Right: key = InputKey::Player1Right; return true;
+            case sf::Keyboard::Scancode::Q:     key = InputKey::Player2Left; return true;
+            case sf::Keyboard::Scancode::D:     key = InputKey::Player2Right; return true;
+            default:                            return false;
+        }
+    };
+    if (stressCount > 0) {
+        stress.emplace(stressCount, Vec2{resolution.x, resolution.y});
+        LOG_INFO("Stress mode: {} entities", stressCount);
+    }
+    // Replays, network sessions and the stress scene step on the frame loop of their own
+    if (simThreaded && (replay || session || stress)) {
+        LOG_INFO("--sim-thread is ignored with --replay, --host, --connect and --stress");
+        simThreaded = false;
+    }
 
-    while (window.isOpen()) {
-        /* **********************************
-        ***** Handle the player input*****
-        **********************************/
-        while (auto event = window.pollEvent()) {
-            if (event->is<sf::Event::Closed>()) {
-                log.info("Window close event triggered");
-                window.close();
+    // Everything that changes the match runs where the simulation runs: inline, or on the
+    // simulation thread with --sim-thread
+    auto applyCommand = [&](const SimCommand& command) {
+        switch (command.type) {
+            case SimCommand::Type::Key:
+                inputs.push(command.key, command.pressed, command.timeNs);
+                break;
+            case SimCommand::Type::ReleaseAll:
+                inputs.releaseAll(command.timeNs);
+                break;
+            case SimCommand::Type::Start:
+                cpu.reset();
+                sim.start(command.mode);
+                recorder.command(command.mode);
+                break;
+            case SimCommand::Type::StartCpu:
+                cpu.emplace(1, cpuDifficulty, static_cast<std::uint32_t>(command.timeNs));
+                sim.start(GameMode::Multiplayer);
+                recorder.command(GameMode::Multiplayer);
+                break;
+            case SimCommand::Type::Menu:
+                sim.returnToMenu();
+                recorder.command(GameMode::Menu);
+                break;
+            case SimCommand::Type::Presented:
+                inputs.presented(command.timeNs, command.applied);
+                break;
+        }
+    };
+
+    // One tick of the local match: CPU opponent, rules, recording and the leaderboard
+    auto runTick = [&](TickInput input) {
+        // The CPU's keys are recorded like a human's, so replays need no bot
+        if (cpu && sim.mode() == GameMode::Multiplayer)
+            input.players[1] = cpu->input(sim.state(), resolution.x, tickDt);
+        const GameMode mode = sim.mode();
+        const std::uint32_t events = sim.step(input, tickDt);
+        recorder.tick(input, sim);
+        if (mode != GameMode::Menu)
+            matchSeconds += tickDt;
+        if (events & SimEvent::GameOver) {
+            // The rules reset the scores on game over; a point in the same tick still counts
+            const int final1 = lastScore[0] + ((events & SimEvent::Point1) ? 1 : 0);
+            const int final2 = lastScore[1] + ((events & SimEvent::Point2) ? 1 : 0);
+            if (mode == GameMode::Multiplayer) {
+                leaderboard.submit(Leaderboard::makeRecord(mode, playerName, final1,
+                                                           cpu ? "CPU" : "Player 2", final2, matchSeconds));
+            } else {
+                leaderboard.submit(Leaderboard::makeRecord(mode, playerName, final1, "", 0, matchSeconds));
+                raiseStoredBest(final1);
             }
-            if (event->is<sf::Event::KeyPressed>()) {
-                const auto* keyEvent = event->getIf<sf::Event::KeyPressed>();
-                if (keyEvent) {
-                    auto key = keyEvent->scancode;
-                    if (state == State::MENU) {
-                        if (key == sf::Keyboard::Scancode::Num1) {
-                            state = State::SINGLEPLAYER;
-                            log.info("Switched to SINGLEPLAYER mode");
-                        } else if (key == sf::Keyboard::Scancode::Num2) {
-                            state = State::MULTIPLAYER;
-                            log.info("Switched to MULTIPLAYER mode");
-                        }
-                    }
-                    if (key == sf::Keyboard::Scancode::M) {
-                        state = State::MENU;
-                        log.info("Returned to MENU");
+            matchSeconds = 0.f;
+        }
+        lastScore[0] = sim.state().score[0];
+        lastScore[1] = sim.state().score[1];
+        feed.publish(sim.state());
+    };
+
+    // With --sim-thread the window thread only polls events and draws; the simulation,
+    // the input queue, the CPU and the recorder then belong to the simulation thread
+    std::optional<SimulationThread> simThread;
+    GameMode shownMode = GameMode::Menu; // mode of the last snapshot drawn
+    std::uint64_t shownPresses = 0;      // presses applied in the last snapshot drawn
+    if (simThreaded) {
+        simThread.emplace(sim, tickRate,
+                          [&](std::uint64_t tickEndNs) {
+                              runTick(inputs.consume(tickEndNs, InputQueue::now()));
+                              return inputs.applied();
+                          },
+                          applyCommand);
+        simThread->start();
+    }
+    auto dispatch = [&](const SimCommand& command) {
+        if (simThread)
+            simThread->post(command);
+        else
+            applyCommand(command);
+    };
+    auto currentMode = [&] { return simThread ? shownMode : sim.mode(); };
+
+    // Window events: movement keys go to the input queue, the rest act at once
+    auto handleEvent = [&](const sf::Event& event) {
+        // SFML events carry no timestamp; they are stamped as they are drained
+        const std::uint64_t seenNs = InputQueue::now();
+        InputKey movement = InputKey::Player1Left; // set by movementKey(); unused by the other commands
+        if (event.is<sf::Event::Closed>()) {
+            LOG_INFO("Window close event triggered");
+            window.close();
+        }
+        if (event.is<sf::Event::FocusLost>()) // releases made in another window never reach us
+            dispatch(SimCommand{SimCommand::Type::ReleaseAll, InputKey::Player1Left, false, GameMode::Menu, seenNs});
+        if (const auto* released = event.getIf<sf::Event::KeyReleased>()) {
+            if (movementKey(released->scancode, movement))
+                dispatch(SimCommand{SimCommand::Type::Key, movement, false, GameMode::Menu, seenNs});
+        }
+        if (event.is<sf::Event::KeyPressed>()) {
+            const auto* keyEvent = event.getIf<sf::Event::KeyPressed>();
+            if (keyEvent) {
+                auto key = keyEvent->scancode;
+                if (movementKey(key, movement))
+                    dispatch(SimCommand{SimCommand::Type::Key, movement, true, GameMode::Menu, seenNs});
+                if (key == sf::Keyboard::Scancode::Escape) {
+                    LOG_INFO("Escape pressed — exiting");
+                    window.close();
+                }
+                if (replay) {
+                    // Seeking re-simulates from the nearest snapshot, at most a second of ticks
+                    const auto seekTicks = static_cast<std::int64_t>(5.f / replay->dt());
+                    std::int64_t target = replay->position();
+                    if (key == sf::Keyboard::Scancode::Space)
+                        replayPaused = !replayPaused;
+                    else if (key == sf::Keyboard::Scancode::F)
+                        replaySpeed = replaySpeed == 1 ? 8 : 1;
+                    else if (key == sf::Keyboard::Scancode::Left)
+                        replay->seek(sim, static_cast<std::uint32_t>(std::max<std::int64_t>(0, target - seekTicks)));
+                    else if (key == sf::Keyboard::Scancode::Right)
+                        replay->seek(sim, static_cast<std::uint32_t>(std::min<std::int64_t>(replay->ticks(), target + seekTicks)));
+                } else if (session) {
+                    // The match is shared with the peer; the menu is not available
+                } else if (currentMode() == GameMode::Menu && !chaos) {
+                    if (key == sf::Keyboard::Scancode::Num1) {
+                        dispatch(SimCommand{SimCommand::Type::Start, movement, false, GameMode::Singleplayer, seenNs});
+                    } else if (key == sf::Keyboard::Scancode::Num2) {
+                        dispatch(SimCommand{SimCommand::Type::Start, movement, false, GameMode::Multiplayer, seenNs});
+                    } else if (key == sf::Keyboard::Scancode::Num4) {
+                        dispatch(SimCommand{SimCommand::Type::StartCpu, movement, false, GameMode::Multiplayer, seenNs});
+                    } else if (key == sf::Keyboard::Scancode::Num3) {
+                        // Chaos mode has its own simulation, which only runs on the frame loop
+                        if (simThread)
+                            LOG_INFO("Chaos mode is not available with --sim-thread");
+                        else
+                            chaos.emplace(Vec2{resolution.x, resolution.y}, chaosBalls);
                     }
                 }
+                if (key == sf::Keyboard::Scancode::M && !replay && !session) {
+                    dispatch(SimCommand{SimCommand::Type::Menu, movement, false, GameMode::Menu, seenNs});
+                    chaos.reset();
+                }
+                if (key == sf::Keyboard::Scancode::F3)
+                    display.toggleProfilerOverlay();
+                if (key == sf::Keyboard::Scancode::F4)
+                    FrameProfiler::instance().reset();
             }
         }
+    };
 
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::Escape)) {
-            log.info("Escape pressed — exiting");
-            window.close();
-        }
-
-        sf::Time dt = clock.restart();
-        Time_elapsed += dt.asSeconds();
-
-        if (state == State::MENU) {
-            log.info("Rendering menu");
+    // The menu is static: once drawn, the loop sleeps in waitEvent() until something happens
+    bool menuRendered = false;
+    auto drawMatch = [&](const MatchState& state, float alpha) {
+        if (state.mode == GameMode::Menu) {
+            LOG_TRACE("Rendering menu");
             display.renderMenu(window);
-            continue;
+            menuRendered = true;
+        } else if (state.mode == GameMode::Singleplayer) {
+            if (!storedBestRead && leaderboard.loaded()) {
+                raiseStoredBest(leaderboard.best(GameMode::Singleplayer, playerName));
+                storedBestRead = true;
+            }
+            const int highScore = std::max(state.highScore, storedBest.load(std::memory_order_relaxed));
+            display.renderSingleplayer(window, state.bats[0], state.ball, state.score[0], state.lives[0], highScore, alpha);
+        } else {
+            display.renderMultiplayer(window, state.bats[0], state.bats[1], state.ball,
+                                      state.score[0], state.lives[0], state.score[1], state.lives[1], alpha);
+        }
+    };
+    sceneTimer.reset();
+    // Startup ends once the first frame is on screen, i.e. when the second iteration begins
+    std::optional<StartupTimer> firstFrameTimer(std::in_place, "first frame");
+    std::uint64_t iterations = 0;
+    while (window.isOpen()) {
+        if (iterations++ == 1) {
+            firstFrameTimer.reset();
+            StartupProfiler::instance().finish();
+            std::istringstream report(StartupProfiler::instance().summary());
+            for (std::string line; std::getline(report, line);)
+                LOG_INFO("Startup: {}", line);
+            if (startupOnly) {
+                window.close();
+                break;
+            }
+        }
+        const bool idleMenu = currentMode() == GameMode::Menu && !chaos && !stress && !replay && !session &&
+                              !display.profilerOverlayVisible();
+        if (idleMenu && menuRendered) {
+            if (auto event = window.waitEvent(sf::seconds(1.f)))
+                handleEvent(*event);
+            menuRendered = false;
+            // The time spent waiting is not simulated (the simulation thread keeps ticking the
+            // menu, and the snapshots it published meanwhile were not missed frames)
+            clock.restart();
+            pacer.resync();
+            if (simThread)
+                simThread->skipDropped();
+            if (!window.isOpen())
+                break;
         }
 
-        if (state == State::SINGLEPLAYER) {
-            log.info("Singleplayer tick");
-
-            auto batBounds = bat_1.getGlobalBounds();
-            auto batPos = batBounds.position;
-            auto batSize = batBounds.size;
-
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::Left)) {
-                bat_1.moveLeft();
-                if (batPos.x < 0) bat_1.stopLeft();
-            } else bat_1.stopLeft();
-
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::Right)) {
-                bat_1.moveRight();
-                if (batPos.x + batSize.x > window.getSize().x) bat_1.stopRight();
-            } else bat_1.stopRight();
-
-            bat_1.update(dt);
-            ball.update(dt);
-
-            auto ballBounds = ball.getGlobalBounds();
-            auto ballPos = ballBounds.position;
-            auto ballSize = ballBounds.size;
+        ScopedTimer frameTimer(Phase::Frame);
 
-            if (ballPos.y > window.getSize().y) {
-                ball.reboundBottom();
-                lives_1--;
-                log.info("Ball hit bottom — Player 1 lives left: " + std::to_string(lives_1));
-                if (lives_1 < 1) {
-                    if (score_1 > high_score_1) {
-                        high_score_1 = score_1;
-                        log.info("🎉 New High Score for Player 1: " + std::to_string(high_score_1));
-                    }
-                    ball = Ball(resolution.x / 2.f, resolution.y / 2.f, resolution);
-                    Time_elapsed = 0;
-                    state = State::MENU;
-                    score_1 = 0;
-                    lives_1 = 3;
-                    continue;
-                }
-            }
+        /* **********************************
+        ***** Handle the player input*****
+        **********************************/
+        {
+            ScopedTimer inputTimer(Phase::Input);
+            while (auto event = window.pollEvent())
+                handleEvent(*event);
+        }
 
-            if (ballPos.y < 0) {
-                ball.reboundBatOrTop();
-                if (Time_elapsed > 1) {
-                    score_1++;
-                    log.info("Player 1 scored — Score: " + std::to_string(score_1));
-                }
+        if (simThread) {
+            // Blend towards the latest snapshot by the time passed since it was published
+            const SimSnapshot& snapshot = simThread->acquire();
+            shownMode = snapshot.state.mode;
+            const float alpha = std::min(1.f, static_cast<float>(FrameProfiler::now() - snapshot.publishedNs) /
+                                                  static_cast<float>(step.asMicroseconds() * 1000));
+            drawMatch(snapshot.state, alpha);
+            // The input queue belongs to the simulation thread, so the presses this frame
+            // showed for the first time are marked visible there
+            if (snapshot.applied > shownPresses) {
+                shownPresses = snapshot.applied;
+                simThread->post(SimCommand{SimCommand::Type::Presented, InputKey::Player1Left, false, GameMode::Menu,
+                                           InputQueue::now(), shownPresses});
             }
+            pacer.wait();
+            continue;
+        }
 
-            if (ballPos.x < 0 || ballPos.x + ballSize.x > window.getSize().x)
-                ball.reboundSides();
-
-            if (ball.getGlobalBounds().findIntersection(bat_1.getGlobalBounds()))
-                ball.reboundBatOrTop();
-
-            display.renderSingleplayer(window, bat_1, ball, score_1, lives_1,high_score_1);
-        }
-
-        if (state == State::MULTIPLAYER) {
-            log.info("Multiplayer tick");
-
-            auto bat1Bounds = bat_1.getGlobalBounds();
-            auto bat2Bounds = bat_2.getGlobalBounds();
-            auto bat1Pos = bat1Bounds.position;
-            auto bat1Size = bat1Bounds.size;
-            auto bat2Pos = bat2Bounds.position;
-            auto bat2Size = bat2Bounds.size;
-
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::Left)) {
-                bat_1.moveLeft();
-                if (bat1Pos.x < 0) bat_1.stopLeft();
-            } else bat_1.stopLeft();
-
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::Right)) {
-                bat_1.moveRight();
-                if (bat1Pos.x + bat1Size.x > window.getSize().x) bat_1.stopRight();
-            } else bat_1.stopRight();
-
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::Q)) {
-                bat_2.moveLeft();
-                if (bat2Pos.x < 0) bat_2.stopLeft();
-            } else bat_2.stopLeft();
-
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::D)) {
-                bat_2.moveRight();
-                if (bat2Pos.x + bat2Size.x > window.getSize().x) bat_2.stopRight();
-            } else bat_2.stopRight();
-
-            bat_1.update(dt);
-            bat_2.update(dt);
-            ball.update(dt);
-
-            auto ballBounds = ball.getGlobalBounds();
-            auto ballPos = ballBounds.position;
-            auto ballSize = ballBounds.size;
-
-            if (ballPos.y > window.getSize().y) {
-                ball.reboundBottom();
-                lives_1--;
-                score_2++;
-                log.info("Player 2 scored — Player 1 lives: " + std::to_string(lives_1));
-                if (lives_1 < 1) {
-                    ball = Ball(resolution.x / 2.f, resolution.y / 2.f, resolution);
-                    Time_elapsed = 0;
-                    state = State::MENU;
-                    score_1 = score_2 = 0;
-                    lives_1 = lives_2 = 3;
-                    continue;
-                }
+        // Fixed-timestep simulation: consume the elapsed wall time in whole ticks.
+        // Long hitches are clamped so a stall never turns into a burst of catch-up ticks.
+        sf::Time frameTime = clock.restart();
+        const std::uint64_t frameNs = InputQueue::now();
+        if (frameTime > maxFrameTime) frameTime = maxFrameTime;
+        accumulator += frameTime;
+        // The simulation trails the wall clock by the accumulator: the first tick below ends
+        // one step after frameNs - accumulator.
+        std::uint64_t tickEndNs = frameNs - static_cast<std::uint64_t>(accumulator.asMicroseconds()) * 1000u;
+        const auto stepNs = static_cast<std::uint64_t>(step.asMicroseconds()) * 1000u;
+
+        if (stress) {
+            {
+                ScopedTimer simTimer(Phase::Simulation);
+                stress->update(frameTime.asSeconds());
             }
+            display.renderStress(window, *stress);
+            pacer.wait();
+            continue;
+        }
 
-            if (ballPos.y < 0) {
-                ball.reboundBatOrTopMultiplayer();
-                score_1++;
-                lives_2--;
-                log.info("Player 1 scored — Player 2 lives: " + std::to_string(lives_2));
-                if (lives_2 < 1) {
-                    state = State::MENU;
-                    score_1 = score_2 = 0;
-                    lives_1 = lives_2 = 3;
-                    continue;
+        {
+            ScopedTimer simTimer(Phase::Simulation);
+            while (accumulator >= step) {
+                accumulator -= step;
+                tickEndNs += stepNs;
+                TickInput input = inputs.consume(tickEndNs, InputQueue::now());
+                if (replay) {
+                    for (int i = 0; i < replaySpeed && !replayPaused; ++i)
+                        replay->advance(sim);
+                    feed.publish(sim.state());
+                } else if (session) {
+                    // Each peer steers its own bat with the arrow keys
+                    session->advance(input.players[0]);
+                    feed.publish(sim.state());
+                } else if (chaos) {
+                    chaos->step(input, tickDt);
+                } else {
+                    runTick(input);
                 }
             }
-
-            if (ballPos.x < 0 || ballPos.x + ballSize.x > window.getSize().x)
-                ball.reboundSides();
-
-            if (ball.getGlobalBounds().findIntersection(bat_1.getGlobalBounds()))
-                ball.reboundBatOrTop();
-            if (ball.getGlobalBounds().findIntersection(bat_2.getGlobalBounds()))
-                ball.reboundBatOrTop();
-
-            display.renderMultiplayer(window, bat_1, bat_2, ball, score_1, lives_1, score_2, lives_2);
         }
+
+        // Draw the state blended between the last two ticks.
+        // A paused replay shows the last tick as is instead of blending towards it
+        float alpha = replayPaused ? 1.f : accumulator.asSeconds() / step.asSeconds();
+        if (chaos)
+            display.renderChaos(window, *chaos, alpha);
+        else
+            drawMatch(sim.state(), alpha);
+        inputs.presented(InputQueue::now());
+        pacer.wait();
     }
 
-    log.info("Game shutdown");
+    if (simThread) {
+        simThread->stop();
+        const SimThreadStats threadStats = simThread->stats();
+        const PhaseHistogram& age = FrameProfiler::instance().histogram(Phase::SnapshotAge);
+        LOG_INFO("Simulation thread: {} ticks, {} frames drawn, {} duplicated, {} ticks never drawn, {} commands lost",
+                 threadStats.ticks, threadStats.drawn, threadStats.duplicated, threadStats.dropped,
+                 threadStats.commandsLost);
+        LOG_INFO("Snapshot age when drawn: p50 {} us, p99 {} us, max {} us", age.quantileNs(0.5) / 1000,
+                 age.quantileNs(0.99) / 1000, age.maxNs() / 1000);
+    }
+    const InputLatencySummary latency = inputs.summary();
+    LOG_INFO("Input latency over {} presses: applied mean {} us, p99 {} us; visible mean {} us, p99 {} us",
+             latency.presses, latency.appliedMean, latency.appliedP99, latency.visibleMean, latency.visibleP99);
+    const PhaseHistogram& jitter = FrameProfiler::instance().histogram(Phase::FrameJitter);
+    if (jitter.count() > 0)
+        LOG_INFO("Frame pacing at {} fps over {} frames: jitter p50 {} us, p99 {} us, max {} us", pacer.target(),
+                 jitter.count(), jitter.quantileNs(0.5) / 1000, jitter.quantileNs(0.99) / 1000, jitter.maxNs() / 1000);
+    if (!inputReport.empty() && !inputs.writeCsv(inputReport))
+        LOG_ERROR("Failed to write the input latency report to {}", inputReport);
+
+    if (FrameProfiler::instance().writeCsv(profileCsv))
+        LOG_INFO("Frame timings written to {}", profileCsv);
+    else
+        LOG_ERROR("Failed to write frame timings to {}", profileCsv);
+    recorder.close();
+    leaderboard.flush();
+    LOG_INFO("Leaderboard: {} matches in {}", leaderboard.stats().records, scoresPath);
+    LOG_INFO("Game shutdown");
+    Trace::instance().record(TraceEvent::SessionEnd);
+    Trace::instance().close();
     return 0;
 }
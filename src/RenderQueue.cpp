@@ -0,0 +1,122 @@
+/**
+ * @file RenderQueue.cpp
+ * @brief Implementation of the render command buffer: recording, sorting, merging and submission.
+ * @author Oussama Amara
+ * @date 2025-09-03
+ */
+
+#include "RenderQueue.hpp"
+#include <algorithm>
+#include <cctype>
+
+/**
+ * @brief Appends a command. The key packs the layer (clears before every layer), the state
+ * and the recording order, so sorting by key alone gives the submission order.
+ */
+void RenderQueue::record(Kind kind, RenderLayer layer, std::uint32_t state, std::uint32_t handle,
+                         std::uint32_t first, std::uint32_t count) {
+    const std::uint64_t slot = kind == Kind::Clear ? 0 : static_cast<std::uint64_t>(layer) + 1;
+    const std::uint64_t order = m_Commands.size() & 0xffffff;
+    m_Commands.push_back({slot << 56 | static_cast<std::uint64_t>(state) << 24 | order, kind, layer, state, handle,
+                          first, count});
+}
+
+void RenderQueue::clear(std::uint32_t color) {
+    record(Kind::Clear, RenderLayer::Background, UntexturedState, color, 0, 0);
+}
+
+void RenderQueue::quad(const Aabb& rect, std::uint32_t color, RenderLayer layer) {
+    // The previous command is still open when it holds the last quads recorded
+    if (!m_Commands.empty()) {
+        Command& last = m_Commands.back();
+        if (last.kind == Kind::Quads && last.layer == layer && last.first + last.count == m_Quads.size()) {
+            m_Quads.push_back({rect, color});
+            ++last.count;
+            return;
+        }
+    }
+    record(Kind::Quads, layer, UntexturedState, 0, static_cast<std::uint32_t>(m_Quads.size()), 1);
+    m_Quads.push_back({rect, color});
+}
+
+void RenderQueue::quads(const std::vector<Aabb>& rects, std::uint32_t color, RenderLayer layer) {
+    if (rects.empty())
+        return;
+    record(Kind::Quads, layer, UntexturedState, 0, static_cast<std::uint32_t>(m_Quads.size()),
+           static_cast<std::uint32_t>(rects.size()));
+    for (const Aabb& r : rects)
+        m_Quads.push_back({r, color});
+}
+
+void RenderQueue::text(std::uint32_t handle, std::uint32_t font, std::size_t vertices, RenderLayer layer) {
+    record(Kind::Text, layer, font + 1, handle, 0, static_cast<std::uint32_t>(vertices));
+}
+
+void RenderQueue::mesh(std::uint32_t handle, std::size_t vertices, RenderLayer layer) {
+    record(Kind::Mesh, layer, UntexturedState, handle, 0, static_cast<std::uint32_t>(vertices));
+}
+
+std::size_t RenderQueue::glyphVertices(std::string_view text) {
+    return 6 * static_cast<std::size_t>(std::count_if(text.begin(), text.end(),
+                                                      [](unsigned char c) { return !std::isspace(c); }));
+}
+
+/**
+ * @brief Issues the frame. Runs of quad commands that are adjacent after sorting go out as
+ * one draw call, straight from the recorded array when their rectangles are contiguous
+ * there, otherwise gathered into a scratch array first.
+ */
+void RenderQueue::submit(RenderBackend& backend) {
+    if (!std::is_sorted(m_Commands.begin(), m_Commands.end(),
+                        [](const Command& a, const Command& b) { return a.key < b.key; }))
+        std::sort(m_Commands.begin(), m_Commands.end(), [](const Command& a, const Command& b) { return a.key < b.key; });
+
+    m_LastCommands = m_Commands.size();
+    m_LastMerged = 0;
+    bool bound = false;
+    std::uint32_t state = 0;
+    auto bind = [&](std::uint32_t next) {
+        if (!bound || next != state)
+            backend.bindState(next);
+        bound = true;
+        state = next;
+    };
+
+    for (std::size_t i = 0; i < m_Commands.size();) {
+        const Command& c = m_Commands[i];
+        if (c.kind == Kind::Clear) {
+            backend.clear(c.handle);
+            ++i;
+        } else if (c.kind == Kind::Quads) {
+            std::size_t end = i + 1;
+            std::size_t count = c.count;
+            bool contiguous = true;
+            for (; end < m_Commands.size() && m_Commands[end].kind == Kind::Quads; ++end) {
+                const Command& prev = m_Commands[end - 1];
+                contiguous = contiguous && m_Commands[end].first == prev.first + prev.count;
+                count += m_Commands[end].count;
+            }
+            const RenderQuad* quads = m_Quads.data() + c.first;
+            if (!contiguous) {
+                m_Scratch.clear();
+                for (std::size_t k = i; k < end; ++k)
+                    m_Scratch.insert(m_Scratch.end(), m_Quads.begin() + m_Commands[k].first,
+                                     m_Quads.begin() + m_Commands[k].first + m_Commands[k].count);
+                quads = m_Scratch.data();
+            }
+            bind(c.state);
+            backend.drawQuads(quads, count);
+            m_LastMerged += end - i - 1;
+            i = end;
+        } else {
+            bind(c.state);
+            if (c.kind == Kind::Text)
+                backend.drawText(c.handle, c.count);
+            else
+                backend.drawMesh(c.handle, c.count);
+            ++i;
+        }
+    }
+    m_Commands.clear();
+    m_Quads.clear();
+}
@@ -0,0 +1,415 @@
+/**
+ * @file Replay.cpp
+ * @brief Implementation of the replay recorder and player.
+ * @author Oussama Amara
+ * @date 2025-08-25
+ */
+
+#include "Replay.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace Replay {
+
+namespace {
+constexpr std::uint16_t Version = 1;
+
+/** @brief LEB128: seven bits per byte, high bit set on all but the last. */
+void appendVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+/**
+ * @brief Encodes the XOR of two states as (zero run, literal count, literals) groups.
+ * A literal run only ends at two zero bytes in a row, so isolated zeros stay inline.
+ */
+void encodeDelta(const PackedState& previous, const PackedState& current, std::vector<std::uint8_t>& out) {
+    std::uint8_t x[StateSize];
+    for (std::size_t i = 0; i < StateSize; ++i)
+        x[i] = previous[i] ^ current[i];
+
+    std::size_t i = 0;
+    while (i < StateSize) {
+        std::size_t zeros = 0;
+        while (i + zeros < StateSize && x[i + zeros] == 0)
+            ++zeros;
+        i += zeros;
+        std::size_t literals = 0;
+        while (i + literals < StateSize &&
+               !(x[i + literals] == 0 && (i + literals + 1 == StateSize || x[i + literals + 1] == 0)))
+            ++literals;
+        appendVarint(out, zeros);
+        appendVarint(out, literals);
+        out.insert(out.end(), x + i, x + i + literals);
+        i += literals;
+    }
+}
+
+/** @brief Bounds-checked reader over the mapped records. */
+struct Reader {
+    const std::uint8_t* p;
+    const std::uint8_t* end;
+
+    bool byte(std::uint8_t& out) {
+        if (p == end) return false;
+        out = *p++;
+        return true;
+    }
+
+    bool varint(std::uint64_t& out) {
+        out = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            std::uint8_t b;
+            if (!byte(b)) return false;
+            out |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+            if (!(b & 0x80)) return true;
+        }
+        return false;
+    }
+};
+
+/** @brief Applies an encoded delta to @p state in place. */
+bool decodeDelta(const std::uint8_t* in, std::size_t size, PackedState& state) {
+    Reader r{in, in + size};
+    std::size_t i = 0;
+    while (i < StateSize) {
+        std::uint64_t zeros, literals;
+        if (!r.varint(zeros) || !r.varint(literals)) return false;
+        if (zeros == 0 && literals == 0) return false;
+        if (zeros > StateSize - i || literals > StateSize - i - zeros) return false;
+        if (literals > static_cast<std::size_t>(r.end - r.p)) return false;
+        i += zeros;
+        for (std::uint64_t k = 0; k < literals; ++k)
+            state[i++] ^= *r.p++;
+    }
+    return r.p == r.end;
+}
+
+template <class T>
+void put(std::uint8_t*& out, const T& value) {
+    std::memcpy(out, &value, sizeof value);
+    out += sizeof value;
+}
+
+template <class T>
+void get(const std::uint8_t*& in, T& value) {
+    std::memcpy(&value, in, sizeof value);
+    in += sizeof value;
+}
+} // namespace
+
+/**
+ * @brief Mode, ball, bats, then the integers and the clock in declaration order.
+ */
+void packState(const MatchState& state, PackedState& out) {
+    std::uint8_t* p = out.data();
+    *p++ = static_cast<std::uint8_t>(state.mode);
+    state.ball.pack(p);
+    p += Ball::PackedSize;
+    for (const Bat& bat : state.bats) {
+        bat.pack(p);
+        p += Bat::PackedSize;
+    }
+    put(p, state.score);
+    put(p, state.lives);
+    put(p, state.highScore);
+    put(p, state.timeElapsed);
+    put(p, state.tick);
+}
+
+void unpackState(const PackedState& in, MatchState& state) {
+    const std::uint8_t* p = in.data();
+    state.mode = static_cast<GameMode>(*p++);
+    state.ball.unpack(p);
+    p += Ball::PackedSize;
+    for (Bat& bat : state.bats) {
+        bat.unpack(p);
+        p += Bat::PackedSize;
+    }
+    get(p, state.score);
+    get(p, state.lives);
+    get(p, state.highScore);
+    get(p, state.timeElapsed);
+    get(p, state.tick);
+}
+
+std::uint8_t encodeInput(const TickInput& input) {
+    return static_cast<std::uint8_t>((input.players[0].left ? Player1Left : 0) |
+                                     (input.players[0].right ? Player1Right : 0) |
+                                     (input.players[1].left ? Player2Left : 0) |
+                                     (input.players[1].right ? Player2Right : 0));
+}
+
+TickInput decodeInput(std::uint8_t bits) {
+    TickInput input;
+    input.players[0] = {(bits & Player1Left) != 0, (bits & Player1Right) != 0};
+    input.players[1] = {(bits & Player2Left) != 0, (bits & Player2Right) != 0};
+    return input;
+}
+
+/* **********************************
+***** Recorder *****
+**********************************/
+
+Recorder::~Recorder() {
+    close();
+}
+
+/**
+ * @brief Writes the header and a snapshot of the starting state against an all-zero base.
+ */
+bool Recorder::open(const std::string& path, const GameSimulation& sim, float dt) {
+    close();
+    m_File = std::fopen(path.c_str(), "wb");
+    if (!m_File)
+        return false;
+
+    ReplayHeader header{};
+    std::memcpy(header.magic, "PRPL", 4);
+    header.version = Version;
+    header.stateSize = static_cast<std::uint16_t>(StateSize);
+    header.width = sim.resolution().x;
+    header.height = sim.resolution().y;
+    header.dt = dt;
+    header.snapshotInterval = SnapshotInterval;
+    std::fwrite(&header, sizeof header, 1, m_File);
+
+    m_Ticks = 0;
+    m_RunLength = 0;
+    m_Previous.fill(0);
+    snapshot(sim);
+    LOG_INFO("Recording replay to {}", path);
+    return true;
+}
+
+void Recorder::close() {
+    if (!m_File)
+        return;
+    flushRun();
+    std::fputc(static_cast<int>(Record::End), m_File);
+    writeVarint(m_Ticks);
+    std::fclose(m_File);
+    m_File = nullptr;
+    LOG_INFO("Replay closed after {} ticks", m_Ticks);
+}
+
+void Recorder::command(GameMode mode) {
+    if (!m_File)
+        return;
+    flushRun();
+    std::fputc(static_cast<int>(Record::Command), m_File);
+    std::fputc(static_cast<int>(mode), m_File);
+}
+
+/**
+ * @brief Extends the current input run, or closes it when the keys changed.
+ */
+void Recorder::tick(const TickInput& input, const GameSimulation& sim) {
+    if (!m_File)
+        return;
+    std::uint8_t bits = encodeInput(input);
+    if (m_RunLength > 0 && bits != m_RunBits)
+        flushRun();
+    m_RunBits = bits;
+    ++m_RunLength;
+    if (++m_Ticks % SnapshotInterval == 0)
+        snapshot(sim);
+}
+
+void Recorder::flushRun() {
+    if (m_RunLength == 0)
+        return;
+    std::fputc(static_cast<int>(Record::Input), m_File);
+    writeVarint(m_RunLength);
+    std::fputc(m_RunBits, m_File);
+    m_RunLength = 0;
+}
+
+/**
+ * @brief Writes the state as a delta against the previous snapshot and flushes the file.
+ */
+void Recorder::snapshot(const GameSimulation& sim) {
+    flushRun();
+    PackedState current;
+    packState(sim.state(), current);
+    m_Scratch.clear();
+    encodeDelta(m_Previous, current, m_Scratch);
+    m_Previous = current;
+
+    std::fputc(static_cast<int>(Record::Snapshot), m_File);
+    writeVarint(m_Ticks);
+    writeVarint(m_Scratch.size());
+    std::fwrite(m_Scratch.data(), 1, m_Scratch.size(), m_File);
+    std::fflush(m_File);
+}
+
+void Recorder::writeVarint(std::uint64_t value) {
+    std::uint8_t bytes[10];
+    std::size_t n = 0;
+    for (; value >= 0x80; value >>= 7)
+        bytes[n++] = static_cast<std::uint8_t>(value | 0x80);
+    bytes[n++] = static_cast<std::uint8_t>(value);
+    std::fwrite(bytes, 1, n, m_File);
+}
+
+/* **********************************
+***** Player *****
+**********************************/
+
+bool Player::open(const std::string& path) {
+    m_Runs.clear();
+    m_Commands.clear();
+    m_Snapshots.clear();
+    m_Ticks = m_Position = 0;
+    m_NextRun = m_NextCommand = 0;
+    if (!m_File.open(path, MappedFile::Mode::ReadOnly) || m_File.size() < sizeof(ReplayHeader))
+        return false;
+    std::memcpy(&m_Header, m_File.data(), sizeof m_Header);
+    if (std::memcmp(m_Header.magic, "PRPL", 4) != 0 || m_Header.version != Version) {
+        LOG_ERROR("{} is not a version {} replay", path, Version);
+        return false;
+    }
+    if (m_Header.stateSize != StateSize) {
+        LOG_ERROR("{} stores {}-byte states, this build uses {}", path, m_Header.stateSize, StateSize);
+        return false;
+    }
+    return index();
+}
+
+/**
+ * @brief Walks the records once, decoding the snapshots and noting where runs and commands
+ * start. A truncated trailing record (the game stopped mid-write) ends the recording there.
+ */
+bool Player::index() {
+    Reader r{m_File.data() + sizeof(ReplayHeader), m_File.data() + m_File.size()};
+    PackedState state{};
+    std::uint32_t tick = 0;
+    bool more = true;
+    std::uint8_t tag;
+    while (more && r.byte(tag)) {
+        std::uint64_t value, size;
+        std::uint8_t byte;
+        switch (static_cast<Record>(tag)) {
+            case Record::Input:
+                more = r.varint(value) && r.byte(byte) && value > 0;
+                if (more) {
+                    m_Runs.push_back({tick, byte});
+                    tick += static_cast<std::uint32_t>(value);
+                }
+                break;
+            case Record::Command:
+                more = r.byte(byte) && byte <= static_cast<std::uint8_t>(GameMode::Multiplayer);
+                if (more)
+                    m_Commands.push_back({tick, static_cast<GameMode>(byte)});
+                break;
+            case Record::Snapshot:
+                more = r.varint(value) && r.varint(size) && size <= static_cast<std::size_t>(r.end - r.p);
+                if (more && (value != tick || !decodeDelta(r.p, size, state))) {
+                    LOG_ERROR("Replay snapshot at tick {} is corrupt", tick);
+                    more = false;
+                }
+                if (more) {
+                    r.p += size;
+                    m_Snapshots.push_back({tick, state});
+                }
+                break;
+            case Record::End:
+                more = false;
+                break;
+            default:
+                LOG_ERROR("Unknown replay record {} after tick {}", tag, tick);
+                more = false;
+                break;
+        }
+    }
+    if (m_Snapshots.empty() || m_Snapshots.front().tick != 0)
+        return false;
+    m_Ticks = tick;
+    LOG_INFO("Replay indexed: {} ticks, {} snapshots, {} input runs", m_Ticks, m_Snapshots.size(), m_Runs.size());
+    return true;
+}
+
+void Player::seek(GameSimulation& sim, std::uint32_t tick) {
+    tick = std::min(tick, m_Ticks);
+    auto snap = std::upper_bound(m_Snapshots.begin(), m_Snapshots.end(), tick,
+                                 [](std::uint32_t t, const Snapshot& s) { return t < s.tick; });
+    --snap; // the first snapshot is at tick 0
+    MatchState state = sim.state();
+    unpackState(snap->state, state);
+    sim.restore(state);
+
+    m_Position = snap->tick;
+    m_NextCommand = static_cast<std::size_t>(
+        std::lower_bound(m_Commands.begin(), m_Commands.end(), m_Position,
+                         [](const Command& c, std::uint32_t t) { return c.tick < t; }) - m_Commands.begin());
+    m_NextRun = runAt(m_Position);
+    while (m_Position < tick)
+        advance(sim);
+}
+
+bool Player::advance(GameSimulation& sim) {
+    if (m_Position >= m_Ticks)
+        return false;
+    while (m_NextCommand < m_Commands.size() && m_Commands[m_NextCommand].tick <= m_Position) {
+        GameMode mode = m_Commands[m_NextCommand++].mode;
+        if (mode == GameMode::Menu)
+            sim.returnToMenu();
+        else
+            sim.start(mode);
+    }
+    while (m_NextRun + 1 < m_Runs.size() && m_Runs[m_NextRun + 1].start <= m_Position)
+        ++m_NextRun;
+    TickInput input = m_NextRun < m_Runs.size() ? decodeInput(m_Runs[m_NextRun].bits) : TickInput{};
+    sim.step(input, m_Header.dt);
+    ++m_Position;
+    return true;
+}
+
+/**
+ * @brief Runs are sorted by start tick; the last one starting at or before @p tick applies.
+ */
+std::size_t Player::runAt(std::uint32_t tick) const {
+    auto it = std::upper_bound(m_Runs.begin(), m_Runs.end(), tick,
+                               [](std::uint32_t t, const InputRun& r) { return t < r.start; });
+    return it == m_Runs.begin() ? 0 : static_cast<std::size_t>(it - m_Runs.begin()) - 1;
+}
+
+TickInput Player::inputAt(std::uint32_t tick) const {
+    if (m_Runs.empty() || m_Runs.front().start > tick)
+        return TickInput{};
+    return decodeInput(m_Runs[runAt(tick)].bits);
+}
+
+bool Player::snapshotAt(std::uint32_t tick, MatchState& state) const {
+    auto snap = std::lower_bound(m_Snapshots.begin(), m_Snapshots.end(), tick,
+                                 [](const Snapshot& s, std::uint32_t t) { return s.tick < t; });
+    if (snap == m_Snapshots.end() || snap->tick != tick)
+        return false;
+    unpackState(snap->state, state);
+    return true;
+}
+
+/**
+ * @brief Plays from tick 0 and packs the live state whenever a snapshot was recorded.
+ */
+bool Player::verify(GameSimulation& sim, std::uint32_t& divergentTick) {
+    seek(sim, 0);
+    PackedState live;
+    for (const Snapshot& snap : m_Snapshots) {
+        while (m_Position < snap.tick)
+            advance(sim);
+        packState(sim.state(), live);
+        if (live != snap.state) {
+            divergentTick = snap.tick;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace Replay
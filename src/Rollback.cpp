@@ -0,0 +1,233 @@
+/**
+ * @file Rollback.cpp
+ * @brief Implementation of the rollback session and its UDP transport.
+ * @author Oussama Amara
+ * @date 2025-08-26
+ */
+
+#include "Rollback.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+constexpr std::uint16_t Magic = 0x4E50;
+constexpr std::uint8_t Version = 1;
+constexpr std::uint32_t NoMisprediction = ~0u;
+
+std::uint8_t encode(const PlayerInput& input) {
+    return static_cast<std::uint8_t>((input.left ? 1 : 0) | (input.right ? 2 : 0));
+}
+
+PlayerInput decode(std::uint8_t bits) {
+    return PlayerInput{(bits & 1) != 0, (bits & 2) != 0};
+}
+
+/** @brief FNV-1a over the field size and tick length, so mismatched peers never pair up. */
+std::uint32_t configTag(Vec2 field, float dt) {
+    float values[] = {field.x, field.y, dt};
+    std::uint8_t bytes[sizeof values];
+    std::memcpy(bytes, values, sizeof values);
+    std::uint32_t hash = 2166136261u;
+    for (std::uint8_t b : bytes)
+        hash = (hash ^ b) * 16777619u;
+    return hash;
+}
+
+std::uint64_t nowNs() {
+    using namespace std::chrono;
+    return static_cast<std::uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+} // namespace
+
+/* **********************************
+***** UdpTransport *****
+**********************************/
+
+bool UdpTransport::open(std::uint16_t localPort, const NetAddress* peer) {
+    m_HasPeer = peer != nullptr;
+    if (peer)
+        m_Peer = *peer;
+    return m_Socket.open(localPort);
+}
+
+void UdpTransport::send(const std::uint8_t* data, std::size_t size) {
+    if (m_HasPeer)
+        m_Socket.sendTo(m_Peer, data, size);
+}
+
+/**
+ * @brief The first sender becomes the peer; datagrams from anyone else are dropped.
+ */
+bool UdpTransport::receive(std::vector<std::uint8_t>& packet) {
+    packet.resize(sizeof(NetPacketHeader) + RollbackSession::MaxPacketInputs);
+    NetAddress from;
+    long size;
+    while ((size = m_Socket.receive(packet.data(), packet.size(), from)) >= 0) {
+        if (!m_HasPeer) {
+            m_Peer = from;
+            m_HasPeer = true;
+            LOG_INFO("Peer connected from {}", from.toString());
+        }
+        if (from == m_Peer) {
+            packet.resize(static_cast<std::size_t>(size));
+            return true;
+        }
+    }
+    return false;
+}
+
+/* **********************************
+***** RollbackSession *****
+**********************************/
+
+/**
+ * @brief Starts a multiplayer match; nothing is simulated until the peer answers.
+ */
+RollbackSession::RollbackSession(GameSimulation& sim, int localPlayer, NetTransport& transport, float dt)
+    : m_Sim(sim),
+      m_Transport(transport),
+      m_Local(localPlayer),
+      m_Dt(dt),
+      m_Config(configTag(sim.resolution(), dt)),
+      m_Mispredicted(NoMisprediction),
+      m_States(HistorySize, sim.state()),
+      m_LocalInput(HistorySize, 0),
+      m_RemoteInput(HistorySize, 0)
+{
+    m_Sim.start(GameMode::Multiplayer);
+    m_Packet.reserve(sizeof(NetPacketHeader) + MaxPacketInputs);
+}
+
+RollbackSession::Status RollbackSession::advance(const PlayerInput& local) {
+    receive();
+    m_Stats.lastDepth = 0;
+    m_Stats.lastResimNs = 0;
+    if (!m_Connected) {
+        send(); // announces this peer until the other side answers
+        return Status::Waiting;
+    }
+    if (m_Mispredicted != NoMisprediction) {
+        resimulate(m_Mispredicted);
+        m_Mispredicted = NoMisprediction;
+    }
+
+    // Too far ahead of the peer: predictions would get long and its acks could fall out of the history
+    if (m_Frame >= m_RemoteConfirmed + MaxRollback || m_Frame - m_PeerAck >= HistorySize - MaxPacketInputs) {
+        ++m_Stats.stalls;
+        send();
+        return Status::Stalled;
+    }
+
+    m_LocalInput[m_Frame % HistorySize] = encode(local);
+    if (m_Frame >= m_RemoteConfirmed)
+        m_RemoteInput[m_Frame % HistorySize] = predictedRemote();
+    simulate(m_Frame);
+    ++m_Frame;
+    ++m_Stats.ticks;
+    send();
+    return Status::Advanced;
+}
+
+/**
+ * @brief Accepts the remote inputs that extend the confirmed run and notes the earliest
+ * one that contradicts the prediction it was played with.
+ */
+void RollbackSession::receive() {
+    std::vector<std::uint8_t>& packet = m_Received;
+    while (m_Transport.receive(packet)) {
+        NetPacketHeader header;
+        if (packet.size() < sizeof header) {
+            ++m_Stats.packetsRejected;
+            continue;
+        }
+        std::memcpy(&header, packet.data(), sizeof header);
+        if (header.magic != Magic || header.version != Version || header.config != m_Config ||
+            packet.size() != sizeof header + header.count) {
+            ++m_Stats.packetsRejected;
+            continue;
+        }
+        ++m_Stats.packetsReceived;
+        if (!m_Connected)
+            LOG_INFO("Rollback session connected");
+        m_Connected = true;
+        m_PeerAck = std::max(m_PeerAck, std::min(header.ack, m_Frame));
+
+        const std::uint8_t* inputs = packet.data() + sizeof header;
+        for (std::uint32_t i = 0; i < header.count; ++i) {
+            std::uint32_t frame = header.firstFrame + i;
+            if (frame < m_RemoteConfirmed)
+                continue; // redundant copy of an input we already have
+            if (frame > m_RemoteConfirmed)
+                break;    // a gap: wait for a packet that fills it
+            std::uint8_t bits = inputs[i] & 3;
+            std::uint8_t& slot = m_RemoteInput[frame % HistorySize];
+            if (frame < m_Frame && slot != bits)
+                m_Mispredicted = std::min(m_Mispredicted, frame);
+            slot = bits;
+            ++m_RemoteConfirmed;
+        }
+    }
+}
+
+/**
+ * @brief Restores the state before @p from and plays every tick up to the present again,
+ * re-predicting the ticks that are still unconfirmed.
+ */
+void RollbackSession::resimulate(std::uint32_t from) {
+    std::uint64_t start = nowNs();
+    std::uint8_t prediction = predictedRemote();
+    for (std::uint32_t f = m_RemoteConfirmed; f < m_Frame; ++f)
+        m_RemoteInput[f % HistorySize] = prediction;
+
+    m_Sim.restore(m_States[from % HistorySize]);
+    for (std::uint32_t f = from; f < m_Frame; ++f)
+        simulate(f);
+
+    std::uint32_t depth = m_Frame - from;
+    m_Stats.lastDepth = depth;
+    m_Stats.maxDepth = std::max(m_Stats.maxDepth, depth);
+    m_Stats.resimulatedTicks += depth;
+    ++m_Stats.rollbacks;
+    m_Stats.lastResimNs = nowNs() - start;
+    m_Stats.totalResimNs += m_Stats.lastResimNs;
+}
+
+/**
+ * @brief Saves the state before the tick and plays it; a finished match restarts at once.
+ */
+void RollbackSession::simulate(std::uint32_t frame) {
+    m_States[frame % HistorySize] = m_Sim.state();
+    if (m_Sim.mode() != GameMode::Multiplayer)
+        m_Sim.start(GameMode::Multiplayer);
+    TickInput input;
+    input.players[m_Local] = decode(m_LocalInput[frame % HistorySize]);
+    input.players[1 - m_Local] = decode(m_RemoteInput[frame % HistorySize]);
+    m_Sim.step(input, m_Dt);
+}
+
+/**
+ * @brief Sends every local input the peer has not acknowledged, oldest first.
+ */
+void RollbackSession::send() {
+    std::uint32_t count = std::min(m_Frame - m_PeerAck, MaxPacketInputs);
+    NetPacketHeader header{Magic, Version, static_cast<std::uint8_t>(count), m_Config, m_PeerAck, m_RemoteConfirmed};
+    m_Packet.resize(sizeof header + count);
+    std::memcpy(m_Packet.data(), &header, sizeof header);
+    for (std::uint32_t i = 0; i < count; ++i)
+        m_Packet[sizeof header + i] = m_LocalInput[(m_PeerAck + i) % HistorySize];
+    m_Transport.send(m_Packet.data(), m_Packet.size());
+    ++m_Stats.packetsSent;
+}
+
+/** @brief The remote player is assumed to keep holding the last keys we know of. */
+std::uint8_t RollbackSession::predictedRemote() const {
+    return m_RemoteConfirmed > 0 ? m_RemoteInput[(m_RemoteConfirmed - 1) % HistorySize] : 0;
+}
+
+const MatchState* RollbackSession::savedState(std::uint32_t frame) const {
+    if (frame >= m_Frame || m_Frame - frame > HistorySize)
+        return nullptr;
+    return &m_States[frame % HistorySize];
+}
@@ -0,0 +1,74 @@
+/**
+ * @file SceneRecorder.cpp
+ * @brief Implementation of the screen recorder shared by the window and headless measurement.
+ * @author Oussama Amara
+ * @date 2025-09-03
+ */
+
+#include "SceneRecorder.hpp"
+#include <string>
+
+/**
+ * @brief Records the values the HUD shows and reports whether they differ from the last frame.
+ * @param key Mode (1 single player, 2 multiplayer, 3 multi-ball) followed by the shown values.
+ */
+bool SceneRecorder::hudChanged(const std::array<int, 5>& key) {
+    if (key == m_HudKey)
+        return false;
+    m_HudKey = key;
+    return true;
+}
+
+void SceneRecorder::rebuildHud(std::string_view left, std::string_view right) {
+    m_HudRects.clear();
+    Hud::appendHud(m_HudRects, left, right, m_Resolution, m_HudStyle);
+}
+
+void SceneRecorder::recordMenu(RenderQueue& queue) {
+    static const std::size_t menuVertices = RenderQueue::glyphVertices(Hud::MenuText);
+    queue.clear();
+    queue.text(MenuTextResource, GameFont, menuVertices, RenderLayer::Hud);
+}
+
+void SceneRecorder::recordSingleplayer(RenderQueue& queue, const Bat& bat, const Ball& ball, int score, int lives,
+                                       int highScore, float alpha) {
+    if (hudChanged({1, score, lives, highScore, 0}))
+        rebuildHud(Hud::singleplayer(score, lives, highScore), "");
+    queue.clear();
+    queue.quad(bat.getRenderBounds(alpha));
+    queue.quad(ball.getRenderBounds(alpha));
+    queue.quads(m_HudRects, RenderQueue::White, RenderLayer::Hud);
+}
+
+void SceneRecorder::recordMultiplayer(RenderQueue& queue, const Bat& bat1, const Bat& bat2, const Ball& ball,
+                                      int score1, int lives1, int score2, int lives2, float alpha) {
+    if (hudChanged({2, score1, lives1, score2, lives2}))
+        rebuildHud(Hud::player(score1, lives1), Hud::player(score2, lives2));
+    queue.clear();
+    queue.quad(bat1.getRenderBounds(alpha));
+    queue.quad(bat2.getRenderBounds(alpha));
+    queue.quad(ball.getRenderBounds(alpha));
+    queue.quads(m_HudRects, RenderQueue::White, RenderLayer::Hud);
+}
+
+void SceneRecorder::recordChaos(RenderQueue& queue, const ChaosSimulation& chaos, float alpha) {
+    if (hudChanged({3, chaos.score(0), chaos.score(1), 0, 0}))
+        rebuildHud("Score:" + std::to_string(chaos.score(0)), "Score:" + std::to_string(chaos.score(1)));
+    queue.clear();
+    queue.quad(chaos.bat(0).getRenderBounds(alpha));
+    queue.quad(chaos.bat(1).getRenderBounds(alpha));
+    const EntityStore& balls = chaos.entities();
+    for (std::size_t i = 0; i < balls.size(); ++i)
+        queue.quad(balls.renderBounds(i, alpha));
+    queue.quads(m_HudRects, RenderQueue::White, RenderLayer::Hud);
+}
+
+void SceneRecorder::recordMatch(RenderQueue& queue, const MatchState& state, float alpha) {
+    if (state.mode == GameMode::Menu)
+        recordMenu(queue);
+    else if (state.mode == GameMode::Singleplayer)
+        recordSingleplayer(queue, state.bats[0], state.ball, state.score[0], state.lives[0], state.highScore, alpha);
+    else
+        recordMultiplayer(queue, state.bats[0], state.bats[1], state.ball, state.score[0], state.lives[0],
+                          state.score[1], state.lives[1], alpha);
+}
@@ -0,0 +1,64 @@
+/**
+ * @file SfmlRenderBackend.cpp
+ * @brief Implementation of the SFML render backend.
+ * @author Oussama Amara
+ * @date 2025-09-03
+ */
+
+#include "SfmlRenderBackend.hpp"
+
+void SfmlRenderBackend::setResource(std::uint32_t handle, const sf::Drawable& drawable) {
+    if (handle >= m_Resources.size())
+        m_Resources.resize(handle + 1, nullptr);
+    m_Resources[handle] = &drawable;
+}
+
+void SfmlRenderBackend::clear(std::uint32_t color) {
+    if (m_Target)
+        m_Target->clear(sf::Color(color));
+}
+
+/**
+ * @brief Updates the run's batch with the rectangles that changed and draws it in one call.
+ */
+void SfmlRenderBackend::drawQuads(const RenderQuad* quads, std::size_t count) {
+    if (!m_Target)
+        return;
+    if (m_NextRun == m_Runs.size())
+        m_Runs.emplace_back();
+    BatchRenderer& batch = m_Runs[m_NextRun++];
+    if (batch.size() != count)
+        batch.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+        batch.set(i, quads[i].rect, sf::Color(quads[i].color));
+    m_Target->draw(batch);
+    ++m_DrawCalls;
+}
+
+void SfmlRenderBackend::drawResource(std::uint32_t handle) {
+    if (!m_Target || handle >= m_Resources.size() || !m_Resources[handle])
+        return;
+    m_Target->draw(*m_Resources[handle]);
+    ++m_DrawCalls;
+}
+
+void SfmlRenderBackend::drawText(std::uint32_t handle, std::size_t) {
+    drawResource(handle);
+}
+
+void SfmlRenderBackend::drawMesh(std::uint32_t handle, std::size_t) {
+    drawResource(handle);
+}
+
+std::size_t SfmlRenderBackend::takeDrawCalls() {
+    std::size_t calls = m_DrawCalls;
+    m_DrawCalls = 0;
+    return calls;
+}
+
+std::size_t SfmlRenderBackend::takeRewrites() {
+    std::size_t rewrites = 0;
+    for (BatchRenderer& batch : m_Runs)
+        rewrites += batch.takeRewrites();
+    return rewrites;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file SharedMemory.cpp
+ * @brief Implementation of SharedMemory for POSIX and Windows.
+ * @author Oussama Amara
+ * @date 2025-09-01
+ */
+
+#include "SharedMemory.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+#ifdef _WIN32
+std::string objectName(const std::string& name) {
+    return "Local\\" + name;
+}
+#else
+std::string objectName(const std::string& name) {
+    return "/" + name;
+}
+#endif
+} // namespace
+
+SharedMemory::~SharedMemory() {
+    close();
+}
+
+/**
+ * @brief Creates the object from scratch, so readers of a previous run never see it change under them.
+ */
+bool SharedMemory::create(const std::string& name, std::size_t size) {
+    close();
+    if (size == 0)
+        return false;
+#ifdef _WIN32
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                        static_cast<DWORD>(static_cast<std::uint64_t>(size) >> 32),
+                                        static_cast<DWORD>(size), objectName(name).c_str());
+    if (!mapping)
+        return false;
+    if (GetLastError() == ERROR_ALREADY_EXISTS) { // Windows objects vanish with their last handle
+        CloseHandle(mapping);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+    if (!view) {
+        CloseHandle(mapping);
+        return false;
+    }
+    m_Mapping = reinterpret_cast<std::intptr_t>(mapping);
+#else
+    const std::string path = objectName(name);
+    shm_unlink(path.c_str()); // a crashed run may have left its object behind
+    int fd = shm_open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0)
+        return false;
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        shm_unlink(path.c_str());
+        return false;
+    }
+    void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping keeps the object alive
+    if (view == MAP_FAILED) {
+        shm_unlink(path.c_str());
+        return false;
+    }
+#endif
+    m_Data = static_cast<std::uint8_t*>(view);
+    m_Size = size;
+    m_Name = name;
+    return true;
+}
+
+/**
+ * @brief Maps the whole object without write access.
+ */
+bool SharedMemory::openReadOnly(const std::string& name) {
+    close();
+#ifdef _WIN32
+    HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, objectName(name).c_str());
+    if (!mapping)
+        return false;
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    MEMORY_BASIC_INFORMATION info;
+    if (!view || VirtualQuery(view, &info, sizeof info) == 0) {
+        if (view)
+            UnmapViewOfFile(view);
+        CloseHandle(mapping);
+        return false;
+    }
+    m_Mapping = reinterpret_cast<std::intptr_t>(mapping);
+    m_Size = static_cast<std::size_t>(info.RegionSize);
+#else
+    int fd = shm_open(objectName(name).c_str(), O_RDONLY, 0);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    void* view = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+        view = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED)
+        return false;
+    m_Size = static_cast<std::size_t>(st.st_size);
+#endif
+    m_Data = static_cast<std::uint8_t*>(view);
+    return true;
+}
+
+/**
+ * @brief Releases the view; the creator also drops the name.
+ */
+void SharedMemory::close() {
+    if (!m_Data)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(m_Data);
+    CloseHandle(reinterpret_cast<HANDLE>(m_Mapping));
+    m_Mapping = 0;
+#else
+    munmap(m_Data, m_Size);
+    if (!m_Name.empty())
+        shm_unlink(objectName(m_Name).c_str());
+#endif
+    m_Data = nullptr;
+    m_Size = 0;
+    m_Name.clear();
+}
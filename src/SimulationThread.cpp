@@ -0,0 +1,98 @@
+/**
+ * @file SimulationThread.cpp
+ * @brief Implementation of the simulation thread, its command ring and the snapshot metrics.
+ * @author Oussama Amara
+ * @date 2025-08-31
+ */
+
+#include "SimulationThread.hpp"
+#include "FrameProfiler.hpp"
+#include "Logger.hpp"
+
+SimulationThread::SimulationThread(GameSimulation& sim, double tickRate, TickFn tick, CommandFn command)
+    : m_Sim(sim), m_Pacer(tickRate, false), m_Tick(std::move(tick)), m_Command(std::move(command)),
+      m_Snapshots(SimSnapshot{sim.state(), 0, FrameProfiler::now()}) {}
+
+SimulationThread::~SimulationThread() {
+    stop();
+}
+
+void SimulationThread::start() {
+    if (m_Running.exchange(true))
+        return;
+    m_Pacer.resync();
+    m_Thread = std::thread(&SimulationThread::run, this);
+    LOG_INFO("Simulation thread started at {} Hz", m_Pacer.target());
+}
+
+void SimulationThread::stop() {
+    if (!m_Running.exchange(false))
+        return;
+    m_Thread.join();
+    LOG_INFO("Simulation thread stopped after {} ticks", m_Ticks.load());
+}
+
+bool SimulationThread::post(const SimCommand& command) {
+    std::size_t tail = m_CommandTail.load(std::memory_order_relaxed);
+    if (tail - m_CommandHead.load(std::memory_order_acquire) == CommandCapacity) {
+        ++m_CommandsLost;
+        return false;
+    }
+    m_Commands[tail % CommandCapacity] = command;
+    m_CommandTail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Waits for the tick's deadline, applies the commands that arrived, ticks and publishes.
+ */
+void SimulationThread::run() {
+    while (m_Running.load(std::memory_order_relaxed)) {
+        m_Pacer.wait();
+
+        std::size_t head = m_CommandHead.load(std::memory_order_relaxed);
+        const std::size_t tail = m_CommandTail.load(std::memory_order_acquire);
+        for (; head != tail; ++head)
+            m_Command(m_Commands[head % CommandCapacity]);
+        m_CommandHead.store(head, std::memory_order_release);
+
+        std::uint64_t applied;
+        {
+            ScopedTimer timer(Phase::Simulation);
+            applied = m_Tick(FrameProfiler::now());
+        }
+
+        SimSnapshot& snapshot = m_Snapshots.back();
+        snapshot.applied = applied;
+        snapshot.state = m_Sim.state();
+        snapshot.sequence = m_Ticks.fetch_add(1, std::memory_order_relaxed) + 1;
+        snapshot.publishedNs = FrameProfiler::now();
+        m_Snapshots.publish();
+    }
+}
+
+const SimSnapshot& SimulationThread::acquire() {
+    const bool fresh = m_Snapshots.update();
+    const SimSnapshot& snapshot = m_Snapshots.front();
+    if (m_Drawn > 0) {
+        if (!fresh)
+            ++m_Duplicated;
+        else if (!m_SkipDropped && snapshot.sequence > m_LastSequence + 1)
+            m_Dropped += snapshot.sequence - m_LastSequence - 1;
+    }
+    m_SkipDropped = false;
+    m_LastSequence = snapshot.sequence;
+    ++m_Drawn;
+    FrameProfiler::instance().record(Phase::SnapshotAge, FrameProfiler::now() - snapshot.publishedNs);
+    return snapshot;
+}
+
+SimThreadStats SimulationThread::stats() const {
+    SimThreadStats s;
+    s.ticks = m_Ticks.load(std::memory_order_relaxed);
+    s.drawn = m_Drawn;
+    s.duplicated = m_Duplicated;
+    s.dropped = m_Dropped;
+    s.commandsLost = m_CommandsLost;
+    return s;
+}
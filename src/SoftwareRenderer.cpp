@@ -0,0 +1,159 @@
+/**
+ * @file SoftwareRenderer.cpp
+ * @brief Implementation of the span-filling software renderer.
+ * @author Oussama Amara
+ * @date 2025-09-02
+ */
+
+#include "SoftwareRenderer.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PONG_RASTER_SSE2 1
+#endif
+
+namespace {
+/**
+ * @brief Fills one row span; four pixels per 128-bit store, the tail one by one.
+ */
+void fillSpan(std::uint32_t* row, int count, std::uint32_t color) {
+    int i = 0;
+#ifdef PONG_RASTER_SSE2
+    const __m128i value = _mm_set1_epi32(static_cast<int>(color));
+    for (; i + 16 <= count; i += 16) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row + i), value);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row + i + 4), value);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row + i + 8), value);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row + i + 12), value);
+    }
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row + i), value);
+#endif
+    for (; i < count; ++i)
+        row[i] = color;
+}
+
+/** @brief A pixel is covered when its centre is inside the rectangle. */
+int snap(float v) {
+    return static_cast<int>(std::floor(v + 0.5f));
+}
+} // namespace
+
+SoftwareRenderer::SoftwareRenderer(int width, int height)
+    : m_Width(std::max(1, width)), m_Height(std::max(1, height)),
+      m_Pixels(static_cast<std::size_t>(m_Width) * static_cast<std::size_t>(m_Height), Background) {}
+
+const char* SoftwareRenderer::fillBackend() {
+#ifdef PONG_RASTER_SSE2
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+/**
+ * @brief Starts a frame: clears what the previous frame drew and records it as damage,
+ * or clears everything after invalidate().
+ */
+void SoftwareRenderer::begin() {
+    m_Filled = 0;
+    m_Damage.clear();
+    m_Previous.swap(m_Drawn);
+    m_Drawn.clear();
+    if (m_FullDamage) {
+        const PixelRect all{0, 0, m_Width, m_Height};
+        fillPixels(all, Background);
+        m_Damage.push_back(all);
+        m_FullDamage = false;
+        return;
+    }
+    for (const PixelRect& r : m_Previous) {
+        fillPixels(r, Background);
+        m_Damage.push_back(r);
+    }
+}
+
+void SoftwareRenderer::fillPixels(const PixelRect& r, std::uint32_t color) {
+    const int count = r.x1 - r.x0;
+    std::uint32_t* row = m_Pixels.data() + static_cast<std::size_t>(r.y0) * m_Width + r.x0;
+    for (int y = r.y0; y < r.y1; ++y, row += m_Width)
+        fillSpan(row, count, color);
+    m_Filled += static_cast<std::uint64_t>(count) * static_cast<std::uint64_t>(r.y1 - r.y0);
+}
+
+/**
+ * @brief Snaps, clips and fills one rectangle, remembering it for the next frame's clear.
+ */
+void SoftwareRenderer::fill(const Aabb& rect, std::uint32_t color) {
+    PixelRect r;
+    r.x0 = std::clamp(snap(rect.x), 0, m_Width);
+    r.y0 = std::clamp(snap(rect.y), 0, m_Height);
+    r.x1 = std::clamp(snap(rect.x + rect.w), 0, m_Width);
+    r.y1 = std::clamp(snap(rect.y + rect.h), 0, m_Height);
+    if (r.x0 >= r.x1 || r.y0 >= r.y1)
+        return;
+    fillPixels(r, color);
+    m_Drawn.push_back(r);
+    m_Damage.push_back(r);
+}
+
+/**
+ * @brief Records the values the HUD shows and reports whether they differ from the last frame.
+ * @param key Screen (1 single player, 2 multiplayer, 4 menu) followed by the shown values.
+ */
+bool SoftwareRenderer::hudChanged(const std::array<int, 5>& key) {
+    if (key == m_HudKey)
+        return false;
+    m_HudKey = key;
+    m_HudRects.clear();
+    return true;
+}
+
+void SoftwareRenderer::drawHud() {
+    for (const Aabb& r : m_HudRects)
+        fill(r, Foreground);
+}
+
+/**
+ * @brief Draws the menu lines in the dot-matrix font, where DisplayManager puts its text.
+ */
+void SoftwareRenderer::renderMenu() {
+    begin();
+    if (hudChanged({4, 0, 0, 0, 0}))
+        Hud::appendPixelText(m_HudRects, Hud::MenuText, static_cast<float>(m_Width) / 2.f - 400.f,
+                             static_cast<float>(m_Height) / 2.f - 100.f, m_MenuStyle);
+    drawHud();
+}
+
+void SoftwareRenderer::renderSingleplayer(const Bat& bat, const Ball& ball, int score, int lives, int highScore,
+                                          float alpha) {
+    begin();
+    if (hudChanged({1, score, lives, highScore, 0}))
+        Hud::appendHud(m_HudRects, Hud::singleplayer(score, lives, highScore), "", field(), m_HudStyle);
+    drawHud();
+    fill(bat.getRenderBounds(alpha), Foreground);
+    fill(ball.getRenderBounds(alpha), Foreground);
+}
+
+void SoftwareRenderer::renderMultiplayer(const Bat& bat1, const Bat& bat2, const Ball& ball, int score1, int lives1,
+                                         int score2, int lives2, float alpha) {
+    begin();
+    if (hudChanged({2, score1, lives1, score2, lives2}))
+        Hud::appendHud(m_HudRects, Hud::player(score1, lives1), Hud::player(score2, lives2), field(), m_HudStyle);
+    drawHud();
+    fill(bat1.getRenderBounds(alpha), Foreground);
+    fill(bat2.getRenderBounds(alpha), Foreground);
+    fill(ball.getRenderBounds(alpha), Foreground);
+}
+
+void SoftwareRenderer::renderMatch(const MatchState& state, float alpha) {
+    if (state.mode == GameMode::Menu)
+        renderMenu();
+    else if (state.mode == GameMode::Singleplayer)
+        renderSingleplayer(state.bats[0], state.ball, state.score[0], state.lives[0], state.highScore, alpha);
+    else
+        renderMultiplayer(state.bats[0], state.bats[1], state.ball, state.score[0], state.lives[0], state.score[1],
+                          state.lives[1], alpha);
+}
@@ -0,0 +1,188 @@
+/**
+ * @file SpectatorFeed.cpp
+ * @brief Implementation of the shared-memory spectator ring: seqlock writer and readers.
+ * @author Oussama Amara
+ * @date 2025-09-01
+ */
+
+#include "SpectatorFeed.hpp"
+#include "Logger.hpp"
+#include <chrono>
+#include <cstring>
+#include <new>
+
+namespace {
+constexpr std::uint32_t Magic = 0x43505350; // "PSPC" in memory order on little-endian machines
+constexpr std::uint16_t Version = 1;
+
+std::size_t ringBytes(std::uint32_t slots) {
+    return sizeof(SpectatorHeader) + static_cast<std::size_t>(slots) * sizeof(SpectatorSlot);
+}
+} // namespace
+
+std::uint64_t SpectatorFeed::now() {
+    using namespace std::chrono;
+    return static_cast<std::uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+SpectatorFrame SpectatorFeed::makeFrame(const MatchState& state) {
+    SpectatorFrame frame;
+    frame.tick = state.tick;
+    frame.mode = static_cast<std::uint8_t>(state.mode);
+    frame.ball = state.ball.getPosition();
+    frame.ballVelocity[0] = state.ball.getXVelocity() * state.ball.getSpeed();
+    frame.ballVelocity[1] = state.ball.getYVelocity() * state.ball.getSpeed();
+    for (int i = 0; i < 2; ++i) {
+        frame.bats[i] = state.bats[i].getPosition();
+        frame.score[i] = state.score[i];
+        frame.lives[i] = state.lives[i];
+    }
+    frame.highScore = state.highScore;
+    frame.timeElapsed = state.timeElapsed;
+    return frame;
+}
+
+/**
+ * @brief Creates the object, constructs the header and slots in it, and marks it ready last.
+ */
+bool SpectatorFeed::open(const std::string& name, Vec2 field, std::uint32_t slots) {
+    close();
+    if (slots == 0 || !m_Memory.create(name, ringBytes(slots))) {
+        LOG_ERROR("Failed to create the spectator feed {}", name);
+        return false;
+    }
+    // The memory is zero-filled, which is also the state the atomics start in
+    m_Header = new (m_Memory.data()) SpectatorHeader{};
+    m_Slots = reinterpret_cast<SpectatorSlot*>(m_Memory.data() + sizeof(SpectatorHeader));
+    for (std::uint32_t i = 0; i < slots; ++i)
+        new (&m_Slots[i]) SpectatorSlot{};
+    m_SlotCount = slots;
+    m_Published = 0;
+    m_Header->version = Version;
+    m_Header->frameSize = sizeof(SpectatorFrame);
+    m_Header->slotCount = slots;
+    m_Header->width = field.x;
+    m_Header->height = field.y;
+    m_Header->magic.store(Magic, std::memory_order_release);
+    LOG_INFO("Spectator feed {} open: {} slots, {} bytes", name, slots, m_Memory.size());
+    return true;
+}
+
+void SpectatorFeed::close() {
+    if (!m_Header)
+        return;
+    m_Memory.close();
+    m_Header = nullptr;
+    m_Slots = nullptr;
+    m_SlotCount = 0;
+}
+
+/**
+ * @brief Seqlock write: odd version, payload, even version, then the head.
+ * The release fence keeps the payload stores from moving above the odd version.
+ */
+void SpectatorFeed::publish(SpectatorFrame frame) {
+    if (!m_Header)
+        return;
+    const std::uint64_t sequence = ++m_Published;
+    frame.sequence = sequence;
+    frame.publishedNs = now();
+    std::uint32_t words[SpectatorSlot::Words];
+    std::memcpy(words, &frame, sizeof frame);
+
+    SpectatorSlot& slot = m_Slots[(sequence - 1) % m_SlotCount];
+    slot.version.store(2 * sequence - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t i = 0; i < SpectatorSlot::Words; ++i)
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    slot.version.store(2 * sequence, std::memory_order_release);
+    m_Header->head.store(sequence, std::memory_order_release);
+}
+
+/**
+ * @brief Maps the feed and checks that it is complete and laid out like this build expects.
+ */
+bool SpectatorReader::open(const std::string& name) {
+    close();
+    if (!m_Memory.openReadOnly(name))
+        return false;
+    const auto* header = reinterpret_cast<const SpectatorHeader*>(m_Memory.data());
+    if (m_Memory.size() < sizeof(SpectatorHeader) || header->magic.load(std::memory_order_acquire) != Magic ||
+        header->version != Version || header->frameSize != sizeof(SpectatorFrame) || header->slotCount == 0 ||
+        m_Memory.size() < ringBytes(header->slotCount)) {
+        m_Memory.close();
+        return false;
+    }
+    m_Header = header;
+    m_Slots = reinterpret_cast<const SpectatorSlot*>(m_Memory.data() + sizeof(SpectatorHeader));
+    m_SlotCount = header->slotCount;
+    m_Next = 0;
+    m_Lost = 0;
+    m_Collisions = 0;
+    return true;
+}
+
+void SpectatorReader::close() {
+    m_Memory.close();
+    m_Header = nullptr;
+    m_Slots = nullptr;
+    m_SlotCount = 0;
+}
+
+/**
+ * @brief Seqlock read: version, payload, version; the frame counts only if both versions
+ * say the slot held @p sequence throughout.
+ */
+bool SpectatorReader::readSlot(std::uint64_t sequence, SpectatorFrame& out) {
+    const SpectatorSlot& slot = m_Slots[(sequence - 1) % m_SlotCount];
+    const std::uint64_t before = slot.version.load(std::memory_order_acquire);
+    if (before != 2 * sequence)
+        return false;
+    std::uint32_t words[SpectatorSlot::Words];
+    for (std::size_t i = 0; i < SpectatorSlot::Words; ++i)
+        words[i] = slot.words[i].load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.version.load(std::memory_order_relaxed) != before) {
+        ++m_Collisions;
+        return false;
+    }
+    std::memcpy(&out, words, sizeof out);
+    return true;
+}
+
+bool SpectatorReader::next(SpectatorFrame& out) {
+    if (!m_Header)
+        return false;
+    std::uint64_t head = m_Header->head.load(std::memory_order_acquire);
+    if (head == 0)
+        return false;
+    if (m_Next == 0)
+        m_Next = head;
+    while (m_Next <= head) {
+        // Frames a whole ring behind the head are gone already
+        if (head - m_Next >= m_SlotCount) {
+            m_Lost += head - m_SlotCount + 1 - m_Next;
+            m_Next = head - m_SlotCount + 1;
+        }
+        if (readSlot(m_Next++, out))
+            return true;
+        // The writer got to this slot first; its frame is lost, the next one may not be
+        ++m_Lost;
+        head = m_Header->head.load(std::memory_order_acquire);
+    }
+    return false;
+}
+
+bool SpectatorReader::latest(SpectatorFrame& out) {
+    if (!m_Header)
+        return false;
+    // Failing needs the writer to lap the whole ring during one read; a few tries suffice
+    for (int attempt = 0; attempt < 4; ++attempt) {
+        const std::uint64_t head = m_Header->head.load(std::memory_order_acquire);
+        if (head == 0)
+            return false;
+        if (readSlot(head, out))
+            return true;
+    }
+    return false;
+}
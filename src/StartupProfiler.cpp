@@ -0,0 +1,56 @@
+/**
+ * @file StartupProfiler.cpp
+ * @brief Implementation of the startup phase profiler.
+ * @author Oussama Amara
+ * @date 2025-09-04
+ */
+
+#include "StartupProfiler.hpp"
+#include "FrameProfiler.hpp"
+#include <cstdio>
+
+StartupProfiler::StartupProfiler() : m_Origin(FrameProfiler::now()), m_MainThread(std::this_thread::get_id()) {}
+
+StartupProfiler& StartupProfiler::instance() {
+    static StartupProfiler profiler;
+    return profiler;
+}
+
+std::uint64_t StartupProfiler::elapsedNs() const {
+    return FrameProfiler::now() - m_Origin;
+}
+
+void StartupProfiler::record(const char* name, std::uint64_t startNs) {
+    const std::uint64_t end = elapsedNs();
+    const bool main = std::this_thread::get_id() == m_MainThread;
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Phases.push_back(StartupPhase{name, startNs, end - startNs, main});
+}
+
+void StartupProfiler::finish() {
+    const std::uint64_t end = elapsedNs();
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_TotalNs == 0)
+        m_TotalNs = end;
+}
+
+std::uint64_t StartupProfiler::totalNs() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_TotalNs;
+}
+
+std::string StartupProfiler::summary() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::string out;
+    char line[128];
+    std::snprintf(line, sizeof line, "%-20s %9s %9s  %s\n", "phase", "start ms", "ms", "thread");
+    out += line;
+    for (const StartupPhase& p : m_Phases) {
+        std::snprintf(line, sizeof line, "%-20s %9.2f %9.2f  %s\n", p.name, p.startNs / 1e6, p.durationNs / 1e6,
+                      p.mainThread ? "main" : "loader");
+        out += line;
+    }
+    std::snprintf(line, sizeof line, "%-20s %9s %9.2f\n", "boot to first frame", "", m_TotalNs / 1e6);
+    out += line;
+    return out;
+}
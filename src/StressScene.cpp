@@ -0,0 +1,36 @@
+/**
+ * @file StressScene.cpp
+ * @brief Implementation of the renderer stress scene.
+ * @author Oussama Amara
+ * @date 2025-08-22
+ */
+
+#include "StressScene.hpp"
+#include <random>
+
+StressScene::StressScene(std::size_t count, Vec2 resolution, std::uint32_t seed)
+    : m_Resolution(resolution), m_Boxes(count), m_Velocities(count) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> size(4.f, 16.f), speed(-400.f, 400.f);
+    for (std::size_t i = 0; i < count; ++i) {
+        Aabb& b = m_Boxes[i];
+        b.w = size(rng);
+        b.h = b.w;
+        b.x = std::uniform_real_distribution<float>(0.f, resolution.x - b.w)(rng);
+        b.y = std::uniform_real_distribution<float>(0.f, resolution.y - b.h)(rng);
+        m_Velocities[i] = Vec2{speed(rng), speed(rng)};
+    }
+}
+
+void StressScene::update(float dt) {
+    for (std::size_t i = 0; i < m_Boxes.size(); ++i) {
+        Aabb& b = m_Boxes[i];
+        Vec2& v = m_Velocities[i];
+        b.x += v.x * dt;
+        b.y += v.y * dt;
+        if ((b.x < 0.f && v.x < 0.f) || (b.x + b.w > m_Resolution.x && v.x > 0.f))
+            v.x = -v.x;
+        if ((b.y < 0.f && v.y < 0.f) || (b.y + b.h > m_Resolution.y && v.y > 0.f))
+            v.y = -v.y;
+    }
+}
@@ -0,0 +1,96 @@
+/**
+ * @file Trace.cpp
+ * @brief Implementation of the memory-mapped binary trace writer.
+ * @author Oussama Amara
+ * @date 2025-08-10
+ */
+
+#include "Trace.hpp"
+#include <chrono>
+#include <cstring>
+
+/**
+ * @brief Maps an event id to its name for tools and diagnostics.
+ */
+const char* traceEventName(TraceEvent event) {
+    switch (event) {
+        case TraceEvent::SessionStart: return "SessionStart";
+        case TraceEvent::StateChange:  return "StateChange";
+        case TraceEvent::BallUpdate:   return "BallUpdate";
+        case TraceEvent::BallRebound:  return "BallRebound";
+        case TraceEvent::BatUpdate:    return "BatUpdate";
+        case TraceEvent::Score:        return "Score";
+        case TraceEvent::Lives:        return "Lives";
+        case TraceEvent::HighScore:    return "HighScore";
+        case TraceEvent::SessionEnd:   return "SessionEnd";
+        case TraceEvent::BallContact:  return "BallContact";
+        default:                       return "Unknown";
+    }
+}
+
+/**
+ * @brief Returns the shared trace writer.
+ */
+Trace& Trace::instance() {
+    static Trace trace;
+    return trace;
+}
+
+Trace::~Trace() {
+    close();
+}
+
+/**
+ * @brief Monotonic clock in nanoseconds.
+ */
+std::uint64_t Trace::now() {
+    using namespace std::chrono;
+    return static_cast<std::uint64_t>(
+        duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief Creates the trace file with room for a first batch of records and writes the header.
+ */
+bool Trace::open(const std::string& path) {
+    close();
+    if (!m_File.open(path, MappedFile::Mode::ReadWrite, sizeof(TraceHeader) + GrowRecords * sizeof(TraceRecord)))
+        return false;
+    m_Capacity = GrowRecords;
+    m_Count = 0;
+    m_StartNs = now();
+
+    TraceHeader* h = header();
+    std::memcpy(h->magic, "PTRC", 4);
+    h->version = 1;
+    h->recordSize = sizeof(TraceRecord);
+    h->recordCount = 0;
+    h->startNs = m_StartNs;
+    m_Enabled = true;
+    return true;
+}
+
+/**
+ * @brief Extends the file by another batch of records.
+ */
+bool Trace::grow() {
+    std::size_t capacity = m_Capacity + GrowRecords;
+    if (!m_File.resize(sizeof(TraceHeader) + capacity * sizeof(TraceRecord))) {
+        m_Enabled = false;
+        return false;
+    }
+    m_Capacity = capacity;
+    return true;
+}
+
+/**
+ * @brief Trims unused preallocated space and releases the mapping.
+ */
+void Trace::close() {
+    if (!m_File.isOpen())
+        return;
+    m_Enabled = false;
+    m_File.resize(sizeof(TraceHeader) + m_Count * sizeof(TraceRecord));
+    m_File.close();
+    m_Capacity = 0;
+}
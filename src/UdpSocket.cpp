@@ -0,0 +1,150 @@
+/**
+ * @file UdpSocket.cpp
+ * @brief Implementation of UdpSocket for POSIX and Windows.
+ * @author Oussama Amara
+ * @date 2025-08-26
+ */
+
+#include "UdpSocket.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+#include <cstring>
+
+namespace {
+#ifdef _WIN32
+/** @brief Winsock must be initialised once per process before any socket call. */
+bool startNetworking() {
+    static const bool started = [] {
+        WSADATA data;
+        return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }();
+    return started;
+}
+#else
+bool startNetworking() { return true; }
+#endif
+
+sockaddr_in toSockaddr(const NetAddress& address) {
+    sockaddr_in sa;
+    std::memset(&sa, 0, sizeof sa);
+    sa.sin_family = AF_INET;
+    sa.sin_addr.s_addr = htonl(address.ip);
+    sa.sin_port = htons(address.port);
+    return sa;
+}
+} // namespace
+
+std::string NetAddress::toString() const {
+    return std::to_string(ip >> 24) + "." + std::to_string((ip >> 16) & 0xFF) + "." +
+           std::to_string((ip >> 8) & 0xFF) + "." + std::to_string(ip & 0xFF) + ":" + std::to_string(port);
+}
+
+bool NetAddress::resolve(const std::string& host, std::uint16_t port, NetAddress& out) {
+    if (!startNetworking())
+        return false;
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof hints);
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host.c_str(), nullptr, &hints, &result) != 0 || !result)
+        return false;
+    const auto* sa = reinterpret_cast<const sockaddr_in*>(result->ai_addr);
+    out.ip = ntohl(sa->sin_addr.s_addr);
+    out.port = port;
+    freeaddrinfo(result);
+    return true;
+}
+
+UdpSocket::~UdpSocket() {
+    close();
+}
+
+/**
+ * @brief Creates the socket, binds it and switches it to non-blocking mode.
+ */
+bool UdpSocket::open(std::uint16_t port) {
+    close();
+    if (!startNetworking())
+        return false;
+#ifdef _WIN32
+    SOCKET s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s == INVALID_SOCKET)
+        return false;
+    u_long nonBlocking = 1;
+    ioctlsocket(s, FIONBIO, &nonBlocking);
+#else
+    int s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s < 0)
+        return false;
+    fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK);
+#endif
+    m_Handle = static_cast<std::intptr_t>(s);
+
+    sockaddr_in local = toSockaddr(NetAddress{INADDR_ANY, port});
+    socklen_t length = sizeof local;
+    if (bind(s, reinterpret_cast<const sockaddr*>(&local), sizeof local) != 0 ||
+        getsockname(s, reinterpret_cast<sockaddr*>(&local), &length) != 0) {
+        close();
+        return false;
+    }
+    m_Port = ntohs(local.sin_port);
+    return true;
+}
+
+void UdpSocket::close() {
+    if (m_Handle == InvalidHandle)
+        return;
+#ifdef _WIN32
+    closesocket(static_cast<SOCKET>(m_Handle));
+#else
+    ::close(static_cast<int>(m_Handle));
+#endif
+    m_Handle = InvalidHandle;
+    m_Port = 0;
+}
+
+bool UdpSocket::sendTo(const NetAddress& to, const void* data, std::size_t size) {
+    if (m_Handle == InvalidHandle)
+        return false;
+    sockaddr_in sa = toSockaddr(to);
+#ifdef _WIN32
+    int sent = sendto(static_cast<SOCKET>(m_Handle), static_cast<const char*>(data), static_cast<int>(size), 0,
+                      reinterpret_cast<const sockaddr*>(&sa), sizeof sa);
+#else
+    ssize_t sent = sendto(static_cast<int>(m_Handle), data, size, 0, reinterpret_cast<const sockaddr*>(&sa), sizeof sa);
+#endif
+    return sent == static_cast<decltype(sent)>(size);
+}
+
+long UdpSocket::receive(void* buffer, std::size_t capacity, NetAddress& from) {
+    if (m_Handle == InvalidHandle)
+        return -1;
+    sockaddr_in sa;
+    socklen_t length = sizeof sa;
+#ifdef _WIN32
+    int received = recvfrom(static_cast<SOCKET>(m_Handle), static_cast<char*>(buffer), static_cast<int>(capacity), 0,
+                            reinterpret_cast<sockaddr*>(&sa), &length);
+    // A datagram longer than the buffer is reported as an error on Windows; it is dropped
+    if (received < 0)
+        return -1;
+#else
+    ssize_t received = recvfrom(static_cast<int>(m_Handle), buffer, capacity, 0, reinterpret_cast<sockaddr*>(&sa), &length);
+    if (received < 0)
+        return -1;
+#endif
+    from.ip = ntohl(sa.sin_addr.s_addr);
+    from.port = ntohs(sa.sin_port);
+    return static_cast<long>(received);
+}
@@ -0,0 +1,92 @@
+/**
+ * @file UniformGrid.cpp
+ * @brief Implementation of the uniform-grid broadphase.
+ * @author Oussama Amara
+ * @date 2025-08-23
+ */
+
+#include "UniformGrid.hpp"
+#include <algorithm>
+#include <cmath>
+
+UniformGrid::UniformGrid(Vec2 size, float cellSize)
+    : m_Cols(std::max(1, static_cast<int>(std::ceil(size.x / cellSize)))),
+      m_Rows(std::max(1, static_cast<int>(std::ceil(size.y / cellSize)))),
+      m_CellSize(cellSize),
+      m_Head(static_cast<std::size_t>(m_Cols * m_Rows), -1),
+      m_Marks(static_cast<std::size_t>(m_Cols * m_Rows), 0)
+{
+}
+
+void UniformGrid::resize(std::size_t items) {
+    for (std::size_t i = items; i < m_Cell.size(); ++i)
+        unlink(static_cast<int>(i));
+    m_Next.resize(items, -1);
+    m_Prev.resize(items, -1);
+    m_Cell.resize(items, -1);
+}
+
+int UniformGrid::cellX(float x) const {
+    return std::clamp(static_cast<int>(std::floor(x / m_CellSize)), 0, m_Cols - 1);
+}
+
+int UniformGrid::cellY(float y) const {
+    return std::clamp(static_cast<int>(std::floor(y / m_CellSize)), 0, m_Rows - 1);
+}
+
+void UniformGrid::unlink(int item) {
+    int cell = m_Cell[item];
+    if (cell < 0)
+        return;
+    int prev = m_Prev[item], next = m_Next[item];
+    if (prev >= 0) m_Next[prev] = next;
+    else m_Head[cell] = next;
+    if (next >= 0) m_Prev[next] = prev;
+    m_Cell[item] = -1;
+}
+
+bool UniformGrid::update(std::size_t item, const Aabb& box) {
+    int cell = cellY(box.y + box.h / 2.f) * m_Cols + cellX(box.x + box.w / 2.f);
+    int i = static_cast<int>(item);
+    if (m_Cell[item] == cell)
+        return false;
+    unlink(i);
+    m_Cell[item] = cell;
+    m_Prev[item] = -1;
+    m_Next[item] = m_Head[cell];
+    if (m_Head[cell] >= 0)
+        m_Prev[m_Head[cell]] = i;
+    m_Head[cell] = i;
+    ++m_Relinks;
+    return true;
+}
+
+void UniformGrid::clearMarks() {
+    std::fill(m_Marks.begin(), m_Marks.end(), std::uint8_t{0});
+}
+
+void UniformGrid::mark(const Aabb& box, std::uint8_t bits) {
+    int x0 = cellX(box.x), x1 = cellX(box.x + box.w);
+    int y0 = cellY(box.y), y1 = cellY(box.y + box.h);
+    for (int y = y0; y <= y1; ++y)
+        for (int x = x0; x <= x1; ++x)
+            m_Marks[static_cast<std::size_t>(y * m_Cols + x)] |= bits;
+}
+
+std::uint8_t UniformGrid::marksNear(std::size_t item) const {
+    int cell = m_Cell[item];
+    if (cell < 0)
+        return 0;
+    int cx = cell % m_Cols, cy = cell / m_Cols;
+    std::uint8_t bits = 0;
+    for (int y = std::max(0, cy - 1); y <= std::min(m_Rows - 1, cy + 1); ++y)
+        for (int x = std::max(0, cx - 1); x <= std::min(m_Cols - 1, cx + 1); ++x)
+            bits |= m_Marks[static_cast<std::size_t>(y * m_Cols + x)];
+    return bits;
+}
+
+std::size_t UniformGrid::takeRelinks() {
+    std::size_t n = m_Relinks;
+    m_Relinks = 0;
+    return n;
+}
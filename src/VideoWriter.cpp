@@ -0,0 +1,174 @@
+/**
+ * @file VideoWriter.cpp
+ * @brief Implementation of the Y4M / PPM frame writer and its damage-only colour conversion.
+ * @author Oussama Amara
+ * @date 2025-09-02
+ */
+
+#include "VideoWriter.hpp"
+#include <algorithm>
+#include <cctype>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace {
+/** @brief Output buffer; a 1080p Y4M frame is about 3 MB. */
+constexpr std::size_t FileBuffer = 1 << 22;
+
+inline int red(std::uint32_t p) { return static_cast<int>((p >> 16) & 0xff); }
+inline int green(std::uint32_t p) { return static_cast<int>((p >> 8) & 0xff); }
+inline int blue(std::uint32_t p) { return static_cast<int>(p & 0xff); }
+
+/** @brief Full-range BT.601 luma in 8.8 fixed point. */
+inline std::uint8_t luma(std::uint32_t p) {
+    return static_cast<std::uint8_t>((77 * red(p) + 150 * green(p) + 29 * blue(p) + 128) >> 8);
+}
+} // namespace
+
+VideoWriter::Format VideoWriter::formatOf(const std::string& path) {
+    const std::size_t dot = path.rfind('.');
+    if (dot != std::string::npos) {
+        std::string ext = path.substr(dot + 1);
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (ext == "ppm")
+            return Format::Ppm;
+    }
+    return Format::Y4m;
+}
+
+bool VideoWriter::open(const std::string& path, Format format, int width, int height, int fps) {
+    close();
+    if (width <= 0 || height <= 0 || (format == Format::Y4m && (width % 2 || height % 2)))
+        return false;
+    if (path.empty()) {
+        m_File = nullptr; // benchmarks: convert but discard
+        m_OwnsFile = false;
+    } else if (path == "-") {
+#ifdef _WIN32
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+        m_File = stdout;
+        m_OwnsFile = false;
+    } else {
+        m_File = std::fopen(path.c_str(), "wb");
+        m_OwnsFile = true;
+        if (!m_File)
+            return false;
+    }
+    if (m_File)
+        std::setvbuf(m_File, nullptr, _IOFBF, FileBuffer);
+    m_Open = true;
+    m_Format = format;
+    m_Width = width;
+    m_Height = height;
+    m_First = true;
+    m_Frames = 0;
+    m_Bytes = 0;
+    const std::size_t pixels = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+    m_Picture.assign(format == Format::Y4m ? pixels + pixels / 2 : pixels * 3, 0);
+    if (format == Format::Y4m) {
+        char header[96];
+        int n = std::snprintf(header, sizeof header, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", width, height,
+                              std::max(1, fps));
+        return put(header, static_cast<std::size_t>(n));
+    }
+    return true;
+}
+
+void VideoWriter::close() {
+    m_Open = false;
+    if (!m_File)
+        return;
+    std::fflush(m_File);
+    if (m_OwnsFile)
+        std::fclose(m_File);
+    m_File = nullptr;
+}
+
+bool VideoWriter::put(const void* data, std::size_t size) {
+    if (m_File && std::fwrite(data, 1, size, m_File) != size)
+        return false;
+    m_Bytes += size;
+    return true;
+}
+
+/**
+ * @brief Converts one damaged region, widened to whole 2x2 chroma blocks.
+ * Chroma is the average of the block's four pixels.
+ */
+void VideoWriter::convertY4m(const SoftwareRenderer& frame, PixelRect r) {
+    r.x0 &= ~1;
+    r.y0 &= ~1;
+    r.x1 = std::min(m_Width, (r.x1 + 1) & ~1);
+    r.y1 = std::min(m_Height, (r.y1 + 1) & ~1);
+    const std::uint32_t* src = frame.pixels();
+    std::uint8_t* yPlane = m_Picture.data();
+    std::uint8_t* uPlane = yPlane + static_cast<std::size_t>(m_Width) * m_Height;
+    std::uint8_t* vPlane = uPlane + static_cast<std::size_t>(m_Width / 2) * (m_Height / 2);
+    for (int y = r.y0; y < r.y1; ++y) {
+        const std::uint32_t* row = src + static_cast<std::size_t>(y) * m_Width;
+        std::uint8_t* out = yPlane + static_cast<std::size_t>(y) * m_Width;
+        for (int x = r.x0; x < r.x1; ++x)
+            out[x] = luma(row[x]);
+    }
+    const int half = m_Width / 2;
+    for (int y = r.y0; y < r.y1; y += 2) {
+        const std::uint32_t* top = src + static_cast<std::size_t>(y) * m_Width;
+        const std::uint32_t* bottom = top + m_Width;
+        std::uint8_t* u = uPlane + static_cast<std::size_t>(y / 2) * half;
+        std::uint8_t* v = vPlane + static_cast<std::size_t>(y / 2) * half;
+        for (int x = r.x0; x < r.x1; x += 2) {
+            const int R = red(top[x]) + red(top[x + 1]) + red(bottom[x]) + red(bottom[x + 1]);
+            const int G = green(top[x]) + green(top[x + 1]) + green(bottom[x]) + green(bottom[x + 1]);
+            const int B = blue(top[x]) + blue(top[x + 1]) + blue(bottom[x]) + blue(bottom[x + 1]);
+            // Sums of four pixels: the extra >> 2 averages them
+            u[x / 2] = static_cast<std::uint8_t>(((-43 * R - 85 * G + 128 * B + 512) >> 10) + 128);
+            v[x / 2] = static_cast<std::uint8_t>(((128 * R - 107 * G - 21 * B + 512) >> 10) + 128);
+        }
+    }
+}
+
+void VideoWriter::convertPpm(const SoftwareRenderer& frame, const PixelRect& r) {
+    const std::uint32_t* src = frame.pixels();
+    for (int y = r.y0; y < r.y1; ++y) {
+        const std::uint32_t* row = src + static_cast<std::size_t>(y) * m_Width;
+        std::uint8_t* out = m_Picture.data() + (static_cast<std::size_t>(y) * m_Width + r.x0) * 3;
+        for (int x = r.x0; x < r.x1; ++x, out += 3) {
+            out[0] = static_cast<std::uint8_t>(red(row[x]));
+            out[1] = static_cast<std::uint8_t>(green(row[x]));
+            out[2] = static_cast<std::uint8_t>(blue(row[x]));
+        }
+    }
+}
+
+/**
+ * @brief Brings the converted picture up to date and writes it out whole.
+ */
+bool VideoWriter::write(const SoftwareRenderer& frame) {
+    if (!m_Open || frame.width() != m_Width || frame.height() != m_Height)
+        return false;
+    if (m_First) {
+        // The first frame converts everything, whatever the renderer reported
+        const PixelRect all{0, 0, m_Width, m_Height};
+        m_Format == Format::Y4m ? convertY4m(frame, all) : convertPpm(frame, all);
+        m_First = false;
+    } else {
+        for (const PixelRect& r : frame.damage())
+            m_Format == Format::Y4m ? convertY4m(frame, r) : convertPpm(frame, r);
+    }
+    bool ok;
+    if (m_Format == Format::Y4m) {
+        ok = put("FRAME\n", 6);
+    } else {
+        char header[48];
+        int n = std::snprintf(header, sizeof header, "P6\n%d %d\n255\n", m_Width, m_Height);
+        ok = put(header, static_cast<std::size_t>(n));
+    }
+    ok = ok && put(m_Picture.data(), m_Picture.size());
+    if (ok)
+        ++m_Frames;
+    return ok;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file WorkStealingPool.cpp
+ * @brief Implementation of the work-stealing parallel loop.
+ * @author Oussama Amara
+ * @date 2025-08-19
+ */
+
+#include "WorkStealingPool.hpp"
+
+/**
+ * @brief Workers 1..threads-1 wait for loops on their own threads.
+ */
+WorkStealingPool::WorkStealingPool(unsigned threads)
+    : m_Workers(threads ? threads : 1), m_Ranges(new Range[m_Workers])
+{
+    for (unsigned w = 1; w < m_Workers; ++w)
+        m_Threads.emplace_back(&WorkStealingPool::threadMain, this, w);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_Start.notify_all();
+    for (auto& t : m_Threads)
+        t.join();
+}
+
+/**
+ * @brief Hands out even slices, wakes the workers, works as worker 0 and waits for the rest.
+ */
+void WorkStealingPool::parallelFor(std::uint32_t count, const Body& body) {
+    if (count == 0)
+        return;
+
+    for (unsigned w = 0; w < m_Workers; ++w) {
+        auto begin = static_cast<std::uint32_t>(static_cast<std::uint64_t>(count) * w / m_Workers);
+        auto end = static_cast<std::uint32_t>(static_cast<std::uint64_t>(count) * (w + 1) / m_Workers);
+        m_Ranges[w].bounds.store(pack(begin, end), std::memory_order_relaxed);
+    }
+    m_Steals.store(0, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Body = &body;
+        m_Running = m_Workers - 1;
+        ++m_Generation;
+    }
+    m_Start.notify_all();
+
+    work(0);
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Finished.wait(lock, [this] { return m_Running == 0; });
+    m_Body = nullptr;
+}
+
+/**
+ * @brief Worker thread: run one loop per generation until the pool is destroyed.
+ */
+void WorkStealingPool::threadMain(unsigned worker) {
+    std::uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Start.wait(lock, [&] { return m_Stop || m_Generation != seen; });
+            if (m_Stop)
+                return;
+            seen = m_Generation;
+        }
+
+        work(worker);
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (--m_Running == 0)
+            m_Finished.notify_one();
+    }
+}
+
+/**
+ * @brief Drains the worker's own range, then steals until every range looks empty.
+ * A range that is refilled by a steal afterwards is still drained by its owner.
+ */
+void WorkStealingPool::work(unsigned worker) {
+    const Body& body = *m_Body;
+    std::uint32_t index;
+    for (;;) {
+        while (popFront(worker, index))
+            body(worker, index);
+        if (!steal(worker))
+            return;
+    }
+}
+
+/**
+ * @brief Takes the first index of the worker's own range.
+ */
+bool WorkStealingPool::popFront(unsigned worker, std::uint32_t& index) {
+    std::atomic<std::uint64_t>& bounds = m_Ranges[worker].bounds;
+    std::uint64_t cur = bounds.load(std::memory_order_acquire);
+    for (;;) {
+        auto begin = static_cast<std::uint32_t>(cur);
+        auto end = static_cast<std::uint32_t>(cur >> 32);
+        if (begin >= end)
+            return false;
+        if (bounds.compare_exchange_weak(cur, pack(begin + 1, end), std::memory_order_acq_rel)) {
+            index = begin;
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief Moves the back half of the first non-empty victim range into the thief's range.
+ * Victims are visited starting after the thief so thieves spread over different victims.
+ */
+bool WorkStealingPool::steal(unsigned thief) {
+    for (unsigned i = 1; i < m_Workers; ++i) {
+        std::atomic<std::uint64_t>& bounds = m_Ranges[(thief + i) % m_Workers].bounds;
+        std::uint64_t cur = bounds.load(std::memory_order_acquire);
+        for (;;) {
+            auto begin = static_cast<std::uint32_t>(cur);
+            auto end = static_cast<std::uint32_t>(cur >> 32);
+            if (begin >= end)
+                break;
+            std::uint32_t mid = begin + (end - begin) / 2;
+            if (bounds.compare_exchange_weak(cur, pack(begin, mid), std::memory_order_acq_rel)) {
+                // The thief's own range is empty, so nobody else can take from it until now.
+                m_Ranges[thief].bounds.store(pack(mid, end), std::memory_order_release);
+                m_Steals.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,251 @@
+/**
+ * @file pong-runner.cpp
+ * @brief Plays many headless matches across all cores and reports results and scaling.
+ * @author Oussama Amara
+ * @date 2025-08-19
+ */
+
+#include "CpuPlayer.hpp"
+#include "GameSimulation.hpp"
+#include "Logger.hpp"
+#include "WorkStealingPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+/** @brief Command-line options. */
+struct Options {
+    std::uint32_t matches = 2000;
+    GameMode mode = GameMode::Multiplayer;
+    std::uint32_t seed = 1;
+    unsigned threads = 0;
+    std::uint32_t maxTicks = 240 * 60 * 10;
+    int tickrate = 240;
+    CpuDifficulty difficulty;
+    bool scaling = false;
+};
+
+/** @brief Outcome of one match. */
+struct MatchResult {
+    int score[2] = {0, 0};
+    std::uint32_t ticks = 0;
+    std::uint32_t rallies = 0;      ///< Rallies played, each ending with a lost life
+    std::uint32_t batHits = 0;      ///< Bat hits over all rallies
+    std::uint32_t longestRally = 0; ///< Most bat hits in one rally
+    bool finished = false;          ///< Ended by game over rather than the tick limit
+};
+
+/** @brief Totals gathered by one worker; padded so workers never share a cache line. */
+struct alignas(64) WorkerTotals {
+    std::uint64_t matches = 0;
+    std::uint64_t ticks = 0;
+};
+
+/** @brief --scaling repeats the run with 1, 2, 4, ... threads and prints throughput per count. */
+void usage() {
+    std::fprintf(stderr,
+        "usage: pong-runner [--matches N] [--mode single|multi] [--seed S] [--threads N]\n"
+        "                   [--max-ticks N] [--tickrate HZ] [--level easy|normal|hard]\n"
+        "                   [--reaction S] [--aim-error PX] [--scaling]\n");
+}
+
+bool parse(int argc, char* argv[], Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--matches" && hasValue) {
+            opt.matches = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--mode" && hasValue) {
+            std::string mode = argv[++i];
+            if (mode == "single") opt.mode = GameMode::Singleplayer;
+            else if (mode == "multi") opt.mode = GameMode::Multiplayer;
+            else return false;
+        } else if (arg == "--seed" && hasValue) {
+            opt.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--threads" && hasValue) {
+            opt.threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (arg == "--max-ticks" && hasValue) {
+            opt.maxTicks = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--tickrate" && hasValue) {
+            opt.tickrate = std::atoi(argv[++i]);
+        } else if (arg == "--level" && hasValue) {
+            if (!CpuDifficulty::fromName(argv[++i], opt.difficulty))
+                return false;
+        } else if (arg == "--reaction" && hasValue) {
+            opt.difficulty.reactionTime = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--aim-error" && hasValue) {
+            opt.difficulty.aimError = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--scaling") {
+            opt.scaling = true;
+        } else {
+            return false;
+        }
+    }
+    return opt.matches > 0 && opt.tickrate > 0;
+}
+
+/**
+ * @brief Plays one match to game over or the tick limit, with the game's own rules and
+ * CpuPlayer bots whose aim error is drawn from the match seed, so results do not depend on
+ * the thread count.
+ */
+MatchResult playMatch(const Options& opt, std::uint32_t index) {
+    std::seed_seq seq{opt.seed, index};
+    std::uint32_t seeds[2];
+    seq.generate(seeds, seeds + 2);
+
+    const Vec2 field{1920.f, 1080.f};
+    GameSimulation sim(field);
+    sim.start(opt.mode);
+    CpuPlayer bots[2] = {CpuPlayer(0, opt.difficulty, seeds[0]), CpuPlayer(1, opt.difficulty, seeds[1])};
+    const float dt = 1.f / static_cast<float>(opt.tickrate);
+
+    MatchResult result;
+    std::uint32_t rally = 0;
+    while (result.ticks < opt.maxTicks) {
+        const MatchState& s = sim.state();
+        TickInput input;
+        input.players[0] = bots[0].input(s, field.x, dt);
+        if (opt.mode == GameMode::Multiplayer)
+            input.players[1] = bots[1].input(s, field.x, dt);
+
+        std::uint32_t events = sim.step(input, dt);
+        ++result.ticks;
+
+        if (events & SimEvent::BatHit)
+            ++rally;
+        if (events & SimEvent::Point1) result.score[0]++;
+        if (events & SimEvent::Point2) result.score[1]++;
+        if (events & (SimEvent::LifeLost1 | SimEvent::LifeLost2)) {
+            result.rallies++;
+            result.batHits += rally;
+            result.longestRally = std::max(result.longestRally, rally);
+            rally = 0;
+        }
+        if (events & SimEvent::GameOver) {
+            result.finished = true;
+            break;
+        }
+    }
+    return result;
+}
+
+/** @brief Result of one timed run. */
+struct RunStats {
+    double seconds = 0.0;
+    std::uint64_t ticks = 0;
+    std::uint64_t steals = 0;
+    std::uint64_t checksum = 0;
+};
+
+/**
+ * @brief Plays every match on @p threads workers. Each match writes only its own result
+ * slot and each worker only its own totals, so merging needs no lock.
+ */
+RunStats run(const Options& opt, unsigned threads, std::vector<MatchResult>& results) {
+    results.assign(opt.matches, MatchResult{});
+    WorkStealingPool pool(threads);
+    std::vector<WorkerTotals> totals(pool.size());
+
+    auto start = std::chrono::steady_clock::now();
+    pool.parallelFor(opt.matches, [&](unsigned worker, std::uint32_t index) {
+        results[index] = playMatch(opt, index);
+        totals[worker].matches++;
+        totals[worker].ticks += results[index].ticks;
+    });
+
+    RunStats stats;
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (const WorkerTotals& t : totals)
+        stats.ticks += t.ticks;
+    stats.steals = pool.steals();
+    for (const MatchResult& r : results)
+        stats.checksum = stats.checksum * 1000003u + static_cast<std::uint64_t>(r.score[0]) * 31u +
+                         static_cast<std::uint64_t>(r.score[1]) * 7u + r.ticks + r.batHits;
+    return stats;
+}
+
+void printResults(const Options& opt, const std::vector<MatchResult>& results, const RunStats& stats, unsigned threads) {
+    std::uint64_t finished = 0, rallies = 0, hits = 0, longest = 0, wins[2] = {0, 0};
+    double score[2] = {0, 0};
+    for (const MatchResult& r : results) {
+        finished += r.finished;
+        rallies += r.rallies;
+        hits += r.batHits;
+        longest = std::max<std::uint64_t>(longest, r.longestRally);
+        score[0] += r.score[0];
+        score[1] += r.score[1];
+        if (r.score[0] != r.score[1])
+            wins[r.score[0] > r.score[1] ? 0 : 1]++;
+    }
+    double n = static_cast<double>(results.size());
+    std::printf("mode            %s\n", opt.mode == GameMode::Multiplayer ? "multi" : "single");
+    std::printf("threads         %u\n", threads);
+    std::printf("matches         %zu (%llu reached game over)\n", results.size(), static_cast<unsigned long long>(finished));
+    std::printf("elapsed         %.3f s\n", stats.seconds);
+    std::printf("matches/s       %.1f\n", n / stats.seconds);
+    std::printf("ticks/s         %.3g\n", static_cast<double>(stats.ticks) / stats.seconds);
+    std::printf("mean ticks      %.0f\n", static_cast<double>(stats.ticks) / n);
+    std::printf("mean score      %.2f - %.2f\n", score[0] / n, score[1] / n);
+    if (opt.mode == GameMode::Multiplayer)
+        std::printf("wins            %llu - %llu\n", static_cast<unsigned long long>(wins[0]),
+                    static_cast<unsigned long long>(wins[1]));
+    std::printf("mean rally      %.2f hits (longest %llu)\n", rallies ? static_cast<double>(hits) / rallies : 0.0,
+                static_cast<unsigned long long>(longest));
+    std::printf("steals          %llu\n", static_cast<unsigned long long>(stats.steals));
+    std::printf("checksum        %016llx\n", static_cast<unsigned long long>(stats.checksum));
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parse(argc, argv, opt)) {
+        usage();
+        return 2;
+    }
+    unsigned maxThreads = opt.threads ? opt.threads : std::max(1u, std::thread::hardware_concurrency());
+
+    // Thousands of matches would otherwise fill game.log with every point scored
+    Logger::instance().setLevel(LogLevel::Error);
+
+    std::vector<MatchResult> results;
+    if (!opt.scaling) {
+        RunStats stats = run(opt, maxThreads, results);
+        printResults(opt, results, stats, maxThreads);
+        return 0;
+    }
+
+    std::vector<unsigned> counts;
+    for (unsigned t = 1; t < maxThreads; t *= 2)
+        counts.push_back(t);
+    counts.push_back(maxThreads);
+
+    std::printf("%7s %10s %12s %12s %8s %6s %8s  %s\n",
+                "threads", "seconds", "matches/s", "ticks/s", "speedup", "eff", "steals", "checksum");
+    double base = 0.0;
+    std::uint64_t firstChecksum = 0;
+    bool consistent = true;
+    for (unsigned threads : counts) {
+        RunStats stats = run(opt, threads, results);
+        double rate = opt.matches / stats.seconds;
+        if (threads == counts.front()) {
+            base = rate;
+            firstChecksum = stats.checksum;
+        }
+        consistent &= stats.checksum == firstChecksum;
+        std::printf("%7u %10.3f %12.1f %12.3g %7.2fx %5.0f%% %8llu  %016llx\n", threads, stats.seconds, rate,
+                    static_cast<double>(stats.ticks) / stats.seconds, rate / base,
+                    100.0 * rate / base / threads, static_cast<unsigned long long>(stats.steals),
+                    static_cast<unsigned long long>(stats.checksum));
+    }
+    if (!consistent) {
+        std::fprintf(stderr, "pong-runner: results differ between thread counts\n");
+        return 1;
+    }
+    return 0;
+}
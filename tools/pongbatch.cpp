@@ -0,0 +1,162 @@
+/**
+ * @file pongbatch.cpp
+ * @brief Runs a batch of bot-vs-bot matches with the vectorised engine and reports the outcome.
+ * @author Oussama Amara
+ * @date 2025-08-18
+ */
+
+#include "BatchSimulation.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+/** @brief Command-line options. */
+struct Options {
+    std::size_t matches = 10000;
+    int ticks = 240 * 600;
+    BatchParams params;
+    BatchSimulation::Backend backend = BatchSimulation::Backend::Auto;
+    std::uint32_t seed = 1;
+    bool verify = false;
+};
+
+/**
+ * @brief --verify runs the same batch through the scalar reference and every supported
+ * vector kernel and fails if any lane differs.
+ */
+void usage() {
+    std::fprintf(stderr,
+        "usage: pongbatch [--matches N] [--ticks N] [--mode single|multi]\n"
+        "                 [--backend auto|scalar|sse2|avx2] [--speed PX] [--bat-width PX]\n"
+        "                 [--serve-delay SEC] [--tickrate HZ] [--seed S] [--verify]\n");
+}
+
+bool parse(int argc, char* argv[], Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--matches" && hasValue) {
+            opt.matches = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--ticks" && hasValue) {
+            opt.ticks = std::atoi(argv[++i]);
+        } else if (arg == "--mode" && hasValue) {
+            std::string mode = argv[++i];
+            if (mode == "single") opt.params.mode = GameMode::Singleplayer;
+            else if (mode == "multi") opt.params.mode = GameMode::Multiplayer;
+            else return false;
+        } else if (arg == "--backend" && hasValue) {
+            std::string name = argv[++i];
+            if (name == "auto") opt.backend = BatchSimulation::Backend::Auto;
+            else if (name == "scalar") opt.backend = BatchSimulation::Backend::Scalar;
+            else if (name == "sse2") opt.backend = BatchSimulation::Backend::Sse2;
+            else if (name == "avx2") opt.backend = BatchSimulation::Backend::Avx2;
+            else return false;
+        } else if (arg == "--speed" && hasValue) {
+            opt.params.ballSpeed = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--bat-width" && hasValue) {
+            opt.params.batWidth = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--serve-delay" && hasValue) {
+            opt.params.serveDelay = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--tickrate" && hasValue) {
+            int rate = std::atoi(argv[++i]);
+            if (rate <= 0) return false;
+            opt.params.dt = 1.f / static_cast<float>(rate);
+        } else if (arg == "--seed" && hasValue) {
+            opt.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--verify") {
+            opt.verify = true;
+        } else {
+            return false;
+        }
+    }
+    return opt.matches > 0 && opt.ticks > 0;
+}
+
+/** @brief Index of the first lane where the two batches differ, or -1. */
+long long firstMismatch(const BatchSimulation& a, const BatchSimulation& b) {
+    const BatchLanes& x = a.lanes();
+    const BatchLanes& y = b.lanes();
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        bool same = x.ballX[i] == y.ballX[i] && x.ballY[i] == y.ballY[i] &&
+                    x.dirX[i] == y.dirX[i] && x.dirY[i] == y.dirY[i] &&
+                    x.bat1X[i] == y.bat1X[i] && x.bat2X[i] == y.bat2X[i] && x.time[i] == y.time[i] &&
+                    x.score1[i] == y.score1[i] && x.score2[i] == y.score2[i] &&
+                    x.lives1[i] == y.lives1[i] && x.lives2[i] == y.lives2[i] &&
+                    x.batHits[i] == y.batHits[i] && x.ticks[i] == y.ticks[i] && x.done[i] == y.done[i];
+        if (!same)
+            return static_cast<long long>(i);
+    }
+    return -1;
+}
+
+/** @brief Steps in chunks so matches that end early let whole blocks drop out. */
+double run(BatchSimulation& batch, int ticks, BatchSimulation::Backend backend) {
+    const int chunk = 240;
+    auto start = std::chrono::steady_clock::now();
+    for (int done = 0; done < ticks && batch.finishedCount() < batch.size(); done += chunk)
+        batch.step(ticks - done < chunk ? ticks - done : chunk, backend);
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int verify(const Options& opt) {
+    BatchSimulation reference(opt.matches, opt.params, opt.seed);
+    double refSec = run(reference, opt.ticks, BatchSimulation::Backend::Scalar);
+    std::printf("%-8s %9.3f s\n", "scalar", refSec);
+
+    int failures = 0;
+    for (auto backend : {BatchSimulation::Backend::Sse2, BatchSimulation::Backend::Avx2}) {
+        if (!BatchSimulation::supported(backend)) {
+            std::printf("%-8s skipped (not supported here)\n", BatchSimulation::backendName(backend));
+            continue;
+        }
+        BatchSimulation batch(opt.matches, opt.params, opt.seed);
+        double sec = run(batch, opt.ticks, backend);
+        long long lane = firstMismatch(reference, batch);
+        std::printf("%-8s %9.3f s  %5.1fx  %s\n", BatchSimulation::backendName(backend), sec,
+                    sec > 0 ? refSec / sec : 0.0, lane < 0 ? "matches scalar" : "MISMATCH");
+        if (lane >= 0) {
+            std::printf("  first differing match: %lld\n", lane);
+            ++failures;
+        }
+    }
+    return failures ? 1 : 0;
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parse(argc, argv, opt)) {
+        usage();
+        return 2;
+    }
+    if (opt.verify)
+        return verify(opt);
+
+    BatchSimulation::Backend backend = opt.backend;
+    if (backend == BatchSimulation::Backend::Auto || !BatchSimulation::supported(backend))
+        backend = BatchSimulation::bestBackend();
+
+    BatchSimulation batch(opt.matches, opt.params, opt.seed);
+    double sec = run(batch, opt.ticks, backend);
+
+    const BatchLanes& L = batch.lanes();
+    double ticks = 0, score1 = 0, score2 = 0, hits = 0;
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        ticks += L.ticks[i];
+        score1 += L.score1[i];
+        score2 += L.score2[i];
+        hits += L.batHits[i];
+    }
+    double n = static_cast<double>(batch.size());
+    std::printf("backend        %s\n", BatchSimulation::backendName(backend));
+    std::printf("matches        %zu (%zu finished)\n", batch.size(), batch.finishedCount());
+    std::printf("elapsed        %.3f s\n", sec);
+    std::printf("match-ticks/s  %.3g\n", sec > 0 ? ticks / sec : 0.0);
+    std::printf("mean length    %.1f s\n", ticks / n * opt.params.dt);
+    std::printf("mean score     %.2f - %.2f\n", score1 / n, score2 / n);
+    std::printf("mean bat hits  %.2f\n", hits / n);
+    return 0;
+}
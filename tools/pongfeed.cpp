@@ -0,0 +1,267 @@
+/**
+ * @file pongfeed.cpp
+ * @brief Sample spectator-feed reader and a many-reader throughput test of the feed.
+ * @author Oussama Amara
+ * @date 2025-09-01
+ */
+
+#include "FrameProfiler.hpp"
+#include "Logger.hpp"
+#include "SpectatorFeed.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+/** @brief Command-line options. */
+struct Options {
+    std::string name = "pong-feed";
+    bool follow = false;
+    bool bench = false;
+    double seconds = 0.0; ///< 0 runs until interrupted (reader) or 4 s (bench)
+    std::size_t readers = 8;
+    double rate = 0.0;    ///< Bench publish rate, 0 for as fast as possible
+    std::uint32_t slots = SpectatorFeed::DefaultSlots;
+};
+
+/**
+ * @brief Without --bench it attaches to a game started with --feed and prints a scoreboard
+ * line ten times a second; --follow consumes every frame and prints arrivals and losses
+ * instead. --bench publishes synthetic frames alone and then with N reader threads, each
+ * mapping the feed as a process would, and compares the cost of a publish.
+ */
+void usage() {
+    std::fprintf(stderr, "usage: pongfeed [name] [--follow] [--seconds S]\n"
+                         "       pongfeed --bench [--readers N] [--seconds S] [--rate HZ] [--slots N]\n");
+}
+
+bool parse(int argc, char* argv[], Options& opt) {
+    bool nameSet = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--follow") {
+            opt.follow = true;
+        } else if (arg == "--bench") {
+            opt.bench = true;
+        } else if (arg == "--seconds" && hasValue) {
+            opt.seconds = std::atof(argv[++i]);
+        } else if (arg == "--readers" && hasValue) {
+            opt.readers = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--rate" && hasValue) {
+            opt.rate = std::atof(argv[++i]);
+        } else if (arg == "--slots" && hasValue) {
+            opt.slots = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (!arg.empty() && arg[0] != '-' && !nameSet) {
+            opt.name = arg;
+            nameSet = true;
+        } else {
+            return false;
+        }
+    }
+    return opt.slots > 0;
+}
+
+double secondsSince(std::uint64_t startNs) {
+    return static_cast<double>(SpectatorFeed::now() - startNs) / 1e9;
+}
+
+/** @brief Attaches to a game's feed and prints it until the time is up. */
+int watch(const Options& opt) {
+    SpectatorReader reader;
+    std::uint64_t start = SpectatorFeed::now();
+    while (!reader.open(opt.name)) {
+        if (opt.seconds > 0.0 && secondsSince(start) > opt.seconds) {
+            std::fprintf(stderr, "pongfeed: no feed named %s (start the game with --feed %s)\n",
+                         opt.name.c_str(), opt.name.c_str());
+            return 1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+    std::printf("attached to %s: %.0fx%.0f field, %u slots\n", opt.name.c_str(), reader.field().x, reader.field().y,
+                reader.slots());
+
+    static const char* const modes[] = {"menu", "single", "multi"};
+    SpectatorFrame frame;
+    std::uint64_t frames = 0, lostBefore = 0;
+    std::uint64_t second = SpectatorFeed::now();
+    start = second;
+    while (opt.seconds <= 0.0 || secondsSince(start) < opt.seconds) {
+        if (opt.follow) {
+            // Every frame, reported once per second
+            while (reader.next(frame))
+                ++frames;
+            if (secondsSince(second) >= 1.0) {
+                std::printf("%llu frames/s, %llu lost, head %llu\n", static_cast<unsigned long long>(frames),
+                            static_cast<unsigned long long>(reader.lost() - lostBefore),
+                            static_cast<unsigned long long>(reader.head()));
+                frames = 0;
+                lostBefore = reader.lost();
+                second = SpectatorFeed::now();
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        } else {
+            // A scoreboard only needs the newest frame a few times a second
+            if (reader.latest(frame)) {
+                const char* mode = frame.mode < 3 ? modes[frame.mode] : "?";
+                std::printf("tick %8u  %-6s  score %3d - %-3d  lives %d - %d  high %3d  ball (%6.1f, %6.1f)  age %llu us\n",
+                            frame.tick, mode, frame.score[0], frame.score[1], frame.lives[0], frame.lives[1],
+                            frame.highScore, frame.ball.x, frame.ball.y,
+                            static_cast<unsigned long long>((SpectatorFeed::now() - frame.publishedNs) / 1000));
+                std::fflush(stdout);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+    return 0;
+}
+
+/** @brief Frame whose every field is derived from its sequence, so a torn read shows. */
+SpectatorFrame syntheticFrame(std::uint64_t sequence) {
+    SpectatorFrame frame;
+    frame.tick = static_cast<std::uint32_t>(sequence);
+    frame.mode = static_cast<std::uint8_t>(sequence % 3);
+    frame.ball.x = static_cast<float>(sequence & 0xffff);
+    frame.ball.y = static_cast<float>((sequence >> 4) & 0xffff);
+    frame.bats[1].x = static_cast<float>(sequence & 0xfff);
+    frame.score[0] = static_cast<std::int32_t>(sequence * 3);
+    frame.lives[1] = static_cast<std::int32_t>(~sequence);
+    frame.highScore = static_cast<std::int32_t>(sequence ^ 0x5a5a5a5a);
+    frame.timeElapsed = static_cast<float>(sequence & 0xff);
+    return frame;
+}
+
+bool intact(const SpectatorFrame& f) {
+    const SpectatorFrame expected = syntheticFrame(f.sequence);
+    return f.tick == expected.tick && f.mode == expected.mode && f.ball.x == expected.ball.x &&
+           f.ball.y == expected.ball.y && f.bats[1].x == expected.bats[1].x && f.score[0] == expected.score[0] &&
+           f.lives[1] == expected.lives[1] && f.highScore == expected.highScore &&
+           f.timeElapsed == expected.timeElapsed;
+}
+
+/** @brief What one bench reader saw. */
+struct ReaderResult {
+    std::uint64_t frames = 0;
+    std::uint64_t lost = 0;
+    std::uint64_t collisions = 0;
+    std::uint64_t torn = 0;
+    PhaseHistogram age; ///< Publish to read, in ns
+};
+
+/** @brief Publishes for @p seconds and times every publish. */
+std::uint64_t publishFor(SpectatorFeed& feed, double seconds, double rate, PhaseHistogram& cost) {
+    const std::uint64_t start = SpectatorFeed::now();
+    const std::uint64_t end = start + static_cast<std::uint64_t>(seconds * 1e9);
+    const std::uint64_t periodNs = rate > 0.0 ? static_cast<std::uint64_t>(1e9 / rate) : 0;
+    std::uint64_t count = 0, nextNs = start;
+    for (std::uint64_t now = start; now < end; now = SpectatorFeed::now()) {
+        if (periodNs) {
+            if (now < nextNs) {
+                std::this_thread::yield();
+                continue;
+            }
+            nextNs += periodNs;
+        }
+        const SpectatorFrame frame = syntheticFrame(feed.published() + 1);
+        const std::uint64_t before = SpectatorFeed::now();
+        feed.publish(frame);
+        cost.record(SpectatorFeed::now() - before);
+        ++count;
+    }
+    return count;
+}
+
+void printCost(const char* label, std::uint64_t published, double seconds, const PhaseHistogram& cost) {
+    std::printf("%-16s %10.0f frames/s  publish mean %5.0f ns  p99 %5llu ns  max %7llu ns\n", label,
+                static_cast<double>(published) / seconds, cost.meanNs(),
+                static_cast<unsigned long long>(cost.quantileNs(0.99)),
+                static_cast<unsigned long long>(cost.maxNs()));
+}
+
+int bench(const Options& opt) {
+    const std::string name = opt.name == "pong-feed" ? "pongfeed-bench" : opt.name;
+    const double seconds = opt.seconds > 0.0 ? opt.seconds : 4.0;
+    SpectatorFeed feed;
+    if (!feed.open(name, Vec2{1920.f, 1080.f}, opt.slots)) {
+        std::fprintf(stderr, "pongfeed: cannot create shared memory %s\n", name.c_str());
+        return 1;
+    }
+    std::printf("bench: %zu readers, %u slots, %s, %.1f s per phase\n", opt.readers, opt.slots,
+                opt.rate > 0.0 ? (std::to_string(static_cast<int>(opt.rate)) + " Hz").c_str() : "flat out", seconds);
+
+    PhaseHistogram alone;
+    std::uint64_t aloneCount = publishFor(feed, seconds, opt.rate, alone);
+
+    std::atomic<bool> running{true};
+    std::atomic<std::size_t> attached{0};
+    std::vector<ReaderResult> results(opt.readers);
+    std::vector<std::thread> threads;
+    for (std::size_t r = 0; r < opt.readers; ++r) {
+        threads.emplace_back([&, r] {
+            ReaderResult& result = results[r];
+            SpectatorReader reader;
+            if (!reader.open(name)) {
+                ++attached;
+                return;
+            }
+            ++attached;
+            SpectatorFrame frame;
+            while (running.load(std::memory_order_relaxed)) {
+                if (!reader.next(frame)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                ++result.frames;
+                if (!intact(frame))
+                    ++result.torn;
+                result.age.record(SpectatorFeed::now() - frame.publishedNs);
+            }
+            result.lost = reader.lost();
+            result.collisions = reader.collisions();
+        });
+    }
+    while (attached.load() < opt.readers)
+        std::this_thread::yield();
+
+    PhaseHistogram shared;
+    std::uint64_t sharedCount = publishFor(feed, seconds, opt.rate, shared);
+    running = false;
+    for (std::thread& t : threads)
+        t.join();
+
+    printCost("writer alone", aloneCount, seconds, alone);
+    printCost("with readers", sharedCount, seconds, shared);
+    std::uint64_t frames = 0, lost = 0, torn = 0, collisions = 0;
+    for (std::size_t r = 0; r < results.size(); ++r) {
+        const ReaderResult& result = results[r];
+        std::printf("  reader %2zu: %10llu frames  %10llu lost  %6llu collisions  %llu torn  age p50 %llu us p99 %llu us\n",
+                    r, static_cast<unsigned long long>(result.frames), static_cast<unsigned long long>(result.lost),
+                    static_cast<unsigned long long>(result.collisions), static_cast<unsigned long long>(result.torn),
+                    static_cast<unsigned long long>(result.age.quantileNs(0.5) / 1000),
+                    static_cast<unsigned long long>(result.age.quantileNs(0.99) / 1000));
+        frames += result.frames;
+        lost += result.lost;
+        torn += result.torn;
+        collisions += result.collisions;
+    }
+    std::printf("readers total: %.0f frames/s read, %llu lost, %llu collisions, %llu torn\n",
+                static_cast<double>(frames) / seconds, static_cast<unsigned long long>(lost),
+                static_cast<unsigned long long>(collisions), static_cast<unsigned long long>(torn));
+    return torn == 0 ? 0 : 1;
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parse(argc, argv, opt)) {
+        usage();
+        return 2;
+    }
+    Logger::instance().setConsoleEcho(false);
+    Logger::instance().setLevel(LogLevel::Error);
+    return opt.bench ? bench(opt) : watch(opt);
+}
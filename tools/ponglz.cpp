@@ -0,0 +1,50 @@
+/**
+ * @file ponglz.cpp
+ * @brief Command-line front end for the in-tree LZ codec, mainly to read rotated logs.
+ * @author Oussama Amara
+ * @date 2025-08-12
+ */
+
+#include "Lz.hpp"
+#include <cstdio>
+#include <string>
+
+namespace {
+/** @brief Without an output name, -d strips ".lz" and compressing appends it. */
+void usage() {
+    std::fprintf(stderr, "usage: ponglz [-d] <input> [output]\n");
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int arg = 1;
+    if (arg < argc && (std::string(argv[arg]) == "-h" || std::string(argv[arg]) == "--help")) {
+        usage();
+        return 0;
+    }
+    bool decompress = arg < argc && std::string(argv[arg]) == "-d";
+    if (decompress)
+        ++arg;
+    if (arg >= argc || argv[arg][0] == '-') {
+        usage();
+        return 2;
+    }
+
+    std::string input = argv[arg];
+    std::string output;
+    if (arg + 1 < argc) {
+        output = argv[arg + 1];
+    } else if (decompress) {
+        bool hasSuffix = input.size() > 3 && input.compare(input.size() - 3, 3, ".lz") == 0;
+        output = hasSuffix ? input.substr(0, input.size() - 3) : input + ".out";
+    } else {
+        output = input + ".lz";
+    }
+
+    bool ok = decompress ? lz::decompressFile(input, output) : lz::compressFile(input, output);
+    if (!ok) {
+        std::fprintf(stderr, "ponglz: failed to %s %s\n", decompress ? "decompress" : "compress", input.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,270 @@
+/**
+ * @file pongnet.cpp
+ * @brief Loopback harness for the rollback netcode: two peers in one process over an impaired link.
+ * @author Oussama Amara
+ * @date 2025-08-26
+ */
+
+#include "Logger.hpp"
+#include "Replay.hpp"
+#include "Rollback.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+/** @brief Command-line options. */
+struct Options {
+    std::uint32_t ticks = 240 * 60;
+    double latencyMs = 40.0;
+    double jitterMs = 10.0;
+    double lossPercent = 5.0;
+    std::uint32_t seed = 1;
+    bool udp = false;
+};
+
+/**
+ * @brief Bots drive both peers. Datagrams are dropped with the --loss probability and
+ * delivered after latency +/- jitter, so they also arrive out of order; --udp also sends
+ * them through sockets on 127.0.0.1. The report gives the rollback depth and cost and
+ * checks that both peers agree on every tick both have confirmed.
+ */
+void usage() {
+    std::fprintf(stderr,
+        "usage: pongnet [--ticks N] [--latency MS] [--jitter MS] [--loss PCT] [--seed S] [--udp]\n");
+}
+
+bool parse(int argc, char* argv[], Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--ticks" && hasValue) {
+            opt.ticks = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--latency" && hasValue) {
+            opt.latencyMs = std::atof(argv[++i]);
+        } else if (arg == "--jitter" && hasValue) {
+            opt.jitterMs = std::atof(argv[++i]);
+        } else if (arg == "--loss" && hasValue) {
+            opt.lossPercent = std::atof(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            opt.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--udp") {
+            opt.udp = true;
+        } else {
+            return false;
+        }
+    }
+    return opt.ticks > 0 && opt.latencyMs >= 0.0 && opt.jitterMs >= 0.0 && opt.lossPercent >= 0.0 &&
+           opt.lossPercent <= 100.0;
+}
+
+/** @brief In-process datagram queue; send() lands in the other end's inbox. */
+class MemoryTransport : public NetTransport {
+public:
+    void connect(MemoryTransport& other) { m_Other = &other; }
+
+    void send(const std::uint8_t* data, std::size_t size) override {
+        m_Other->m_Inbox.emplace_back(data, data + size);
+    }
+
+    bool receive(std::vector<std::uint8_t>& packet) override {
+        if (m_Inbox.empty())
+            return false;
+        packet = std::move(m_Inbox.front());
+        m_Inbox.pop_front();
+        return true;
+    }
+
+private:
+    MemoryTransport* m_Other = nullptr;
+    std::deque<std::vector<std::uint8_t>> m_Inbox;
+};
+
+/** @brief Drops, delays and reorders outgoing datagrams before handing them to another transport. */
+class ImpairedLink : public NetTransport {
+public:
+    ImpairedLink(NetTransport& inner, const Options& opt, std::uint32_t seed)
+        : m_Inner(inner), m_Opt(opt), m_Rng(seed) {}
+
+    void send(const std::uint8_t* data, std::size_t size) override {
+        if (std::uniform_real_distribution<double>(0.0, 100.0)(m_Rng) < m_Opt.lossPercent) {
+            ++m_Dropped;
+            return;
+        }
+        double jitter = std::uniform_real_distribution<double>(-m_Opt.jitterMs, m_Opt.jitterMs)(m_Rng);
+        double delay = std::max(0.0, m_Opt.latencyMs + jitter) / 1000.0;
+        m_Queue.push_back({m_Now + delay, std::vector<std::uint8_t>(data, data + size)});
+        m_Bytes += size;
+    }
+
+    bool receive(std::vector<std::uint8_t>& packet) override { return m_Inner.receive(packet); }
+
+    /** @brief Moves the clock and forwards every datagram that is due. */
+    void pump(double now) {
+        m_Now = now;
+        for (auto it = m_Queue.begin(); it != m_Queue.end();) {
+            if (it->first <= now) {
+                m_Inner.send(it->second.data(), it->second.size());
+                it = m_Queue.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    std::uint64_t dropped() const { return m_Dropped; }
+    std::uint64_t bytes() const { return m_Bytes; }
+
+private:
+    NetTransport& m_Inner;
+    const Options& m_Opt;
+    std::mt19937 m_Rng;
+    double m_Now = 0.0;
+    std::vector<std::pair<double, std::vector<std::uint8_t>>> m_Queue;
+    std::uint64_t m_Dropped = 0;
+    std::uint64_t m_Bytes = 0;
+};
+
+/** @brief Holds keys for a random stretch, then picks new ones, like a nervous player. */
+struct Bot {
+    std::mt19937 rng;
+    PlayerInput keys;
+    std::uint32_t hold = 0;
+
+    PlayerInput next() {
+        if (hold-- == 0) {
+            std::uint32_t choice = rng() % 3;
+            keys = PlayerInput{choice == 1, choice == 2};
+            hold = 24 + rng() % 120;
+        }
+        return keys;
+    }
+};
+
+/** @brief One peer: its simulation, session and the hashes of its final states. */
+struct Peer {
+    GameSimulation sim;
+    RollbackSession session;
+    Bot bot;
+    std::vector<std::uint64_t> hashes; ///< FNV-1a of the packed state before each final tick
+    std::vector<double> depths;
+    std::vector<double> resimUs;
+
+    Peer(Vec2 field, int player, NetTransport& link, float dt, std::uint32_t seed)
+        : sim(field), session(sim, player, link, dt), bot{std::mt19937(seed), {}, 0} {}
+
+    /** @brief Hashes the states that became final since the last call. */
+    void collect() {
+        while (hashes.size() <= session.confirmedFrame() && hashes.size() < session.frame()) {
+            const MatchState* state = session.savedState(static_cast<std::uint32_t>(hashes.size()));
+            if (!state)
+                break;
+            Replay::PackedState packed;
+            Replay::packState(*state, packed);
+            std::uint64_t hash = 14695981039346656037ull;
+            for (std::uint8_t b : packed)
+                hash = (hash ^ b) * 1099511628211ull;
+            hashes.push_back(hash);
+        }
+    }
+};
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty())
+        return 0.0;
+    std::sort(values.begin(), values.end());
+    return values[static_cast<std::size_t>(p * static_cast<double>(values.size() - 1))];
+}
+
+double mean(const std::vector<double>& values) {
+    double sum = 0.0;
+    for (double v : values)
+        sum += v;
+    return values.empty() ? 0.0 : sum / static_cast<double>(values.size());
+}
+
+void report(const char* name, const Peer& peer, const ImpairedLink& link, double seconds) {
+    const RollbackStats& s = peer.session.stats();
+    std::printf("%s: %llu ticks, %llu stalls, %llu rollbacks (%llu ticks re-simulated)\n", name,
+                static_cast<unsigned long long>(s.ticks), static_cast<unsigned long long>(s.stalls),
+                static_cast<unsigned long long>(s.rollbacks), static_cast<unsigned long long>(s.resimulatedTicks));
+    std::printf("  rollback depth per frame: mean %.2f  p99 %.0f  max %u ticks (mean %.1f per rollback)\n",
+                mean(peer.depths), percentile(peer.depths, 0.99), s.maxDepth,
+                s.rollbacks ? static_cast<double>(s.resimulatedTicks) / static_cast<double>(s.rollbacks) : 0.0);
+    std::printf("  re-simulation per frame:  mean %.2f  p99 %.2f  max %.2f us\n", mean(peer.resimUs),
+                percentile(peer.resimUs, 0.99), percentile(peer.resimUs, 1.0));
+    std::printf("  packets: %llu sent, %llu dropped by the link, %llu received, %llu rejected, %.1f KiB/s up\n",
+                static_cast<unsigned long long>(s.packetsSent), static_cast<unsigned long long>(link.dropped()),
+                static_cast<unsigned long long>(s.packetsReceived), static_cast<unsigned long long>(s.packetsRejected),
+                static_cast<double>(link.bytes()) / 1024.0 / seconds);
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parse(argc, argv, opt)) {
+        usage();
+        return 2;
+    }
+    Logger::instance().setConsoleEcho(false);
+    Logger::instance().setLevel(LogLevel::Error);
+
+    const Vec2 field{RollbackSession::FieldWidth, RollbackSession::FieldHeight};
+    const float dt = 1.f / 240.f;
+
+    MemoryTransport memoryA, memoryB;
+    UdpTransport udpA, udpB;
+    NetTransport* innerA = &memoryA;
+    NetTransport* innerB = &memoryB;
+    if (opt.udp) {
+        NetAddress host;
+        if (!udpA.open(0) || !NetAddress::resolve("127.0.0.1", udpA.localPort(), host) || !udpB.open(0, &host)) {
+            std::fprintf(stderr, "pongnet: cannot open loopback sockets\n");
+            return 1;
+        }
+        innerA = &udpA;
+        innerB = &udpB;
+    } else {
+        memoryA.connect(memoryB);
+        memoryB.connect(memoryA);
+    }
+    ImpairedLink linkA(*innerA, opt, opt.seed * 2 + 1), linkB(*innerB, opt, opt.seed * 2 + 2);
+    Peer a(field, 0, linkA, dt, opt.seed * 7 + 1), b(field, 1, linkB, dt, opt.seed * 7 + 2);
+
+    std::printf("pongnet: %u ticks, latency %.0f ms +/- %.0f ms, loss %.1f%%, %s\n", opt.ticks, opt.latencyMs,
+                opt.jitterMs, opt.lossPercent, opt.udp ? "UDP on 127.0.0.1" : "in-process link");
+
+    // Both peers tick on the same simulated clock; a stalled peer loses its tick. A peer
+    // that is done keeps playing so its packets still repair the other side's losses.
+    std::uint64_t step = 0;
+    const std::uint64_t maxSteps = static_cast<std::uint64_t>(opt.ticks) * 4;
+    while (std::min(a.session.frame(), b.session.frame()) < opt.ticks && step < maxSteps) {
+        double now = static_cast<double>(step++) * dt;
+        linkA.pump(now);
+        linkB.pump(now);
+        for (Peer* peer : {&a, &b}) {
+            if (peer->session.advance(peer->bot.next()) == RollbackSession::Status::Waiting)
+                continue;
+            peer->depths.push_back(peer->session.stats().lastDepth);
+            peer->resimUs.push_back(static_cast<double>(peer->session.stats().lastResimNs) / 1000.0);
+            peer->collect();
+        }
+    }
+    double seconds = static_cast<double>(step) * dt;
+    report("peer 1 (host)", a, linkA, seconds);
+    report("peer 2", b, linkB, seconds);
+
+    std::size_t common = std::min(a.hashes.size(), b.hashes.size());
+    for (std::size_t f = 0; f < common; ++f) {
+        if (a.hashes[f] != b.hashes[f]) {
+            std::printf("DESYNC: the peers disagree on the state before tick %zu\n", f);
+            return 1;
+        }
+    }
+    std::printf("in sync: %zu confirmed ticks are bit-identical on both peers\n", common);
+    return 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file pongpack.cpp
+ * @brief Packs the game's assets into one indexed bundle, and lists or checks bundles.
+ * @author Oussama Amara
+ * @date 2025-09-04
+ */
+
+#include "AssetBundle.hpp"
+#include "MappedFile.hpp"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+/**
+ * @brief Each file is packed under the path given. `make` runs
+ * `pongpack -o bin/assets.pak fonts/DS-DIGI.TTF`, and the game looks assets up by the same paths.
+ */
+void usage() {
+    std::fprintf(stderr, "usage: pongpack -o <bundle> <file>...\n"
+                         "       pongpack --list <bundle>\n"
+                         "       pongpack --verify <bundle>\n");
+}
+
+int pack(const std::string& output, const std::vector<std::string>& inputs) {
+    std::vector<AssetBundle::Source> assets;
+    std::size_t total = 0;
+    for (const std::string& path : inputs) {
+        MappedFile file;
+        if (!file.open(path, MappedFile::Mode::ReadOnly)) {
+            std::fprintf(stderr, "pongpack: cannot read %s\n", path.c_str());
+            return 1;
+        }
+        if (path.size() > AssetBundle::MaxName) {
+            std::fprintf(stderr, "pongpack: name longer than %zu characters: %s\n", AssetBundle::MaxName, path.c_str());
+            return 1;
+        }
+        assets.push_back({path, std::vector<std::uint8_t>(file.data(), file.data() + file.size())});
+        total += file.size();
+    }
+    if (!AssetBundle::write(output, std::move(assets))) {
+        std::fprintf(stderr, "pongpack: cannot write %s (duplicate names?)\n", output.c_str());
+        return 1;
+    }
+    std::printf("%s: %zu assets, %zu bytes\n", output.c_str(), inputs.size(), total);
+    return 0;
+}
+
+int inspect(const std::string& path, bool verify) {
+    AssetBundle bundle;
+    if (!bundle.open(path)) {
+        std::fprintf(stderr, "pongpack: %s is not a valid asset bundle\n", path.c_str());
+        return 1;
+    }
+    if (verify) {
+        const std::size_t bad = bundle.verify();
+        if (bad < bundle.count()) {
+            std::fprintf(stderr, "pongpack: %.*s is damaged\n", static_cast<int>(bundle.name(bad).size()),
+                         bundle.name(bad).data());
+            return 1;
+        }
+        std::printf("%s: %zu assets intact\n", path.c_str(), bundle.count());
+        return 0;
+    }
+    for (std::size_t i = 0; i < bundle.count(); ++i) {
+        const std::string_view name = bundle.name(i);
+        std::printf("%10zu  %.*s\n", bundle.at(i).size, static_cast<int>(name.size()), name.data());
+    }
+    return 0;
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string output;
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if ((arg == "--list" || arg == "--verify") && i + 1 < argc && argc == 3)
+            return inspect(argv[i + 1], arg == "--verify");
+        if (arg == "-o" && i + 1 < argc)
+            output = argv[++i];
+        else if (!arg.empty() && arg[0] != '-')
+            inputs.push_back(arg);
+        else {
+            usage();
+            return 2;
+        }
+    }
+    if (output.empty() || inputs.empty()) {
+        usage();
+        return 2;
+    }
+    return pack(output, inputs);
+}
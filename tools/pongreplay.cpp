@@ -0,0 +1,107 @@
+/**
+ * @file pongreplay.cpp
+ * @brief Inspects and checks replay files written by the game with --record.
+ * @author Oussama Amara
+ * @date 2025-08-25
+ */
+
+#include "Logger.hpp"
+#include "Replay.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace {
+/** @brief Command-line options. */
+struct Options {
+    std::string path;
+    bool verify = false;
+    long long seek = -1;
+};
+
+/**
+ * @brief The header and record counts are always printed. --verify fails at the first
+ * snapshot that is not reproduced bit for bit; --seek prints the state before the tick.
+ */
+void usage() {
+    std::fprintf(stderr, "usage: pongreplay <file.prpl> [--verify] [--seek TICK]\n");
+}
+
+bool parse(int argc, char* argv[], Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--verify") {
+            opt.verify = true;
+        } else if (arg == "--seek" && i + 1 < argc) {
+            opt.seek = std::atoll(argv[++i]);
+            if (opt.seek < 0) return false;
+        } else if (!arg.empty() && arg[0] != '-' && opt.path.empty()) {
+            opt.path = arg;
+        } else {
+            return false;
+        }
+    }
+    return !opt.path.empty();
+}
+
+void printState(const char* label, const MatchState& s) {
+    static const char* const modes[] = {"menu", "single", "multi"};
+    std::printf("%-9s tick %u  mode %s  time %.4f s  score %d-%d  lives %d-%d  high %d\n", label, s.tick,
+                modes[static_cast<int>(s.mode)], s.timeElapsed, s.score[0], s.score[1], s.lives[0], s.lives[1],
+                s.highScore);
+    Aabb ball = s.ball.getPosition();
+    Aabb bat0 = s.bats[0].getPosition(), bat1 = s.bats[1].getPosition();
+    std::printf("          ball (%.3f, %.3f)  bats (%.3f, %.3f) (%.3f, %.3f)\n", ball.x, ball.y, bat0.x, bat0.y,
+                bat1.x, bat1.y);
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parse(argc, argv, opt)) {
+        usage();
+        return 2;
+    }
+    Logger::instance().setConsoleEcho(false);
+    Logger::instance().setLevel(LogLevel::Error);
+
+    Replay::Player player;
+    if (!player.open(opt.path)) {
+        std::fprintf(stderr, "pongreplay: cannot read replay %s\n", opt.path.c_str());
+        return 1;
+    }
+    std::printf("%s: %zu bytes, field %.0fx%.0f, %.1f Hz\n", opt.path.c_str(), player.fileSize(),
+                player.resolution().x, player.resolution().y, 1.0 / player.dt());
+    std::printf("%u ticks (%.1f s), %zu input runs, %zu mode changes, %zu snapshots\n", player.ticks(),
+                player.ticks() * static_cast<double>(player.dt()), player.runCount(), player.commandCount(),
+                player.snapshotCount());
+
+    GameSimulation sim(player.resolution());
+    int status = 0;
+    if (opt.verify) {
+        auto start = std::chrono::steady_clock::now();
+        std::uint32_t divergent = 0;
+        bool ok = player.verify(sim, divergent);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (ok) {
+            std::printf("verify: all %zu snapshots reproduced bit for bit (%.1f ms)\n", player.snapshotCount(), ms);
+        } else {
+            MatchState recorded = sim.state();
+            player.snapshotAt(divergent, recorded);
+            std::printf("verify: diverged at tick %u\n", divergent);
+            printState("recorded", recorded);
+            printState("replayed", sim.state());
+            status = 1;
+        }
+    }
+    if (opt.seek >= 0) {
+        auto start = std::chrono::steady_clock::now();
+        player.seek(sim, static_cast<std::uint32_t>(std::min<long long>(opt.seek, player.ticks())));
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        std::printf("seek to tick %u took %.1f us\n", player.position(), us);
+        printState("state", sim.state());
+    }
+    return status;
+}
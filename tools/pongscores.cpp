@@ -0,0 +1,138 @@
+/**
+ * @file pongscores.cpp
+ * @brief Prints the persistent leaderboard and exercises its store.
+ * @author Oussama Amara
+ * @date 2025-08-30
+ */
+
+#include "Leaderboard.hpp"
+#include "Logger.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <random>
+#include <string>
+
+namespace {
+/** @brief Command-line options. */
+struct Options {
+    std::string path = "scores.db";
+    std::size_t recent = 10;
+    std::size_t fill = 0;
+    std::uint32_t seed = 1;
+};
+
+/**
+ * @brief The file defaults to scores.db. --fill appends N random matches first, through the
+ * game's background writer, then reopens the log to time the startup scan.
+ */
+void usage() {
+    std::fprintf(stderr, "usage: pongscores [file] [--recent N] [--fill N] [--seed S]\n");
+}
+
+bool parse(int argc, char* argv[], Options& opt) {
+    bool pathSet = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--recent" && hasValue) {
+            opt.recent = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--fill" && hasValue) {
+            opt.fill = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--seed" && hasValue) {
+            opt.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (!arg.empty() && arg[0] != '-' && !pathSet) {
+            opt.path = arg;
+            pathSet = true;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string name(const MatchRecord& record, int slot) {
+    std::string n(record.players[slot], sizeof record.players[slot]);
+    return n.substr(0, n.find('\0'));
+}
+
+std::string date(std::int64_t time) {
+    std::time_t t = static_cast<std::time_t>(time);
+    char text[32] = "?";
+    if (const std::tm* tm = std::localtime(&t))
+        std::strftime(text, sizeof text, "%Y-%m-%d %H:%M", tm);
+    return text;
+}
+
+/** @brief Random matches between a handful of players, as a cabinet would collect them. */
+void fill(Leaderboard& board, const Options& opt) {
+    static const char* const players[] = {"AAA", "BOB", "CPU", "DAN", "EVE", "KIM", "LEO", "MAX"};
+    std::mt19937 rng(opt.seed);
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < opt.fill; ++i) {
+        bool multi = rng() % 2 != 0;
+        const char* p1 = players[rng() % 8];
+        const char* p2 = players[rng() % 8];
+        int s1 = static_cast<int>(rng() % 40), s2 = multi ? static_cast<int>(rng() % 40) : 0;
+        board.submit(Leaderboard::makeRecord(multi ? GameMode::Multiplayer : GameMode::Singleplayer, p1, s1,
+                                             multi ? p2 : "", s2, static_cast<float>(30 + rng() % 600)));
+    }
+    double queued = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    board.flush();
+    double written = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::printf("filled %zu matches: %.3f ms to queue (%.2f us each), %.1f ms until durable\n", opt.fill, queued,
+                opt.fill ? queued * 1000.0 / static_cast<double>(opt.fill) : 0.0, written);
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parse(argc, argv, opt)) {
+        usage();
+        return 2;
+    }
+    Logger::instance().setConsoleEcho(false);
+    Logger::instance().setLevel(LogLevel::Error);
+
+    if (opt.fill > 0) {
+        Leaderboard board(opt.path);
+        fill(board, opt);
+        if (!board.healthy()) {
+            std::fprintf(stderr, "pongscores: cannot write %s\n", opt.path.c_str());
+            return 1;
+        }
+        std::printf("compactions: %llu\n", static_cast<unsigned long long>(board.stats().compactions));
+    }
+
+    Leaderboard board(opt.path);
+    board.flush();
+    const LeaderboardStats stats = board.stats();
+    if (!board.healthy()) {
+        std::fprintf(stderr, "pongscores: cannot open %s\n", opt.path.c_str());
+        return 1;
+    }
+    std::printf("%s: %llu records, loaded in %.3f ms", opt.path.c_str(), static_cast<unsigned long long>(stats.records),
+                stats.loadMs);
+    if (stats.tornBytes)
+        std::printf(", %llu bytes of a torn record dropped", static_cast<unsigned long long>(stats.tornBytes));
+    std::printf("\n");
+
+    static const char* const modes[] = {"menu", "single player", "multiplayer"};
+    for (GameMode mode : {GameMode::Singleplayer, GameMode::Multiplayer}) {
+        std::printf("\ntop %s\n", modes[static_cast<int>(mode)]);
+        int rank = 1;
+        for (const LeaderboardEntry& e : board.top(mode))
+            std::printf("  %2d. %-15s %5d  %s\n", rank++, e.player.c_str(), e.score, date(e.time).c_str());
+    }
+    std::printf("\nrecent matches\n");
+    for (const MatchRecord& r : board.recent(opt.recent)) {
+        if (r.mode == static_cast<std::uint8_t>(GameMode::Multiplayer))
+            std::printf("  %s  multi   %s %d - %d %s  (%.0f s)\n", date(r.time).c_str(), name(r, 0).c_str(), r.score[0],
+                        r.score[1], name(r, 1).c_str(), r.durationMs / 1000.0);
+        else
+            std::printf("  %s  single  %s %d  (%.0f s)\n", date(r.time).c_str(), name(r, 0).c_str(), r.score[0],
+                        r.durationMs / 1000.0);
+    }
+    return 0;
+}
@@ -0,0 +1,186 @@
+/**
+ * @file pongtrace.cpp
+ * @brief Offline decoder for binary trace files written by the game with --trace.
+ * @author Oussama Amara
+ * @date 2025-08-10
+ */
+
+#include "MappedFile.hpp"
+#include "Trace.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+/** @brief Command-line options. */
+struct Options {
+    std::string path;
+    std::vector<int> events;
+    double fromSec = 0.0;
+    double toSec = -1.0;
+    long long firstFrame = 0;
+    long long lastFrame = -1;
+    long long limit = -1;
+    bool csv = false;
+    bool summary = false;
+};
+
+/** @brief Per-event statistics gathered for --summary. */
+struct EventStats {
+    std::uint64_t count = 0;
+    std::uint64_t firstNs = 0;
+    std::uint64_t lastNs = 0;
+    float minF[4] = {0, 0, 0, 0};
+    float maxF[4] = {0, 0, 0, 0};
+};
+
+/** @brief Without --summary every matching record is printed, one per line. */
+void usage() {
+    std::fprintf(stderr,
+        "usage: pongtrace <file> [--event NAME]... [--from SEC] [--to SEC] [--frames A:B]\n"
+        "                        [--csv] [--summary] [--limit N]\n"
+        "events:");
+    for (int e = 1; e < static_cast<int>(TraceEvent::Count); ++e)
+        std::fprintf(stderr, " %s", traceEventName(static_cast<TraceEvent>(e)));
+    std::fprintf(stderr, "\n");
+}
+
+int eventByName(const char* name) {
+    for (int e = 1; e < static_cast<int>(TraceEvent::Count); ++e)
+        if (!std::strcmp(name, traceEventName(static_cast<TraceEvent>(e))))
+            return e;
+    return -1;
+}
+
+bool parse(int argc, char* argv[], Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--event" && hasValue) {
+            int e = eventByName(argv[++i]);
+            if (e < 0) {
+                std::fprintf(stderr, "unknown event: %s\n", argv[i]);
+                return false;
+            }
+            opt.events.push_back(e);
+        } else if (arg == "--from" && hasValue) {
+            opt.fromSec = std::atof(argv[++i]);
+        } else if (arg == "--to" && hasValue) {
+            opt.toSec = std::atof(argv[++i]);
+        } else if (arg == "--frames" && hasValue) {
+            const char* range = argv[++i];
+            opt.firstFrame = std::atoll(range);
+            const char* colon = std::strchr(range, ':');
+            opt.lastFrame = colon && colon[1] ? std::atoll(colon + 1) : -1;
+        } else if (arg == "--limit" && hasValue) {
+            opt.limit = std::atoll(argv[++i]);
+        } else if (arg == "--csv") {
+            opt.csv = true;
+        } else if (arg == "--summary") {
+            opt.summary = true;
+        } else if (!arg.empty() && arg[0] != '-' && opt.path.empty()) {
+            opt.path = arg;
+        } else {
+            return false;
+        }
+    }
+    return !opt.path.empty();
+}
+
+bool matches(const Options& opt, const TraceRecord& rec) {
+    if (!opt.events.empty()) {
+        bool found = false;
+        for (int e : opt.events)
+            found |= e == rec.event;
+        if (!found) return false;
+    }
+    double t = rec.timeNs * 1e-9;
+    if (t < opt.fromSec || (opt.toSec >= 0.0 && t > opt.toSec)) return false;
+    if (rec.frame < opt.firstFrame || (opt.lastFrame >= 0 && rec.frame > opt.lastFrame)) return false;
+    return true;
+}
+
+void print(const TraceRecord& rec, bool csv) {
+    const char* name = traceEventName(static_cast<TraceEvent>(rec.event));
+    if (csv)
+        std::printf("%.9f,%u,%s,%g,%g,%g,%g,%d,%d\n", rec.timeNs * 1e-9, rec.frame, name,
+                    rec.f[0], rec.f[1], rec.f[2], rec.f[3], rec.i[0], rec.i[1]);
+    else
+        std::printf("%14.6f  #%-8u %-13s f=(%g, %g, %g, %g) i=(%d, %d)\n", rec.timeNs * 1e-9, rec.frame, name,
+                    rec.f[0], rec.f[1], rec.f[2], rec.f[3], rec.i[0], rec.i[1]);
+}
+
+void printSummary(const std::vector<EventStats>& stats, std::uint64_t total, std::uint64_t matched) {
+    std::printf("records: %llu total, %llu matched\n",
+                static_cast<unsigned long long>(total), static_cast<unsigned long long>(matched));
+    std::printf("%-13s %10s %12s %12s %10s  %s\n", "event", "count", "first(s)", "last(s)", "rate(/s)", "payload range f0..f3");
+    for (int e = 1; e < static_cast<int>(stats.size()); ++e) {
+        const EventStats& s = stats[e];
+        if (!s.count) continue;
+        double span = (s.lastNs - s.firstNs) * 1e-9;
+        double rate = span > 0.0 ? s.count / span : 0.0;
+        std::printf("%-13s %10llu %12.6f %12.6f %10.1f  [%g..%g] [%g..%g] [%g..%g] [%g..%g]\n",
+                    traceEventName(static_cast<TraceEvent>(e)), static_cast<unsigned long long>(s.count),
+                    s.firstNs * 1e-9, s.lastNs * 1e-9, rate,
+                    s.minF[0], s.maxF[0], s.minF[1], s.maxF[1], s.minF[2], s.maxF[2], s.minF[3], s.maxF[3]);
+    }
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parse(argc, argv, opt)) {
+        usage();
+        return 2;
+    }
+
+    MappedFile file;
+    if (!file.open(opt.path, MappedFile::Mode::ReadOnly) || file.size() < sizeof(TraceHeader)) {
+        std::fprintf(stderr, "pongtrace: cannot read %s\n", opt.path.c_str());
+        return 1;
+    }
+    const auto* header = reinterpret_cast<const TraceHeader*>(file.data());
+    if (std::memcmp(header->magic, "PTRC", 4) != 0 || header->recordSize != sizeof(TraceRecord)) {
+        std::fprintf(stderr, "pongtrace: %s is not a version %d trace file\n", opt.path.c_str(), 1);
+        return 1;
+    }
+
+    // A crashed session leaves preallocated space behind; trust the smaller of both counts.
+    std::uint64_t available = (file.size() - sizeof(TraceHeader)) / sizeof(TraceRecord);
+    std::uint64_t total = header->recordCount < available ? header->recordCount : available;
+    const auto* records = reinterpret_cast<const TraceRecord*>(file.data() + sizeof(TraceHeader));
+
+    std::vector<EventStats> stats(static_cast<std::size_t>(TraceEvent::Count));
+    std::uint64_t matched = 0;
+    if (opt.csv && !opt.summary)
+        std::printf("time_s,frame,event,f0,f1,f2,f3,i0,i1\n");
+
+    for (std::uint64_t n = 0; n < total; ++n) {
+        const TraceRecord& rec = records[n];
+        if (!matches(opt, rec))
+            continue;
+        if (opt.limit >= 0 && static_cast<long long>(matched) >= opt.limit)
+            break;
+        ++matched;
+        if (!opt.summary) {
+            print(rec, opt.csv);
+            continue;
+        }
+        if (rec.event >= stats.size())
+            continue;
+        EventStats& s = stats[rec.event];
+        for (int k = 0; k < 4; ++k) {
+            if (!s.count || rec.f[k] < s.minF[k]) s.minF[k] = rec.f[k];
+            if (!s.count || rec.f[k] > s.maxF[k]) s.maxF[k] = rec.f[k];
+        }
+        if (!s.count) s.firstNs = rec.timeNs;
+        s.lastNs = rec.timeNs;
+        ++s.count;
+    }
+
+    if (opt.summary)
+        printSummary(stats, total, matched);
+    return 0;
+}
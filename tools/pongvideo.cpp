@@ -0,0 +1,205 @@
+/**
+ * @file pongvideo.cpp
+ * @brief Renders replays to video without a GPU or a display, and benchmarks the software renderer.
+ * @author Oussama Amara
+ * @date 2025-09-02
+ */
+
+#include "CpuPlayer.hpp"
+#include "Logger.hpp"
+#include "Replay.hpp"
+#include "SoftwareRenderer.hpp"
+#include "VideoWriter.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace {
+/** @brief Command-line options. */
+struct Options {
+    std::string replay;
+    std::string output;
+    int fps = 60;
+    double from = 0.0;
+    double to = -1.0;
+    bool bench = false;
+    int frames = 3600;
+    int width = 1920;
+    int height = 1080;
+    bool ppm = false;
+};
+
+/**
+ * @brief The first form re-simulates a recording at --fps (60 by default), blending between
+ * ticks like the game, e.g. pongvideo match.prpl -o - | ffmpeg -i - highlight.mp4.
+ * --bench draws a CPU-vs-CPU match with damage-only and full clears and reports frames per
+ * second for drawing, conversion and writing.
+ */
+void usage() {
+    std::fprintf(stderr, "usage: pongvideo <replay> -o <out.y4m|out.ppm|-> [--fps N] [--from S] [--to S]\n"
+                         "       pongvideo --bench [--frames N] [--size WxH] [--ppm] [-o FILE]\n");
+}
+
+bool parse(int argc, char* argv[], Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "-o" && hasValue) {
+            opt.output = argv[++i];
+        } else if (arg == "--fps" && hasValue) {
+            opt.fps = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--from" && hasValue) {
+            opt.from = std::max(0.0, std::atof(argv[++i]));
+        } else if (arg == "--to" && hasValue) {
+            opt.to = std::atof(argv[++i]);
+        } else if (arg == "--bench") {
+            opt.bench = true;
+        } else if (arg == "--frames" && hasValue) {
+            opt.frames = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--size" && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &opt.width, &opt.height) != 2 || opt.width < 2 || opt.height < 2)
+                return false;
+        } else if (arg == "--ppm") {
+            opt.ppm = true;
+        } else if (!arg.empty() && arg[0] != '-' && opt.replay.empty()) {
+            opt.replay = arg;
+        } else {
+            return false;
+        }
+    }
+    return opt.bench || (!opt.replay.empty() && !opt.output.empty());
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/** @brief Y4M needs even dimensions; the extra row or column stays background. */
+int even(float size) {
+    return (static_cast<int>(std::ceil(size)) + 1) & ~1;
+}
+
+int exportReplay(const Options& opt) {
+    Replay::Player player;
+    if (!player.open(opt.replay)) {
+        std::fprintf(stderr, "pongvideo: cannot open replay %s\n", opt.replay.c_str());
+        return 1;
+    }
+    const Vec2 field = player.resolution();
+    SoftwareRenderer renderer(even(field.x), even(field.y));
+    VideoWriter writer;
+    if (!writer.open(opt.output, VideoWriter::formatOf(opt.output), renderer.width(), renderer.height(), opt.fps)) {
+        std::fprintf(stderr, "pongvideo: cannot write %s\n", opt.output.c_str());
+        return 1;
+    }
+
+    // Frame k shows the match at k / fps seconds: the tick that time falls in, blended
+    const double tickRate = 1.0 / player.dt();
+    const double end = opt.to >= 0.0 ? std::min(opt.to * tickRate, static_cast<double>(player.ticks()))
+                                     : static_cast<double>(player.ticks());
+    GameSimulation sim(field);
+    player.seek(sim, static_cast<std::uint32_t>(opt.from * tickRate));
+    const auto start = std::chrono::steady_clock::now();
+    for (std::uint64_t frame = 0;; ++frame) {
+        const double at = opt.from * tickRate + static_cast<double>(frame) * tickRate / opt.fps;
+        if (at > end)
+            break;
+        const auto target = static_cast<std::uint32_t>(std::ceil(at));
+        while (player.position() < target && player.advance(sim)) {
+        }
+        const float alpha = 1.f - static_cast<float>(target - at);
+        renderer.renderMatch(sim.state(), alpha);
+        if (!writer.write(renderer)) {
+            std::fprintf(stderr, "pongvideo: write error on %s\n", opt.output.c_str());
+            return 1;
+        }
+    }
+    writer.close();
+    const double seconds = secondsSince(start);
+    const double video = static_cast<double>(writer.frames()) / opt.fps;
+    std::fprintf(stderr, "%llu frames (%.1f s of video) in %.2f s: %.0f fps, %.1fx real time, %.1f MB\n",
+                 static_cast<unsigned long long>(writer.frames()), video, seconds,
+                 static_cast<double>(writer.frames()) / seconds, video / seconds,
+                 static_cast<double>(writer.bytes()) / 1e6);
+    return 0;
+}
+
+/** @brief Timings of one bench pass. */
+struct BenchResult {
+    double drawSeconds = 0.0;
+    double totalSeconds = 0.0;
+    std::uint64_t pixels = 0;
+};
+
+/**
+ * @brief Plays a CPU-vs-CPU match and draws one frame every four 240 Hz ticks (60 fps).
+ */
+BenchResult benchPass(const Options& opt, bool fullClear, bool convert) {
+    const Vec2 field{static_cast<float>(opt.width), static_cast<float>(opt.height)};
+    const float dt = 1.f / 240.f;
+    GameSimulation sim(field);
+    sim.start(GameMode::Multiplayer);
+    CpuDifficulty difficulty;
+    CpuPlayer bots[2] = {CpuPlayer(0, difficulty, 1), CpuPlayer(1, difficulty, 2)};
+    SoftwareRenderer renderer(opt.width, opt.height);
+    VideoWriter writer;
+    const VideoWriter::Format format = opt.ppm ? VideoWriter::Format::Ppm : VideoWriter::Format::Y4m;
+    if (convert && !writer.open(opt.output, format, opt.width, opt.height, 60)) {
+        std::fprintf(stderr, "pongvideo: cannot write %s\n", opt.output.c_str());
+        std::exit(1);
+    }
+
+    BenchResult result;
+    const auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < opt.frames; ++frame) {
+        for (int t = 0; t < 4; ++t) {
+            if (sim.mode() == GameMode::Menu)
+                sim.start(GameMode::Multiplayer);
+            TickInput input;
+            input.players[0] = bots[0].input(sim.state(), field.x, dt);
+            input.players[1] = bots[1].input(sim.state(), field.x, dt);
+            sim.step(input, dt);
+        }
+        const auto drawStart = std::chrono::steady_clock::now();
+        if (fullClear)
+            renderer.invalidate();
+        renderer.renderMatch(sim.state(), 0.5f);
+        result.drawSeconds += secondsSince(drawStart);
+        result.pixels += renderer.pixelsFilled();
+        if (convert)
+            writer.write(renderer);
+    }
+    result.totalSeconds = secondsSince(start);
+    return result;
+}
+
+int bench(const Options& opt) {
+    std::printf("bench: %d frames at %dx%d, span fill %s, %s%s\n", opt.frames, opt.width, opt.height,
+                SoftwareRenderer::fillBackend(), opt.ppm ? "ppm" : "y4m",
+                opt.output.empty() ? " (converted, not written)" : (" to " + opt.output).c_str());
+    const double video = opt.frames / 60.0;
+    for (bool fullClear : {false, true}) {
+        const BenchResult draw = benchPass(opt, fullClear, false);
+        const BenchResult all = benchPass(opt, fullClear, true);
+        std::printf("%-13s draw %8.0f fps (%6.1f us, %7.0f px/frame)   draw+%s %6.0f fps, %6.1fx real time\n",
+                    fullClear ? "full clear" : "damage only", opt.frames / draw.drawSeconds,
+                    draw.drawSeconds * 1e6 / opt.frames, static_cast<double>(draw.pixels) / opt.frames,
+                    opt.output.empty() ? "convert" : "write", opt.frames / all.totalSeconds,
+                    video / all.totalSeconds);
+    }
+    return 0;
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parse(argc, argv, opt)) {
+        usage();
+        return 2;
+    }
+    Logger::instance().setConsoleEcho(false);
+    Logger::instance().setLevel(LogLevel::Error);
+    return opt.bench ? bench(opt) : exportReplay(opt);
+}